@@ -8,6 +8,11 @@
 #ifndef CLOCKCONTROL_H_
 #define CLOCKCONTROL_H_
 
+#define CLOCKCONTROL_TICK_PERIOD_MS 50 // Period (ms) at which clockControl_tick() must be called.
+
+// Puts the state machine back in its init state: the clock waits for its first touch again.
+void clockControl_init();
+
 void clockControl_tick();
 
 
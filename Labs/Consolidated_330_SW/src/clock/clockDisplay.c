@@ -5,15 +5,17 @@
  *      Author: cdmoo
  */
 #include "clockDisplay.h"
-#include <stdio.h>
+#include "clockTime.h"
 #include "supportFiles/display.h"
-#include "string.h"
+#include "supportFiles/sevenSegment.h"
 #include "supportFiles/utils.h"
-#include "../intervalTimer/intervalTimer.h"
 
 // size of the clock numbers - also scales the size of the arrows
 #define CLOCK_TEXT_SIZE 6
-#define NUM_DISPLAY_CHARS 8 // number of characters in the clock string
+#define TIME_FIELD_DIGITS 2 // digits in each of the hours, minutes and seconds
+#define DIGIT_WIDTH (5 * CLOCK_TEXT_SIZE) // width in pixels of a seven-segment digit
+#define DIGIT_HEIGHT (8 * CLOCK_TEXT_SIZE) // height in pixels of a seven-segment digit
+#define SEGMENT_THICKNESS CLOCK_TEXT_SIZE // width in pixels of a segment, also the size of a colon dot
 
 #define ARROW_WIDTH (12 * CLOCK_TEXT_SIZE) // width in pixels of an arrow
 #define ARROW_HEIGHT (9 * CLOCK_TEXT_SIZE) // height in pixels of an arrow
@@ -33,32 +35,28 @@
 // vertical offset of the arrow from the bottom of the screen
 #define ARROW_OFFSET_Y1 ((DISPLAY_HEIGHT / 2) + ARROW_MIDY_OFFSET)
 
-#define CURSOR_POS_X0 ARROW_OFFSET_X0 // offset of the text to be rendered frim the left
-// 1st cursor position for writing clock text
+#define CURSOR_POS_X0 ARROW_OFFSET_X0 // offset of the hours from the left
+// vertical position of the clock text
 #define CURSOR_POS_Y (DISPLAY_HEIGHT / 2 - 3 * CLOCK_TEXT_SIZE)
-// 2nd cursor position for writing clock text
-#define CURSOR_POS_X1 (CURSOR_POS_X0 + ARROW_WIDTH / 2)
-// 3rd cursor position for writing clock text
+// left edge of the gap holding the first colon
 #define CURSOR_POS_X2 (CURSOR_POS_X0 + ARROW_WIDTH)
-// 4th cursor position for writing clock text
+// position of the minutes
 #define CURSOR_POS_X3 ARROW_OFFSET_X1
-// 5th cursor position for writing clock text
-#define CURSOR_POS_X4 (CURSOR_POS_X3 + ARROW_WIDTH / 2)
-// 6th cursor position for writing clock text
+// left edge of the gap holding the second colon
 #define CURSOR_POS_X5 (CURSOR_POS_X3 + ARROW_WIDTH)
-// 7th cursor position for writing clock text
+// position of the seconds
 #define CURSOR_POS_X6 ARROW_OFFSET_X2
-// 8th cursor position for writing clock text
-#define CURSOR_POS_X7 (CURSOR_POS_X6 + ARROW_WIDTH / 2)
-#define MAX_MINUTES 59 // max number of minutes before clock rolls over
-#define MAX_HOURS 12 // max number of hours before clock rolls over
-#define MAX_SECONDS 59 // max number of seconds in a minute
-#define MIN_HOURS 1 // minimum number of hours set after rollover
+// offset that centers a pair of digits over its arrows
+#define DIGIT_OFFSET_X ((ARROW_WIDTH - (2 * DIGIT_WIDTH + SEGMENT_THICKNESS)) / 2)
+// the dots of a colon sit a third and two thirds of the way down the digits
+#define COLON_DOT_Y0 (CURSOR_POS_Y + DIGIT_HEIGHT / 3 - SEGMENT_THICKNESS / 2)
+#define COLON_DOT_Y1 (CURSOR_POS_Y + 2 * DIGIT_HEIGHT / 3 - SEGMENT_THICKNESS / 2)
 #define NO_FORCE_UPDATE_ALL 0 // boolean to be passed into updateClock to assure that all
                               // digits are not updated, only the digits that have changed
 #define FORCE_UPDATE_ALL 1 // boolean to be passed into updateClock to make sure that all digits are rewritten
 #define TEST_DELAY 1000 // number of miliseconds to wait in between each update invocation during testing
 #define TEST_DELAY_SMALL 100 // number of miliseconds to wait during timekeeping X10 during testing
+#define TEST_RUN_UPDATES 50 // updates (a tenth of a second apart) while the clock runs during testing
 
 // the following three constants are for dividing the screen into the six pre-defined touch
 // zones corresponding to the increment and decrement of hours, minutes, and seconds
@@ -66,26 +64,36 @@
 #define X_DIVIDER_1 (DISPLAY_WIDTH / 3)
 #define X_DIVIDER_2 (DISPLAY_WIDTH * 2 / 3)
 
-// an array holding all of the cursor positions so that a for loop can be used to render clock text
-static const uint32_t cursorPositions[NUM_DISPLAY_CHARS] = {CURSOR_POS_X0, CURSOR_POS_X1,
-        CURSOR_POS_X2, CURSOR_POS_X3, CURSOR_POS_X4, CURSOR_POS_X5, CURSOR_POS_X6, CURSOR_POS_X7};
+// how far a touch in each zone moves the time: top row increments, bottom row decrements,
+// the columns are hours, minutes and seconds
+static const int32_t incDecSeconds[2][3] = {
+        {CLOCKTIME_SECONDS_PER_HOUR, CLOCKTIME_SECONDS_PER_MINUTE, 1},
+        {-CLOCKTIME_SECONDS_PER_HOUR, -CLOCKTIME_SECONDS_PER_MINUTE, -1}};
 
-static uint32_t seconds = 0; // global variable storing clock seconds
-static uint32_t minutes = 0; // global variable storing clock minutes
-static uint32_t hours = 1; // global variable storing clock hours
-static char currentTime[NUM_DISPLAY_CHARS]; // string storing the most recent calculated time
-static char displayedTime[NUM_DISPLAY_CHARS]; // string storing the most recently displayed time
+static sevenSegment_t hoursField; // the two digits of the hours
+static sevenSegment_t minutesField; // the two digits of the minutes
+static sevenSegment_t secondsField; // the two digits of the seconds
+static uint32_t displayedTime; // the time (seconds into the cycle) most recently displayed
 static int16_t lastTouchX; // global variable storing most recent touch data on the x axis
 static int16_t lastTouchY; // global variable storing most recent touch data on the y axis
 static uint8_t lastTouchZ; // global variable storing most recent touch data on the z axis (pressure)
 
-// this function is responsible initializing all of the hardware it needs to interact with and set the display
-// up for the initial clock screen
+// draws a colon as two square dots with its left edge at x
+static void drawColon(int16_t x) {
+    display_fillRect(x, COLON_DOT_Y0, SEGMENT_THICKNESS, SEGMENT_THICKNESS, DISPLAY_RED);
+    display_fillRect(x, COLON_DOT_Y1, SEGMENT_THICKNESS, SEGMENT_THICKNESS, DISPLAY_RED);
+}
+
+// sets the time to 1:00:00 and draws the initial clock screen; the display must already be initialized
 void clockDisplay_init() {
-    display_init();  // Must init all of the software and underlying hardware for LCD.
+    // the clock reads 1:00:00 and stays stopped until it is first set
+    clockTime_init();
+    clockDisplay_draw();
+}
+
+// draws the whole clock screen for the current time, e.g., after another screen was shown
+void clockDisplay_draw() {
     display_fillScreen(DISPLAY_BLACK);  // Blank the screen.
-    display_setTextColor(DISPLAY_RED);  // Make the text red.
-    display_setTextSize(CLOCK_TEXT_SIZE); // set the text to the predifined size
 
     // draw the top left arrow
     display_fillTriangle(ARROW_OFFSET_X0, ARROW_OFFSET_Y0, ARROW_OFFSET_X0 + ARROW_WIDTH, ARROW_OFFSET_Y0,
@@ -107,233 +115,95 @@ void clockDisplay_init() {
     display_fillTriangle(ARROW_OFFSET_X2, ARROW_OFFSET_Y1, ARROW_OFFSET_X2 + ARROW_WIDTH, ARROW_OFFSET_Y1,
             ARROW_OFFSET_X2 + ARROW_WIDTH / 2, ARROW_OFFSET_Y1 + ARROW_HEIGHT, DISPLAY_GREEN);
 
-    //init the time current time string to calculated time (1:00:00 after initialization)
-    sprintf(currentTime, "%02hd:%02hd:%02hd", hours, minutes, seconds);
-    //init the displayed time string to the most recently displayed time (1:00:00)
-    sprintf(displayedTime, "%02hd:%02hd:%02hd", hours, minutes, seconds);
-
-    // update the time display to display the current time string
+    // the colons never change, so they are drawn once here, centered in the gap between the digits
+    drawColon((CURSOR_POS_X2 + CURSOR_POS_X3 - SEGMENT_THICKNESS) / 2);
+    drawColon((CURSOR_POS_X5 + CURSOR_POS_X6 - SEGMENT_THICKNESS) / 2);
+    // each pair of digits is a zero-padded seven-segment field: a change of digit fills only the
+    // segments that differ between the old and the new digit
+    sevenSegment_init(&hoursField, CURSOR_POS_X0 + DIGIT_OFFSET_X, CURSOR_POS_Y, TIME_FIELD_DIGITS,
+            DIGIT_WIDTH, DIGIT_HEIGHT, SEGMENT_THICKNESS, DISPLAY_RED, DISPLAY_BLACK, true);
+    sevenSegment_init(&minutesField, CURSOR_POS_X3 + DIGIT_OFFSET_X, CURSOR_POS_Y, TIME_FIELD_DIGITS,
+            DIGIT_WIDTH, DIGIT_HEIGHT, SEGMENT_THICKNESS, DISPLAY_RED, DISPLAY_BLACK, true);
+    sevenSegment_init(&secondsField, CURSOR_POS_X6 + DIGIT_OFFSET_X, CURSOR_POS_Y, TIME_FIELD_DIGITS,
+            DIGIT_WIDTH, DIGIT_HEIGHT, SEGMENT_THICKNESS, DISPLAY_RED, DISPLAY_BLACK, true);
+
+    // update the time display to display the current time
     clockDisplay_updateTimeDisplay(FORCE_UPDATE_ALL);
 }
 
-// in charge of erasing a previously displayed character and writing a new character
-void updateDisplayChar(int index) {
-    // set the cursor to the correct position as indicated by the index
-    display_setCursor(cursorPositions[index], CURSOR_POS_Y);
-    // set the text to black so that it will overwrite the previously displayed character
-    display_setTextColor(DISPLAY_BLACK);
-    // write the black overwrite to the screen, effectively erasing the past character
-    display_print(displayedTime[index]);
-
-    // reset the cursor to the position at the correct index
-    display_setCursor(cursorPositions[index], CURSOR_POS_Y);
-    // set text color to red
-    display_setTextColor(DISPLAY_RED);
-    // print the new time character
-    display_print(currentTime[index]);
-    // set the most recent displayed time to what was most recently displayed from the
-    // current time string
-    displayedTime[index] = currentTime[index];
-}
-
-// selectively updates changed characters in the clock text
+// shows the current time, only touching the screen when the second has changed
 void clockDisplay_updateTimeDisplay(bool forceUpdateAll) {
-    // temporary string that holds the newly calculated time string
-    char temp[NUM_DISPLAY_CHARS];
-    // writing the most recent time to the temporary string
-    sprintf(temp, "%02hd:%02hd:%02hd", hours, minutes, seconds);
-    // copy the temp string into the current time string
-    strncpy(currentTime, temp, NUM_DISPLAY_CHARS);
-
-    // iterate through each character in the time string
-    for(int i = 0; i < NUM_DISPLAY_CHARS; i++) {
-        // if the character has changed from the most recent display
-        // or if the caller has forced every character to be updated
-        // update the char by erasing the old char and writing the new one
-        if(currentTime[i] != displayedTime[i] || forceUpdateAll) {
-            updateDisplayChar(i);
-        }
-    }
-}
-
-// called either when minutes max out at 60 or when a user is autoincrementing the hours
-void incrementHours() {
-    // if the hours have not reached 12
-    if(hours < MAX_HOURS) {
-        // increment the hours
-        hours++;
-    }
-    else {
-        // if the hours have reached the limit of 12, set them back to 1
-        hours = MIN_HOURS;
-    }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
-}
-
-// called either when seconds max out at 60 or when a user is autoincrementing the minutes
-void incrementMinutes() {
-    // if the minutes have not reached the max of 59
-    if(minutes < MAX_MINUTES) {
-        // increment them
-        minutes++;
-    }
-    else {
-        // otherwise reset the minutes to 0
-        minutes = 0;
-        // and increment the hours
-        incrementHours();
-    }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
-}
-
-// called by the control module to advance time forward or by the user to set time
-void incrementSeconds() {
-    // if the seconds have not reached the max of 59
-    if(seconds < MAX_SECONDS) {
-        // increment them
-        seconds++;
+    uint32_t time = clockTime_getSeconds();
+    // the usual case: nothing to do until the next second
+    if(time == displayedTime && !forceUpdateAll) {
+        return;
+    }
+    uint8_t hours, minutes, seconds;
+    clockTime_split(time, &hours, &minutes, &seconds);
+    if(forceUpdateAll) {
+        // redraw every digit
+        sevenSegment_draw(&hoursField, hours);
+        sevenSegment_draw(&minutesField, minutes);
+        sevenSegment_draw(&secondsField, seconds);
     }
     else {
-        // otherwise reset the seconds to 0
-        seconds = 0;
-        // and increment the minutes
-        incrementMinutes();
+        // fill the segments that changed, usually one or two rectangles
+        sevenSegment_update(&hoursField, hours);
+        sevenSegment_update(&minutesField, minutes);
+        sevenSegment_update(&secondsField, seconds);
     }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
-}
-
-// called when the user is manually setting hours
-void decrementHours() {
-    // if the hours have not reached the minimum of 1
-    if(hours > MIN_HOURS ) {
-        // decrement the hours
-        hours--;
-    }
-    else {
-        // otherwise reset the hours to 12
-        hours = MAX_HOURS;
-    }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
-}
-
-// called when the user is manually setting minutes
-void decrementMinutes() {
-    // if the minutes have not reached the minimum of 0
-    if(minutes > 0) {
-        // decrement them
-        minutes--;
-    }
-    else {
-        // otherwise rollover the minutes to 59
-        minutes = MAX_MINUTES;
-        // and decrement the hours
-        decrementHours();
-    }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
-}
-
-// called when the user is manually setting seconds
-void decrementSeconds() {
-    // if the seconds have not reached the minimum of 0
-    if(seconds > 0) {
-        // decrement the seconds
-        seconds--;
-    }
-    else {
-        // otherwise rollover the seconds to 59
-        seconds = MAX_SECONDS;
-        // and decrement them
-        decrementMinutes();
-    }
-    // rerender the display after changes have been made
-    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
+    displayedTime = time;
 }
 
 // processes touch data and executes the appropriate action depending on the user touch
 void clockDisplay_performIncDec() {
     // fetch the touch data from the display module and store them in global variables
     display_getTouchedPoint(&lastTouchX, &lastTouchY, &lastTouchZ);
-    // first test if the touch was in any of the top 3 zones
-    if(lastTouchY < Y_MID_DIVIDER) {
-        // test if the touch was in the leftmost zone corresponding to increment hours
-        if(lastTouchX < X_DIVIDER_1) {
-            // increment hours accordingly
-            incrementHours();
-        }
-        // test if the touch was in the middle zone corresponding to increment minutes
-        else if(lastTouchX < X_DIVIDER_2) {
-            // increment minutes accordingly
-            incrementMinutes();
-        }
-        else {
-            // if the touch was not in the other two top zones, increment seconds
-            incrementSeconds();
-        }
-    }
-    // if the touch was not in the top zones, it must have occured in the bottom 3 zones
-    else {
-        // test if the touch was in the leftmost zone corresponding to decrement hours
-        if(lastTouchX < X_DIVIDER_1) {
-            // decrement hours accordingly
-            decrementHours();
-        }
-        // test if the touch was in the leftmost zone corresponding to decrement seconds
-        else if(lastTouchX < X_DIVIDER_2) {
-            // decrement minutes accordingly
-            decrementMinutes();
-        }
-        // if the touch was not in the other two bottom zones, decrement seconds
-        else {
-            decrementSeconds();
-        }
-    }
+    // the top half increments, the bottom half decrements
+    uint8_t row = lastTouchY < Y_MID_DIVIDER ? 0 : 1;
+    // the left third is hours, the middle third minutes and the right third seconds
+    uint8_t column = lastTouchX < X_DIVIDER_1 ? 0 : (lastTouchX < X_DIVIDER_2 ? 1 : 2);
+    // only the time changes here, the display catches up on its next update
+    clockTime_adjust(incDecSeconds[row][column]);
 }
 
-// called during standard time keeping state of the control state machind
+// advances the time by one second and shows it, regardless of whether the clock is running
 void clockDisplay_advanceTimeOneSecond() {
-    // increment 1 seconds every second
-    incrementSeconds();
+    clockTime_adjust(1);
+    clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
 }
 
 
 // tests the increment / decrement abilities of the display and provides a demo on
 // how to use this package
 void clockDisplay_runTest() {
+    display_init();  // the display comes first
     // any use of this module must call init first
     clockDisplay_init();
 
-    // test increment hours and delay 1 second
-    incrementHours();
-    utils_msDelay(TEST_DELAY);
-    // test deccrement hours and delay 1 second
-    decrementHours();
-    utils_msDelay(TEST_DELAY);
-    // test increment minutes and delay 1 second
-    incrementMinutes();
-    utils_msDelay(TEST_DELAY);
-    // test deccrement minutes and delay 1 second
-    decrementMinutes();
-    utils_msDelay(TEST_DELAY);
-    // test increment seconds and delay 1 second
-    incrementSeconds();
-    utils_msDelay(TEST_DELAY);
-    // test deccrement seconds and delay 1 second
-    decrementSeconds();
-    utils_msDelay(TEST_DELAY);
+    // step each of hours, minutes and seconds up and back down again, a second apart
+    const int32_t steps[] = {CLOCKTIME_SECONDS_PER_HOUR, CLOCKTIME_SECONDS_PER_MINUTE, 1};
+    for(uint8_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        clockTime_adjust(steps[i]);
+        clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
+        utils_msDelay(TEST_DELAY);
+        clockTime_adjust(-steps[i]);
+        clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
+        utils_msDelay(TEST_DELAY);
+    }
 
-    // at a speed of once per tenth of a second, increment seconds
+    // at a speed of once per tenth of a second, advance the seconds
     // and check the rollover into minutes
     for(int i = 0; i < 100; i++) {
-        incrementSeconds();
+        clockDisplay_advanceTimeOneSecond();
         utils_msDelay(TEST_DELAY_SMALL);
     }
-}
-
-
-
 
+    // then let the clock run from the global timer, updating as often as the control does
+    clockTime_start();
+    for(int i = 0; i < TEST_RUN_UPDATES; i++) {
+        clockDisplay_updateTimeDisplay(NO_FORCE_UPDATE_ALL);
+        utils_msDelay(TEST_DELAY_SMALL);
+    }
+    clockTime_stop();
+}
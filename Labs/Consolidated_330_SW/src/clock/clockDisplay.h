@@ -13,15 +13,21 @@
 // Called only once - performs any necessary inits.
 // This is a good place to draw the triangles and any other
 // parts of the clock display that will never change.
+// display_init() must have been called first.
 void clockDisplay_init();
 
+// Draws the whole clock screen (arrows, colons and the current time) without changing the time,
+// e.g., when the clock comes back after another screen.
+void clockDisplay_draw();
+
 // Updates the time display with latest time, making sure to update only those digits that
-// have changed since the last update.
+// have changed since the last update. Costs next to nothing when the second has not changed,
+// so it can be called on every tick.
 // if forceUpdateAll is true, update all digits.
 void clockDisplay_updateTimeDisplay(bool forceUpdateAll);
 
 // Reads the touched coordinates and performs the increment or decrement,
-// depending upon the touched region.
+// depending upon the touched region. The display shows it on the next update.
 void clockDisplay_performIncDec();
 
 // Advances the time forward by 1 second and update the display.
@@ -0,0 +1,30 @@
+/*
+ * clockGame.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "clockGame.h"
+#include "clockControl.h"
+#include "clockDisplay.h"
+#include "clockTime.h"
+#include <stddef.h>
+
+#define CLOCK_CONTROL_PRIORITY 0 // only task, so any priority will do
+
+// starts the clock over at 1:00:00, stopped until it is first set
+static void clockGame_init() {
+    clockTime_init();
+    clockControl_init();
+}
+
+const game_t clockGame_descriptor = {
+    "Clock",
+    {{"clockControl_tick()", clockControl_tick, CLOCKCONTROL_TICK_PERIOD_MS, CLOCK_CONTROL_PRIORITY}},
+    clockGame_init,
+    clockDisplay_draw,
+    NULL,
+    NULL,
+    NULL,
+};
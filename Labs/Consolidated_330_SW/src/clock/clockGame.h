@@ -0,0 +1,17 @@
+/*
+ * clockGame.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef CLOCKGAME_H_
+#define CLOCKGAME_H_
+
+#include "supportFiles/game.h"
+
+// The clock as a game for the launcher. It keeps time from the global timer while it is suspended,
+// so it shows the right time when it comes back.
+extern const game_t clockGame_descriptor;
+
+#endif /* CLOCKGAME_H_ */
@@ -20,12 +20,13 @@
 
 
 
-/************ Flag Method ***********
+/************ Scheduler Method ***********
 ************************************/
 #include <stdio.h>
 #include "supportFiles/leds.h"
 #include "supportFiles/globalTimer.h"
 #include "supportFiles/interrupts.h"
+#include "supportFiles/scheduler.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include "clockControl.h"
@@ -35,53 +36,39 @@
 #include "xparameters.h"
 
 #define TOTAL_SECONDS 20
-// The formula for computing the load value is based upon the formula from 4.1.1 (calculating timer intervals)
-// in the Cortex-A9 MPCore Technical Reference Manual 4-2.
-// Assuming that the prescaler = 0, the formula for computing the load value based upon the desired period is:
-// load-value = (period * timer-clock) - 1
-#define TIMER_PERIOD 50.0E-3
-#define TIMER_CLOCK_FREQUENCY (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
-#define TIMER_LOAD_VALUE ((TIMER_PERIOD * TIMER_CLOCK_FREQUENCY) - 1.0)
+#define MS_PER_SECOND 1000
+#define CLOCK_CONTROL_PRIORITY 0    // Only task, so any priority will do.
 
 int main()
 {
     // Initialize the GPIO LED driver and print out an error message if it fails (argument = true).
-       // You need to init the LEDs so that LD4 can function as a heartbeat.
+    // You need to init the LEDs so that LD4 can function as a heartbeat.
     leds_init(true);
     // Init all interrupts (but does not enable the interrupts at the devices).
     // Prints an error message if an internal failure occurs because the argument = true.
     interrupts_initAll(true);
-    interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE);
-    u32 privateTimerTicksPerSecond = interrupts_getPrivateTimerTicksPerSecond();
-    printf("private timer ticks per second: %ld\n\r", privateTimerTicksPerSecond);
-    // Allow the timer to generate interrupts.
-    interrupts_enableTimerGlobalInts();
+    display_init();  // Must init all of the software and underlying hardware for LCD.
     // Initialization of the clock display is not time-dependent, do it outside of the state machine.
     clockDisplay_init();
-    // Keep track of your personal interrupt count. Want to make sure that you don't miss any interrupts.
-     int32_t personalInterruptCount = 0;
-    // Start the private ARM timer running.
-    interrupts_startArmPrivateTimer();
+    // The scheduler programs the private timer from the task periods and starts it.
+    scheduler_init();
+    scheduler_addTask("clockControl_tick()", clockControl_tick, CLOCKCONTROL_TICK_PERIOD_MS, CLOCK_CONTROL_PRIORITY);
+    scheduler_start();
     // Enable interrupts at the ARM.
     interrupts_enableArmInts();
-    // interrupts_isrInvocationCount() returns the number of times that the timer ISR was invoked.
-    // This value is maintained by the timer ISR. Compare this number with your own local
-    // interrupt count to determine if you have missed any interrupts.
-     while (interrupts_isrInvocationCount() < (TOTAL_SECONDS * privateTimerTicksPerSecond)) {
-      if (interrupts_isrFlagGlobal) {  // This is a global flag that is set by the timer interrupt handler.
-          // Count ticks.
-        personalInterruptCount++;
-        clockControl_tick();
-          interrupts_isrFlagGlobal = 0;
-      }
-   }
-   interrupts_disableArmInts();
-   printf("isr invocation count: %ld\n\r", interrupts_isrInvocationCount());
-   printf("internal interrupt count: %ld\n\r", personalInterruptCount);
-   return 0;
+    // Run the ready ticks and sleep in between until the total time has elapsed.
+    while (scheduler_getMs() < (TOTAL_SECONDS * MS_PER_SECOND))
+        scheduler_runOnce();
+    interrupts_disableArmInts();
+    printf("isr invocation count: %ld\n\r", interrupts_isrInvocationCount());
+    scheduler_printReport();  // Per-task releases, overruns and deadline misses.
+    return 0;
 }
 
-void isr_function(){}
+// Releases the ticks that are due; they run from main().
+void isr_function() {
+    scheduler_isrTick();
+}
 
 
 ///***********************************
@@ -0,0 +1,87 @@
+/*
+ * clockTime.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "clockTime.h"
+#include "supportFiles/timebase.h"
+
+#define INITIAL_TIME CLOCKTIME_SECONDS_PER_HOUR // the clock starts out at 1:00:00
+// catching up by more than this many seconds takes a 64-bit divide, fewer is a compare or two
+#define MAX_STEPPED_SECONDS 2
+
+static uint32_t currentTime; // seconds into the 12-hour cycle, 0 at 12:00:00
+static uint64_t secondStartTicks; // global-timer value at which the current second began
+static bool running; // true while the time is counting
+
+// Sets the time to 1:00:00 with the clock stopped. Starts the global timer if needed.
+void clockTime_init() {
+    timebase_init();
+    currentTime = INITIAL_TIME;
+    running = false;
+}
+
+// Starts the clock counting from now. Does nothing if it is already running.
+void clockTime_start() {
+    if(running) {
+        return;
+    }
+    secondStartTicks = timebase_nowTicks(); // the next second is one full second away
+    running = true;
+}
+
+// Stops the clock; the time stays where it is until the clock is started again.
+void clockTime_stop() {
+    clockTime_getSeconds(); // count the seconds up to now first
+    running = false;
+}
+
+// True while the clock is counting.
+bool clockTime_isRunning() {
+    return running;
+}
+
+// Moves the time forward (or back, for negative seconds) by seconds, wrapping around the 12-hour cycle.
+void clockTime_adjust(int32_t seconds) {
+    int32_t step = seconds % (int32_t) CLOCKTIME_SECONDS_PER_CYCLE;
+    if(step < 0) {
+        step += CLOCKTIME_SECONDS_PER_CYCLE; // going back is going forward by the rest of the cycle
+    }
+    currentTime += step;
+    if(currentTime >= CLOCKTIME_SECONDS_PER_CYCLE) {
+        currentTime -= CLOCKTIME_SECONDS_PER_CYCLE;
+    }
+}
+
+// Current time in seconds into the cycle, 0 at 12:00:00. Catches up with the global timer first.
+uint32_t clockTime_getSeconds() {
+    if(!running) {
+        return currentTime;
+    }
+    uint64_t elapsedTicks = timebase_nowTicks() - secondStartTicks;
+    if(elapsedTicks < TIMEBASE_TICKS_PER_SECOND) {
+        return currentTime; // the usual case: still in the same second
+    }
+    uint32_t elapsedSeconds = 0;
+    if(elapsedTicks < MAX_STEPPED_SECONDS * (uint64_t) TIMEBASE_TICKS_PER_SECOND) {
+        elapsedSeconds = 1; // called at least once a second, as the clock is, this is all it ever takes
+    }
+    else {
+        elapsedSeconds = (uint32_t) (elapsedTicks / TIMEBASE_TICKS_PER_SECOND); // after a long gap
+    }
+    // move the anchor by whole seconds, so the fraction of a second already counted carries over
+    secondStartTicks += (uint64_t) elapsedSeconds * TIMEBASE_TICKS_PER_SECOND;
+    clockTime_adjust(elapsedSeconds % CLOCKTIME_SECONDS_PER_CYCLE);
+    return currentTime;
+}
+
+// Splits a time from clockTime_getSeconds() into hours (1..12), minutes and seconds.
+void clockTime_split(uint32_t value, uint8_t* hours, uint8_t* minutes, uint8_t* seconds) {
+    uint32_t hour = value / CLOCKTIME_SECONDS_PER_HOUR;
+    uint32_t secondOfHour = value - hour * CLOCKTIME_SECONDS_PER_HOUR;
+    *minutes = secondOfHour / CLOCKTIME_SECONDS_PER_MINUTE;
+    *seconds = secondOfHour - *minutes * CLOCKTIME_SECONDS_PER_MINUTE;
+    *hours = hour ? hour : CLOCKTIME_HOURS_PER_CYCLE; // hour 0 of the cycle reads 12
+}
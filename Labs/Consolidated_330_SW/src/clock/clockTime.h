@@ -0,0 +1,47 @@
+/*
+ * clockTime.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef CLOCKTIME_H_
+#define CLOCKTIME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The time kept by the clock, as a count of seconds into a 12-hour cycle anchored to the 64-bit global timer.
+// - The global-timer value at which the current second began is kept, and whole seconds are counted off from it
+//   by adding exactly one second of timer ticks each time. Nothing is counted in ticks of a state machine, so
+//   late or missed ticks do not make the clock drift; it is as accurate as the timer crystal over any span.
+// - Setting the time moves the count, not the anchor, so the fraction of the current second is kept.
+// - Hours, minutes and seconds are derived from the count when asked for, with 32-bit math only.
+
+#define CLOCKTIME_HOURS_PER_CYCLE 12
+#define CLOCKTIME_SECONDS_PER_MINUTE 60
+#define CLOCKTIME_SECONDS_PER_HOUR 3600
+#define CLOCKTIME_SECONDS_PER_CYCLE (CLOCKTIME_HOURS_PER_CYCLE * CLOCKTIME_SECONDS_PER_HOUR)
+
+// Sets the time to 1:00:00 with the clock stopped. Starts the global timer if needed.
+void clockTime_init();
+
+// Starts the clock counting from now. Does nothing if it is already running.
+void clockTime_start();
+
+// Stops the clock; the time stays where it is until the clock is started again.
+void clockTime_stop();
+
+// True while the clock is counting.
+bool clockTime_isRunning();
+
+// Moves the time forward (or back, for negative seconds) by seconds, wrapping around the 12-hour cycle.
+void clockTime_adjust(int32_t seconds);
+
+// Current time in seconds into the cycle, 0 at 12:00:00. Catches up with the global timer first.
+uint32_t clockTime_getSeconds();
+
+// Splits a time from clockTime_getSeconds() into hours (1..12), minutes and seconds.
+void clockTime_split(uint32_t value, uint8_t* hours, uint8_t* minutes, uint8_t* seconds);
+
+#endif /* CLOCKTIME_H_ */
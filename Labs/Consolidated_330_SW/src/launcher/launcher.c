@@ -0,0 +1,132 @@
+/*
+ * launcher.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "launcher.h"
+#include "supportFiles/display.h"
+#include <stddef.h>
+
+#define ADC_COUNTER_MAX (50 / LAUNCHER_TICK_PERIOD_MS) // ticks to wait for the touch-controller ADC to settle
+#define TITLE_TEXT_SIZE 3
+#define TITLE_CURSOR_X 10
+#define TITLE_CURSOR_Y 10
+#define ROW_TEXT_SIZE 2
+#define ROW_TOP 60 // top of the first game row
+#define ROW_HEIGHT 40 // each game gets a band this tall to touch
+#define ROW_TEXT_X 20
+#define ROW_TEXT_OFFSET_Y 12 // from the top of the band to the top of the text
+#define ROW_MARGIN 4 // the highlight is inset this much from the band
+#define ROW_HIGHLIGHT_COLOR DISPLAY_BLUE
+#define NO_ROW (-1)
+#define LAUNCHER_PRIORITY 0 // only task, so any priority will do
+
+// launcher states
+typedef enum {
+    waiting_for_touch_st, // menu up, waiting for a touch
+    adc_counter_running_st, // waiting for the touch-controller ADC to settle
+    waiting_for_release_st // a row is highlighted, the game launches when the finger comes off
+} launcher_st_t;
+
+static launcher_st_t currentState = waiting_for_touch_st;
+static uint16_t adcCounter; // ticks spent waiting for the ADC
+static game_id_t rowGames[GAME_MAX_GAMES]; // the game listed on each row
+static uint8_t rowCount; // rows on the menu
+static int8_t selectedRow = NO_ROW; // row being touched
+
+// draws one row: the game's name, marked if it is paused, on a highlight if it is being touched
+static void drawRow(uint8_t row, bool highlight) {
+    int16_t top = ROW_TOP + row * ROW_HEIGHT;
+    uint16_t background = highlight ? ROW_HIGHLIGHT_COLOR : DISPLAY_BLACK;
+    display_fillRect(ROW_MARGIN, top + ROW_MARGIN, DISPLAY_WIDTH - 2 * ROW_MARGIN, ROW_HEIGHT - 2 * ROW_MARGIN,
+            background);
+    display_setTextColor(DISPLAY_WHITE, background);
+    display_setTextSize(ROW_TEXT_SIZE);
+    display_setCursor(ROW_TEXT_X, top + ROW_TEXT_OFFSET_Y);
+    display_print(game_getName(rowGames[row]));
+    if(game_isSuspended(rowGames[row])) {
+        display_print(" (paused)");
+    }
+}
+
+// returns the row under screen position y, NO_ROW if there is none
+static int8_t findRow(int16_t y) {
+    if(y < ROW_TOP || y >= ROW_TOP + rowCount * ROW_HEIGHT) {
+        return NO_ROW;
+    }
+    return (y - ROW_TOP) / ROW_HEIGHT;
+}
+
+// nothing is touched when the menu comes up
+static void launcher_init() {
+    currentState = waiting_for_touch_st;
+    adcCounter = 0;
+    selectedRow = NO_ROW;
+}
+
+// draws the menu with a row for every game but the launcher itself (which is the game running)
+static void launcher_draw() {
+    display_fillScreen(DISPLAY_BLACK);
+    display_setTextColor(DISPLAY_WHITE);
+    display_setTextSize(TITLE_TEXT_SIZE);
+    display_setCursor(TITLE_CURSOR_X, TITLE_CURSOR_Y);
+    display_print("Games");
+    rowCount = 0;
+    for(game_id_t id = 0; id < game_getCount(); id++) {
+        // rows below the bottom of the screen could not be touched
+        if(id != game_getCurrent() && ROW_TOP + (rowCount + 1) * ROW_HEIGHT <= DISPLAY_HEIGHT) {
+            rowGames[rowCount] = id;
+            drawRow(rowCount++, false);
+        }
+    }
+    // a touch that was under way when the menu was left is not carried over
+    currentState = waiting_for_touch_st;
+    selectedRow = NO_ROW;
+}
+
+// standard tick function: highlights the row touched and launches its game on release
+static void launcher_tick() {
+    switch(currentState) {
+    case waiting_for_touch_st:
+        if(display_isTouched()) {
+            display_clearOldTouchData(); // clear out the old touch data
+            adcCounter = 0;
+            currentState = adc_counter_running_st;
+        }
+        break;
+    case adc_counter_running_st:
+        if(!display_isTouched()) {
+            currentState = waiting_for_touch_st; // too short a touch to read
+        } else if(++adcCounter >= ADC_COUNTER_MAX) {
+            int16_t x, y;
+            uint8_t z;
+            display_getTouchedPoint(&x, &y, &z);
+            selectedRow = findRow(y);
+            if(selectedRow != NO_ROW) {
+                drawRow(selectedRow, true);
+            }
+            currentState = waiting_for_release_st;
+        }
+        break;
+    case waiting_for_release_st:
+        if(!display_isTouched()) {
+            if(selectedRow != NO_ROW) {
+                game_launch(rowGames[selectedRow]); // takes effect after this tick
+            }
+            currentState = waiting_for_touch_st;
+        }
+        break;
+    }
+}
+
+const game_t launcher_descriptor = {
+    "Launcher",
+    {{"launcher_tick()", launcher_tick, LAUNCHER_TICK_PERIOD_MS, LAUNCHER_PRIORITY}},
+    launcher_init,
+    launcher_draw,
+    NULL,
+    NULL,
+    NULL,
+};
@@ -0,0 +1,19 @@
+/*
+ * launcher.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef LAUNCHER_H_
+#define LAUNCHER_H_
+
+#include "supportFiles/game.h"
+
+#define LAUNCHER_TICK_PERIOD_MS 50 // period (ms) at which launcher_tick() is scheduled
+
+// The menu of the games image: lists the other registered games, one row each, and launches the one
+// touched. A suspended game is marked as paused; touching it resumes it.
+extern const game_t launcher_descriptor;
+
+#endif /* LAUNCHER_H_ */
@@ -0,0 +1,56 @@
+/*
+ * launcherMain.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "launcher.h"
+#include "../clock/clockGame.h"
+#include "../wam/wamGame.h"
+#include "../mySimon/simonGame.h"
+#include "../ticTacToe/ticTacToeGame.h"
+#include "supportFiles/game.h"
+#include "supportFiles/amp.h"
+#include "supportFiles/scheduler.h"
+#include "../switchesAndButtons/switches.h"  // Modify as necessary to point to your switches.h
+#include "../switchesAndButtons/buttons.h"   // Modify as necessary to point to your buttons.h
+#include <stdio.h>
+
+#define FOREVER 1           // Syntactic sugar for while (1) statements.
+// Tic-tac-toe already uses BTN0 to start a new game, so the launcher takes the buttons at the other end.
+#define SUSPEND_BUTTON_MASK BUTTONS_BTN3_MASK // Back to the menu, the game is paused.
+#define EXIT_BUTTON_MASK BUTTONS_BTN2_MASK    // Back to the menu, the game is closed.
+
+// All the games in one image, started from a menu on the touch screen.
+int main() {
+    game_init();        // LEDs, interrupts, display and scheduler, once for every game.
+    amp_init(true);     // Wake CPU1 for the tic-tac-toe search. If it fails, the search runs on CPU0.
+    switches_init();    // Whack-a-mole reads its board size and tic-tac-toe its level from the switches.
+    buttons_init();
+    game_register(&clockGame_descriptor);
+    game_register(&wamGame_descriptor);
+    game_register(&simonGame_descriptor);
+    game_register(&ticTacToeGame_descriptor);
+    game_setMenu(game_register(&launcher_descriptor));
+    if (!game_start()) {
+        printf("launcher: the scheduler did not start.\n\r");
+        return 1;
+    }
+    int32_t previousButtons = 0;
+    while (FOREVER) {
+        game_runOnce();     // Tick the running game when due, sleep otherwise.
+        int32_t buttons = buttons_read();
+        int32_t pressed = buttons & ~previousButtons;   // Act once per press.
+        previousButtons = buttons;
+        if (pressed & SUSPEND_BUTTON_MASK)
+            game_suspendCurrent();
+        else if (pressed & EXIT_BUTTON_MASK)
+            game_exitCurrent();
+    }
+}
+
+// Releases the ticks that are due; they run from main().
+void isr_function() {
+    scheduler_isrTick();
+}
@@ -6,6 +6,9 @@
 // Get the simon region numbers. See the source code for the region numbering scheme.
 uint8_t buttonHandler_getRegionNumber();
 
+// Puts the state machine back in its init state, disabled, wherever it was.
+void buttonHandler_init();
+
 // Turn on the state machine. Part of the interlock.
 void buttonHandler_enable();
 
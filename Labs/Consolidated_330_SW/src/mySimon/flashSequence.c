@@ -9,105 +9,100 @@
 #include "simonDisplay.h"
 #include "supportFiles/display.h"
 #include "supportFiles/utils.h"
+#include "supportFiles/stateMachine.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
-#define DISPLAY_COUNTER_MAX (500 / TICK_PERIOD) // limits the display of each square to a designated maximum
+#define DISPLAY_MS 500 // how long each square is shown
 #define ERASE_SQUARE true // flag for drawing true color of a square
 #define DRAW_SQUARE false // flag for drawing square as black to erase it
 
 // states of the flash sequence SM
-typedef enum {
+enum {
     init_st, // initial state (will wait here until enabled)
-    display_new_square_st, // state in charge of drawing a new square
-    display_counter_running_st, // state responsable for timing the duration of each square
-    end_st // end state (will wait here until disabled)
-} flashSequence_state_t;
-
-static flashSequence_state_t currentState = init_st; // initial state of the SM is init_st
-static bool enableFlag = false; // this flag controls whether or not the SM stays in init / end state
-static uint16_t displayCounter = 0; // counter for the display_counter_running_st
+    display_square_st, // a square is shown for DISPLAY_MS
+    between_squares_st, // the square was just erased; stays for one tick so that a repeated square flashes twice
+    end_st, // end state (will wait here until disabled)
+    state_count
+};
+
 static uint16_t sequenceIterationLength = 0; // the number of elements in the current flash sequence
 static uint16_t currentSequenceIndex = 0; // global that contains the current index of the flash sequence
 
+// entry action of init_st: reset the sequence iteration length and the current index
+static void resetSequence(stateMachine_t* machine) {
+    sequenceIterationLength = 0;
+    currentSequenceIndex = 0;
+}
+
+// get the new squence iteration length when the SM is enabled
+static void loadSequence(stateMachine_t* machine) {
+    sequenceIterationLength = globals_getSequenceIterationLength();
+}
+
+// entry action of display_square_st: draw the square corresponding to the sequence value at the current index
+static void drawSquare(stateMachine_t* machine) {
+    simonDisplay_drawSquare(globals_getSequenceValue(currentSequenceIndex), DRAW_SQUARE);
+}
+
+// erase the square that was previously drawn and move on to the next one
+static void eraseSquare(stateMachine_t* machine) {
+    simonDisplay_drawSquare(globals_getSequenceValue(currentSequenceIndex), ERASE_SQUARE);
+    currentSequenceIndex++;
+}
+
+// true if the square shown is the last of the sequence
+static bool isLastSquare(stateMachine_t* machine) {
+    return currentSequenceIndex + 1 >= sequenceIterationLength;
+}
+
+static const stateMachine_state_t states[state_count] = {
+    {"init_st", STATEMACHINE_NONE, STATEMACHINE_NONE, resetSequence, NULL, NULL},
+    {"display_square_st", STATEMACHINE_NONE, STATEMACHINE_NONE, drawSquare, NULL, NULL},
+    {"between_squares_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"end_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+};
+
+static const stateMachine_transition_t transitions[] = {
+    // stay in the init state until the enable flag is raised
+    {init_st, 0, stateMachine_isEnabled, loadSequence, display_square_st},
+    // once the square has been shown long enough, erase it: the sequence is over after the last one
+    {display_square_st, DISPLAY_MS, isLastSquare, eraseSquare, end_st},
+    {display_square_st, DISPLAY_MS, NULL, eraseSquare, between_squares_st},
+    {between_squares_st, 0, NULL, NULL, display_square_st},
+    // wait in the end state until the enable flag is taken down
+    {end_st, 0, stateMachine_isDisabled, NULL, init_st},
+};
+
+static const stateMachine_definition_t definition = {
+    "flashSequence", states, state_count, transitions, sizeof(transitions) / sizeof(transitions[0]), init_st
+};
+
+static stateMachine_t machine = STATEMACHINE_INIT(&definition, TICK_PERIOD);
+
+// Puts the state machine back in its init state, disabled, wherever it was.
+void flashSequence_init() {
+    stateMachine_reset(&machine);
+}
+
 // Turns on the state machine. Part of the interlock.
 void flashSequence_enable() {
-    enableFlag = true; // raise the enable flag
+    stateMachine_enable(&machine);
 }
 
 // Turns off the state machine. Part of the interlock.
 void flashSequence_disable() {
-    enableFlag = false; // lower the disable flag
+    stateMachine_disable(&machine);
 }
 
 // Other state machines can call this to determine if this state machine is finished.
 bool flashSequence_isComplete() {
-    return currentState == end_st; // return true if the SM is in the end_st
+    return stateMachine_isInState(&machine, end_st);
 }
 
 // Standard tick function.
 void flashSequence_tick() {
-    // state actions first
-    switch(currentState) {
-        case init_st: // no state actions for init state
-            break;
-        case display_new_square_st: // state actions for the display_new_square_st
-            // draw the square corresponding to the sequence value at the current index
-            simonDisplay_drawSquare(globals_getSequenceValue(currentSequenceIndex), DRAW_SQUARE);
-            break;
-        case display_counter_running_st: // state actions for the dislpay_counter_running_st
-            displayCounter++; // increment the counter associtated with this state
-            break;
-        case end_st: // no state actions for the end state
-            break;
-    }
-
-    // state transitions
-    switch(currentState) {
-        case init_st:
-            // stay in the init state until the enable flag is raised
-            if(enableFlag) { // if the enable flag is raised
-                // get the new squence iteration length
-                sequenceIterationLength = globals_getSequenceIterationLength();
-                // transition to display new square
-                currentState = display_new_square_st;
-            }
-            break;
-        case display_new_square_st:
-            // stay in this state for only one tick, transitioning to display_counter_running_state
-            currentState = display_counter_running_st;
-            break;
-        case display_counter_running_st:
-            // stay in the displaying state until the display counter expires
-            if(displayCounter > DISPLAY_COUNTER_MAX) { // once the display counter expires
-                displayCounter = 0; // reset the counter to 0
-                // erase the square that was previously drawn
-                simonDisplay_drawSquare(globals_getSequenceValue(currentSequenceIndex), ERASE_SQUARE);
-                // increase the current sequence index in order to draw the next square
-                currentSequenceIndex++;
-                // check to see if the current index is greater than the length of the sequence
-                if(currentSequenceIndex >= sequenceIterationLength) {
-                    // if it is, that means that that the sequence has finished flashing, transition to end state
-                    currentState = end_st;
-                } else {
-                    // otherwise, go back and display the enxt square
-                    currentState = display_new_square_st;
-                }
-            }
-            break;
-        case end_st:
-            // if enable flag is taken down, reset the counters and wait for the state machine to be re-enabled
-            if(!enableFlag) {
-                sequenceIterationLength = 0; // reset sequence iteration length
-                currentSequenceIndex = 0; // reset the current index in the sequence
-                currentState = init_st; // transition to the init state
-            }
-            break;
-    }
+    stateMachine_tick(&machine);
 }
-
-
-
-
-
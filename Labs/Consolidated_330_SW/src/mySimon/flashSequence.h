@@ -8,6 +8,9 @@
 #ifndef FLASHSEQUENCE_H_
 #define FLASHSEQUENCE_H_
 
+// Puts the state machine back in its init state, disabled, wherever it was.
+void flashSequence_init();
+
 // Turns on the state machine. Part of the interlock.
 void flashSequence_enable();
 
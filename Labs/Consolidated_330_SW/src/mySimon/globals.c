@@ -5,14 +5,25 @@
  *      Author: cdmoo
  */
 #include "globals.h"
-#define MAX_SEQUENCE_LENGTH 100 // global that designates the maximum sequence length
+
+#define SYMBOL_BITS 2 // each symbol is one of four regions
+#define SYMBOL_MASK 0x3 // the bits of one symbol
+#define SYMBOLS_PER_WORD 16 // 32 bits / 2 bits per symbol
+#define SYMBOL_INDEX_SHIFT 4 // index >> 4 is the word holding a symbol
+#define SYMBOL_POSITION_MASK (SYMBOLS_PER_WORD - 1) // index & 15 is the symbol's place in its word
+// words needed for the longest sequence
+#define SEQUENCE_WORDS ((GLOBALS_MAX_FLASH_SEQUENCE + SYMBOLS_PER_WORD - 1) / SYMBOLS_PER_WORD)
+#define ZERO_SEED_STATE 0x9E3779B9 // xorshift gets stuck at 0, so a seed of 0 starts from this instead
+#define NO_SEED 0 // seed reported for a sequence that was copied in
 
 // the length of this specific iteration of the sequence
 static uint16_t globals_sequenceIterationLength = 0;
 static uint16_t globals_sequenceLength = 0;  // The length of the sequence.
-// construct the empty sequence.
-// It is now ready for the sequence values calculated in simon control to be copied into it
-static uint8_t globals_sequence[MAX_SEQUENCE_LENGTH];
+// the sequence, 16 symbols per word, the first symbol in the low bits of the first word
+static uint32_t globals_sequence[SEQUENCE_WORDS];
+static uint16_t globals_generatedWords = 0; // words of globals_sequence[] that hold the current sequence
+static uint32_t globals_seed = NO_SEED; // seed of the current sequence
+static uint32_t globals_generatorState = 0; // xorshift state that gives the next word
 
 
 // This is the length of the sequence that you are currently working on,
@@ -34,17 +45,59 @@ uint16_t globals_getSequenceLength() {
 
 // setter for the sequence (deep copy, not a shallow copy of the passed in sequence)
 void globals_setSequence(const uint8_t sequence[], uint16_t length) {
+    if(length > GLOBALS_MAX_FLASH_SEQUENCE) {
+        length = GLOBALS_MAX_FLASH_SEQUENCE; // no room for more
+    }
     globals_sequenceLength = length; // set the length
-    // copy the values of the sequence array into the globals sequence array
-    for(int i = 0; i < length; i++) {
-        globals_sequence[i] = sequence[i];
+    globals_seed = NO_SEED;
+    // pack the values of the sequence array into the globals sequence words
+    for(uint16_t word = 0; word * SYMBOLS_PER_WORD < length; word++) {
+        globals_sequence[word] = 0;
     }
+    for(uint16_t i = 0; i < length; i++) {
+        globals_sequence[i >> SYMBOL_INDEX_SHIFT] |=
+                (uint32_t) (sequence[i] & SYMBOL_MASK) << ((i & SYMBOL_POSITION_MASK) * SYMBOL_BITS);
+    }
+    // every word is already filled, so nothing is left to generate
+    globals_generatedWords = SEQUENCE_WORDS;
 }
 
-// getter for the value of a specific value within the sequence at an index
-uint8_t globals_getSequenceValue(uint16_t index) {
-    return globals_sequence[index]; // return the sequence value at a specific index
+// starts a new sequence generated from seed; no symbols are made until they are read
+void globals_setSequenceSeed(uint32_t seed, uint16_t length) {
+    if(length > GLOBALS_MAX_FLASH_SEQUENCE) {
+        length = GLOBALS_MAX_FLASH_SEQUENCE; // no room for more
+    }
+    globals_sequenceLength = length;
+    globals_seed = seed;
+    globals_generatorState = seed ? seed : ZERO_SEED_STATE;
+    globals_generatedWords = 0;
 }
 
+// the seed of the current sequence
+uint32_t globals_getSequenceSeed() {
+    return globals_seed;
+}
 
+// xorshift32 (Marsaglia): a full-period 32-bit generator in three shifts and xors
+static uint32_t globals_nextRandomWord() {
+    uint32_t x = globals_generatorState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    globals_generatorState = x;
+    return x;
+}
 
+// getter for the value of a specific value within the sequence at an index
+uint8_t globals_getSequenceValue(uint16_t index) {
+    if(index >= globals_sequenceLength) {
+        return 0; // past the end of the sequence
+    }
+    uint16_t word = index >> SYMBOL_INDEX_SHIFT;
+    // generate up to the word holding this symbol; the sequence is read in order, so this is at most
+    // one word every 16 symbols
+    while(globals_generatedWords <= word) {
+        globals_sequence[globals_generatedWords++] = globals_nextRandomWord();
+    }
+    return (globals_sequence[word] >> ((index & SYMBOL_POSITION_MASK) * SYMBOL_BITS)) & SYMBOL_MASK;
+}
@@ -10,15 +10,29 @@
 
 
 #include <stdint.h>
-#define GLOBALS_MAX_FLASH_SEQUENCE 1000                  // Make it big so you can use it for a splash screen.
+#include <stdbool.h>
+#define GLOBALS_MAX_FLASH_SEQUENCE 4096                  // Make it big so you can use it for a splash screen.
 #define TICK_PERIOD 75
 
+// The sequence is stored as 2-bit symbols (one of the four regions), 16 to a 32-bit word, so even the
+// longest sequence takes 1 KB. It is either copied in with globals_setSequence() or generated from a seed
+// with globals_setSequenceSeed(). A seeded sequence is made lazily: each word of 16 symbols is the next
+// output of a xorshift generator, produced the first time one of its symbols is read. Starting a new
+// sequence costs nothing however long it is, and the same seed always gives the same sequence.
+
 // This is the length of the complete sequence at maximum length.
 // You must copy the contents of the sequence[] array into the global variable that you maintain.
 // Do not just grab the pointer as this will fail.
+// Values are stored modulo 4; a length beyond GLOBALS_MAX_FLASH_SEQUENCE is cut to it.
 void globals_setSequence(const uint8_t sequence[], uint16_t length);
 
-// This returns the value of the sequence at the index.
+// Starts a new sequence of length symbols generated from seed (cut to GLOBALS_MAX_FLASH_SEQUENCE).
+void globals_setSequenceSeed(uint32_t seed, uint16_t length);
+
+// The seed of the current sequence, e.g., to replay it later. 0 if it was copied in.
+uint32_t globals_getSequenceSeed();
+
+// This returns the value of the sequence at the index, 0 past the end of the sequence.
 uint8_t globals_getSequenceValue(uint16_t index);
 
 // Retrieve the sequence length.
@@ -32,4 +46,9 @@ void globals_setSequenceIterationLength(uint16_t length);
 // the use works through the pattern one color at a time.
 uint16_t globals_getSequenceIterationLength();
 
+// Checks the packing, the seeded generator and the bounds. Prints the result and returns true if every
+// check passed. Host build:
+//   g++ -x c++ -O2 -I../.. -DGLOBALS_HOST -DTESTSUPPORT_HOST globals.c globals_runTest.c ../../supportFiles/testSupport.c -o globals_runTest
+bool globals_runTest();
+
 #endif /* GLOBALS_H_ */
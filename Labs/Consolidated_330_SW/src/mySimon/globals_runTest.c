@@ -0,0 +1,94 @@
+/*
+ * globals_runTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "globals.h"
+#include "supportFiles/testSupport.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define TEST_COPY_LENGTH 37 // not a whole number of words
+#define TEST_SEED 12345
+#define TEST_OTHER_SEED 12346
+#define REGION_COUNT 4
+// each region should come up about a quarter of the time in the longest sequence; allow 22% .. 28%
+#define MIN_REGION_COUNT (GLOBALS_MAX_FLASH_SEQUENCE * 22 / 100)
+#define MAX_REGION_COUNT (GLOBALS_MAX_FLASH_SEQUENCE * 28 / 100)
+
+static uint8_t firstPass[GLOBALS_MAX_FLASH_SEQUENCE]; // the seeded sequence as read in order
+
+// Copying a sequence in: values are kept modulo 4 and the length is cut to the maximum.
+static void globals_runCopyChecks() {
+    static uint8_t sequence[GLOBALS_MAX_FLASH_SEQUENCE + 1];
+    for(uint16_t i = 0; i < TEST_COPY_LENGTH; i++) {
+        sequence[i] = i * 7;
+    }
+    globals_setSequence(sequence, TEST_COPY_LENGTH);
+    bool matches = true;
+    for(uint16_t i = 0; i < TEST_COPY_LENGTH; i++) {
+        matches = matches && globals_getSequenceValue(i) == sequence[i] % REGION_COUNT;
+    }
+    testSupport_check(matches, "copied sequence reads back");
+    testSupport_check(globals_getSequenceLength() == TEST_COPY_LENGTH, "copied length");
+    testSupport_check(globals_getSequenceSeed() == 0, "copied sequence has no seed");
+    testSupport_check(globals_getSequenceValue(TEST_COPY_LENGTH) == 0, "past the end is 0");
+    globals_setSequence(sequence, GLOBALS_MAX_FLASH_SEQUENCE + 1);
+    testSupport_check(globals_getSequenceLength() == GLOBALS_MAX_FLASH_SEQUENCE, "long copy cut to the maximum");
+}
+
+// Seeded sequences: repeatable, different for another seed, the same in any read order, and evenly spread.
+static void globals_runSeedChecks() {
+    uint16_t regionCounts[REGION_COUNT] = {0};
+    globals_setSequenceSeed(TEST_SEED, GLOBALS_MAX_FLASH_SEQUENCE);
+    testSupport_check(globals_getSequenceSeed() == TEST_SEED, "seed recorded");
+    testSupport_check(globals_getSequenceLength() == GLOBALS_MAX_FLASH_SEQUENCE, "seeded length");
+    for(uint16_t i = 0; i < GLOBALS_MAX_FLASH_SEQUENCE; i++) {
+        firstPass[i] = globals_getSequenceValue(i);
+        regionCounts[firstPass[i]]++; // also checks every value is a region
+    }
+    for(uint8_t region = 0; region < REGION_COUNT; region++) {
+        testSupport_check(regionCounts[region] >= MIN_REGION_COUNT && regionCounts[region] <= MAX_REGION_COUNT,
+                "regions evenly spread");
+    }
+
+    // the same seed again, reading the last symbol first so every word is generated at once
+    globals_setSequenceSeed(TEST_SEED, GLOBALS_MAX_FLASH_SEQUENCE);
+    bool matches = globals_getSequenceValue(GLOBALS_MAX_FLASH_SEQUENCE - 1) == firstPass[GLOBALS_MAX_FLASH_SEQUENCE - 1];
+    for(uint16_t i = 0; i < GLOBALS_MAX_FLASH_SEQUENCE; i++) {
+        matches = matches && globals_getSequenceValue(i) == firstPass[i];
+    }
+    testSupport_check(matches, "same seed gives the same sequence");
+
+    globals_setSequenceSeed(TEST_OTHER_SEED, GLOBALS_MAX_FLASH_SEQUENCE);
+    uint16_t same = 0;
+    for(uint16_t i = 0; i < GLOBALS_MAX_FLASH_SEQUENCE; i++) {
+        same += globals_getSequenceValue(i) == firstPass[i];
+    }
+    testSupport_check(same < GLOBALS_MAX_FLASH_SEQUENCE / 2, "another seed gives another sequence");
+
+    globals_setSequenceSeed(0, GLOBALS_MAX_FLASH_SEQUENCE);
+    bool allZero = true;
+    for(uint16_t i = 0; i < GLOBALS_MAX_FLASH_SEQUENCE; i++) {
+        allZero = allZero && globals_getSequenceValue(i) == 0;
+    }
+    testSupport_check(!allZero, "seed 0 still generates");
+}
+
+// Runs the checks and prints the result.
+bool globals_runTest() {
+    testSupport_begin("globals_runTest");
+    globals_runCopyChecks();
+    globals_runSeedChecks();
+    return testSupport_end();
+}
+
+#ifdef GLOBALS_HOST
+// host entry point; the board build calls globals_runTest()
+int main() {
+    return globals_runTest() ? 0 : 1;
+}
+#endif
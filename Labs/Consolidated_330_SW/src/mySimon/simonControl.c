@@ -12,19 +12,21 @@
 #include "simonDisplay.h"
 #include "buttonHandler.h"
 #include "supportFiles/utils.h"
+#include "supportFiles/numericField.h"
+#include "supportFiles/stateMachine.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdlib.h>
 #include <stdio.h>
 
-#define SEQUENCE_MAX 100  // maximum length of the simon sequence
-#define NUMBER_OF_REGIONS 4 // number of touch regions on the game board
+#define SEQUENCE_MAX GLOBALS_MAX_FLASH_SEQUENCE  // maximum length of the simon sequence
+#define SESSION_SEED_STEP 0x9E3779B9 // added to the seed between sessions (2^32 / golden ratio)
 #define STARTING_SESSION_SEQUENCE_LENGTH 4 // when the game restarts, this is the length of the sequence
 #define STARTING_ITERATION_SEQUENCE_LENGTH 1 // starting length of the the current sequence iteration
-#define YAY_WIN_COUNTER_MAX (1500 / TICK_PERIOD) // win state max duration
-#define NEW_LEVEL_COUNTER_MAX (3500 / TICK_PERIOD) // new level screen max duration
-#define LOSE_MESSAGE_COUNTER_MAX (1500 / TICK_PERIOD) // lose screen max duration
-#define LONGEST_SEQUENCE_MESSAGE_COUNTER_MAX (2500 / TICK_PERIOD) // longest sequence message screen max duration
+#define YAY_WIN_MS 1500 // win state duration
+#define NEW_LEVEL_MS 3500 // new level screen duration
+#define LOSE_MESSAGE_MS 1500 // lose screen duration
+#define LONGEST_SEQUENCE_MESSAGE_MS 2500 // longest sequence message screen duration
 #define TEXT_SIZE_LARGE 4 // largest size of text, used for the game title in the splash screen
 #define TEXT_SIZE_SMALL 2 // smallest size of text
 #define SPLASH_SCREEN_CURSOR_X 50 // cursor marking the splash screen title
@@ -33,31 +35,33 @@
 #define MESSAGE_SCREEN_CURSOR_Y 100 // cursor marking a generic message screen text
 #define ERASE true // flag to draw text in black (erasing it)
 #define NO_ERASE false // flag to draw text in white (erasing it)
-#define LONGEST_SEQ_MESSAGE_LENGTH 22 // length of the string holding the longest sequence message
+#define LONGEST_SEQ_LABEL "Longest Sequence: " // printed in front of the longest sequence length
+#define LONGEST_SEQ_LABEL_LENGTH 18 // characters in LONGEST_SEQ_LABEL
+#define LONGEST_SEQ_DIGITS 4 // the sequence is at most SEQUENCE_MAX long
 #define SEQUENCE_LENGTH_OFFSET 1 // used to calculate the current longest sequence when a user breaks their record
 #define TEST_TICK_PERIOD_MS 50 // the tick period in miliseconds used for testing
 
 
 // control SM states
-typedef enum {
-    init_st, // beginning state, stays here until enabled
+enum {
+    init_st, // beginning state, only stays here for one tick
     splash_screen_st, // displays the splash screen and waits for user touch
     flashing_sequence_st, // flashes the current sequence iteration to the user
     verifying_sequence_st, // waits for user to repeat the sequence and checks its validity
     yay_win_st, // if the user completes the current session sequence, they are presented with this win message screen
     new_level_feedback_st, // after the win screen, this screen waits for the user to decide if they want a new session
     lose_st, // if there is an error in validation, the user is presented with this lose message screen
-    show_longest_sequence_st // before starting a new session, the user is shown this screen with their longest sequence
-} simonControl_st_t;
+    show_longest_sequence_st, // before starting a new session, the user is shown this screen with their longest sequence
+    state_count
+};
 
 // initialize globals
-static simonControl_st_t currentState = init_st; // set the beginning game state to init_st
-static uint32_t splashScreenCounter = 0; // set the splash screen counter to 0
+static uint32_t sessionSeed = 0; // seed of the sequence for the current session
 // set the iteration sequence length to its starting value
-static uint8_t iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH;
+static uint16_t iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH;
 // set the starting session sequence length to its starting value
-static uint8_t sessionSequenceLength = STARTING_SESSION_SEQUENCE_LENGTH;
-static uint8_t longestSequenceLength = 0; // clear the longest sequence length to -
+static uint16_t sessionSequenceLength = STARTING_SESSION_SEQUENCE_LENGTH;
+static uint16_t longestSequenceLength = 0; // clear the longest sequence length to -
 
 static void drawSplashScreen(bool); // prototype for a draw splash screen helper function
 static void drawWinScreen(bool); // prototype for the draw win screen helper function
@@ -66,168 +70,211 @@ static void drawLongestSequenceScreen(bool erase); // prototype for the draw lon
 static void drawLoseScreen(bool erase); // prototype for the draw lose screen helper function
 static void updateLongestSequenceLength(); // prototype for a helper function that updates the longest sequence record
 
+// starts a new sequence for the next session; the global module generates it from the seed as it is played,
+// so nothing is computed or copied here
+static void generateNewSequence() {
+    sessionSeed += SESSION_SEED_STEP; // a different seed, and so a different sequence, every session
+    globals_setSequenceSeed(sessionSeed, SEQUENCE_MAX);
+}
 
-// intialize state counters to 0
-static uint16_t yayWinCounter = 0; // set the win state counter to 0
-static uint16_t newLevelCounter = 0; // set the new level counter to 0
-static uint16_t loseMessageCounter = 0; // set the lose state counter to 0
-static uint16_t longestSequenceMessageCounter = 0; // set the longest message state counter to 0
+// each message screen is drawn when its state is entered and erased when it is left
+static void showSplashScreen(stateMachine_t* machine) {
+    drawSplashScreen(NO_ERASE);
+}
 
-// creates a new sequence and sets the global sequence to its result
-static void generateNewSequence() {
-    uint8_t tempSequence[SEQUENCE_MAX]; // creates a temporary array holding the generated sequence
-    // iterate through the array, adding a random int to each location
-    for(int i = 0; i < SEQUENCE_MAX; i++) {
-        tempSequence[i] = rand() % NUMBER_OF_REGIONS; // add a random number % 4 to each location
-    }
-    globals_setSequence(tempSequence, SEQUENCE_MAX); // pass this sequence to the global module
+// exit action of splash_screen_st; the time spent on the splash screen depends on when the user touches it,
+// so it is effectively a random seed, guaranteeing that the sequence will be random each time the user
+// plays (globals_getSequenceSeed() can replay it)
+static void leaveSplashScreen(stateMachine_t* machine) {
+    sessionSeed = stateMachine_getMsInState(machine);
+    drawSplashScreen(ERASE);
 }
 
-// SM tick function
-void simonControl_tick() {
-    // state actions
-    switch(currentState) {
-        case init_st: // no state actions for init state
-            break;
-        case splash_screen_st: // state actions for splash screen state
-            splashScreenCounter++; // increment the splash screen counter
-            break;
-        case flashing_sequence_st: // no state actions for flash sequence state
-            break;
-        case verifying_sequence_st: // no state actions for verify sequence state
-            break;
-        case yay_win_st: // win screen state actions
-            yayWinCounter++; // increment the win screen counter
-            break;
-        case new_level_feedback_st: // new level state actions
-            newLevelCounter++; // increment the new level counter
-            break;
-        case lose_st: // lose state actions
-            loseMessageCounter++; // increment the lose state actions
-            break;
-        case show_longest_sequence_st: // longest sequence state actions
-            longestSequenceMessageCounter++; // increment the longest sequence counter
-            break;
+static void showWinScreen(stateMachine_t* machine) {
+    drawWinScreen(NO_ERASE);
+}
+
+static void eraseWinScreen(stateMachine_t* machine) {
+    drawWinScreen(ERASE);
+}
+
+static void showNewLevelFeedbackScreen(stateMachine_t* machine) {
+    drawNewLevelFeedbackScreen(NO_ERASE);
+}
+
+static void eraseNewLevelFeedbackScreen(stateMachine_t* machine) {
+    drawNewLevelFeedbackScreen(ERASE);
+}
+
+static void showLoseScreen(stateMachine_t* machine) {
+    drawLoseScreen(NO_ERASE);
+}
+
+static void eraseLoseScreen(stateMachine_t* machine) {
+    drawLoseScreen(ERASE);
+}
+
+static void showLongestSequenceScreen(stateMachine_t* machine) {
+    drawLongestSequenceScreen(NO_ERASE);
+}
+
+// exit action of show_longest_sequence_st: the record is only kept for one session
+static void leaveLongestSequenceScreen(stateMachine_t* machine) {
+    drawLongestSequenceScreen(ERASE);
+    longestSequenceLength = 0;
+}
+
+// entry/exit actions of flashing_sequence_st: the flash sequence SM only ticks while in this state
+static void startFlashing(stateMachine_t* machine) {
+    flashSequence_enable();
+}
+
+static void stopFlashing(stateMachine_t* machine) {
+    flashSequence_disable();
+}
+
+// entry/exit actions of verifying_sequence_st: show the buttons and let the verify sequence SM check them
+static void startVerifying(stateMachine_t* machine) {
+    verifySequence_enable();
+    simonDisplay_drawAllButtons();
+}
+
+static void stopVerifying(stateMachine_t* machine) {
+    verifySequence_disable();
+    simonDisplay_eraseAllButtons();
+}
+
+static bool isTouched(stateMachine_t* machine) {
+    return display_isTouched();
+}
+
+static bool isFlashingComplete(stateMachine_t* machine) {
+    return flashSequence_isComplete();
+}
+
+static bool isVerifyingComplete(stateMachine_t* machine) {
+    return verifySequence_isComplete();
+}
+
+// the user timed out or pressed the wrong button
+static bool isVerifyingLost(stateMachine_t* machine) {
+    return verifySequence_isComplete() && (verifySequence_isTimeOutError() || verifySequence_isUserInputError());
+}
+
+// the user has repeated the whole session sequence
+static bool isVerifyingWon(stateMachine_t* machine) {
+    return verifySequence_isComplete() && iterationSequenceLength >= sessionSequenceLength;
+}
+
+// starts the first session after the splash screen
+static void startSession(stateMachine_t* machine) {
+    generateNewSequence(); // generate a new sequence for this session
+    // reset the iteration and session sequence lengths to their starting values
+    iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH;
+    sessionSequenceLength = STARTING_SESSION_SEQUENCE_LENGTH;
+    // pass the current iteration length to the global module
+    globals_setSequenceIterationLength(iterationSequenceLength);
+}
+
+// the user is still in the current level: flash one more element of the sequence
+static void nextIteration(stateMachine_t* machine) {
+    globals_setSequenceIterationLength(++iterationSequenceLength);
+    updateLongestSequenceLength(); // update the longest sequence record for the user
+}
+
+static void recordWin(stateMachine_t* machine) {
+    updateLongestSequenceLength(); // update the longest sequence record for the user
+}
+
+// the user asked for a new level: a fresh, one element longer sequence
+static void startNextLevel(stateMachine_t* machine) {
+    iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH; // reset the iteration length for the next session
+    globals_setSequenceIterationLength(iterationSequenceLength); // reset the global iteration length for the next session
+    // increment the session sequence length, up to the longest sequence there is
+    if(sessionSequenceLength < SEQUENCE_MAX) {
+        sessionSequenceLength++;
     }
+    generateNewSequence(); // generate a fresh sequence for the next session
+}
 
-    // state transitions
-    switch(currentState) {
-        case init_st: // only stay in the init state for one tick
-            drawSplashScreen(NO_ERASE); // draw the splash screen
-            currentState = splash_screen_st; // transition to splash screen state
-            break;
+static const stateMachine_state_t states[state_count] = {
+    {"init_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"splash_screen_st", STATEMACHINE_NONE, STATEMACHINE_NONE, showSplashScreen, NULL, leaveSplashScreen},
+    {"flashing_sequence_st", STATEMACHINE_NONE, STATEMACHINE_NONE, startFlashing, NULL, stopFlashing},
+    {"verifying_sequence_st", STATEMACHINE_NONE, STATEMACHINE_NONE, startVerifying, NULL, stopVerifying},
+    {"yay_win_st", STATEMACHINE_NONE, STATEMACHINE_NONE, showWinScreen, NULL, eraseWinScreen},
+    {"new_level_feedback_st", STATEMACHINE_NONE, STATEMACHINE_NONE, showNewLevelFeedbackScreen, NULL, eraseNewLevelFeedbackScreen},
+    {"lose_st", STATEMACHINE_NONE, STATEMACHINE_NONE, showLoseScreen, NULL, eraseLoseScreen},
+    {"show_longest_sequence_st", STATEMACHINE_NONE, STATEMACHINE_NONE, showLongestSequenceScreen, NULL, leaveLongestSequenceScreen},
+};
+
+static const stateMachine_transition_t transitions[] = {
+    {init_st, 0, NULL, NULL, splash_screen_st}, // only stay in the init state for one tick
+    // stay on the splash screen until the user touches it
+    {splash_screen_st, 0, isTouched, startSession, flashing_sequence_st},
+    {flashing_sequence_st, 0, isFlashingComplete, NULL, verifying_sequence_st},
+    // once the user has repeated the sequence (or failed to): lose, win, or flash one more element
+    {verifying_sequence_st, 0, isVerifyingLost, NULL, lose_st},
+    {verifying_sequence_st, 0, isVerifyingWon, recordWin, yay_win_st},
+    {verifying_sequence_st, 0, isVerifyingComplete, nextIteration, flashing_sequence_st},
+    {yay_win_st, YAY_WIN_MS, NULL, NULL, new_level_feedback_st},
+    // the user is done with their session if they don't touch the screen in time
+    {new_level_feedback_st, NEW_LEVEL_MS, NULL, NULL, show_longest_sequence_st},
+    {new_level_feedback_st, 0, isTouched, startNextLevel, flashing_sequence_st},
+    {lose_st, LOSE_MESSAGE_MS, NULL, NULL, show_longest_sequence_st},
+    {show_longest_sequence_st, LONGEST_SEQUENCE_MESSAGE_MS, NULL, NULL, splash_screen_st},
+};
+
+static const stateMachine_definition_t definition = {
+    "simonControl", states, state_count, transitions, sizeof(transitions) / sizeof(transitions[0]), init_st
+};
+
+static stateMachine_t machine = STATEMACHINE_INIT(&definition, TICK_PERIOD);
+
+// puts the game back at its start, with the sub state machines stopped wherever they were
+void simonControl_init() {
+    flashSequence_init(); // stop flashing, verifying and handling buttons
+    verifySequence_init();
+    buttonHandler_init();
+    stateMachine_reset(&machine); // the splash screen is drawn on the first tick
+    iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH;
+    sessionSequenceLength = STARTING_SESSION_SEQUENCE_LENGTH;
+    longestSequenceLength = 0;
+}
+
+// clears the screen and draws what the current state shows, e.g., when the game comes back after being
+// suspended; a square that was being flashed is not drawn again, the flash sequence carries on with the next
+void simonControl_redraw() {
+    display_fillScreen(DISPLAY_BLACK);
+    switch(stateMachine_getState(&machine)) {
         case splash_screen_st:
-            // stay in the splash screen as long as their is no user input
-            if(display_isTouched()) { // if the user touhces the display
-                // seed the random generator with the splash screen counter, because this depends on
-                // user interation, it is effectively seeded with a random number, guarenteeing that the
-                // sequence will be random each time the user plays
-                srand(splashScreenCounter);
-                drawSplashScreen(ERASE); // erase the splash screen
-                splashScreenCounter = 0; // reset the splash screen counter to 0
-                generateNewSequence(); // generate a new sequence for this session
-                // reset the iteration sequence length to its starting value
-                iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH;
-                // reset teh session sequence length to its starting value
-                sessionSequenceLength = STARTING_SESSION_SEQUENCE_LENGTH;
-                // pass the current iteration length to the global module
-                globals_setSequenceIterationLength(iterationSequenceLength);
-                flashSequence_enable(); // enable the flash sequence SM, allowing it to start ticking
-                currentState = flashing_sequence_st; // transition to the flash sequence state
-            }
-            break;
-        case flashing_sequence_st:
-            // stay in the flash sequence state until the flash sequence SM is done
-            if(flashSequence_isComplete()) {
-                // once the flash sequence SM is complete, disable it
-                flashSequence_disable();
-                // enable the verify sequence SM, allowing it to start ticking
-                verifySequence_enable();
-                // draw all the buttons
-                simonDisplay_drawAllButtons();
-                currentState = verifying_sequence_st; // transition to the verify sequence state
-            }
+            drawSplashScreen(NO_ERASE);
             break;
         case verifying_sequence_st:
-            // stay in the verify sequence state until the verify sequence SM is complete
-            if(verifySequence_isComplete()) {
-                // once the verify sequence SM is complete, disbale the verify sequence SM
-                verifySequence_disable();
-                simonDisplay_eraseAllButtons(); // erase all the buttons
-                // check the verify SM for errors
-                if(verifySequence_isTimeOutError() || verifySequence_isUserInputError()) {
-                    // if there are errors, draw the lose screen
-                    drawLoseScreen(NO_ERASE);
-                    currentState = lose_st; // and transition to the lose state
-                // if there are no errors but the user has passed the level
-                } else if(iterationSequenceLength >= sessionSequenceLength) {
-                    drawWinScreen(NO_ERASE); // draw the win screen message
-                    updateLongestSequenceLength(); // update the longest sequence record for the user
-                    currentState = yay_win_st; // transition to win state
-                } else {
-                    // otherwise, assume that the user is still in the current level
-                    // and increment and set the new iteration length
-                    globals_setSequenceIterationLength(++iterationSequenceLength);
-                    flashSequence_enable(); // re enable the flash sequence SM
-                    updateLongestSequenceLength(); // update the lognest sequence record for the user
-                    currentState = flashing_sequence_st; // transition to flashing sequence state
-                }
-            }
+            simonDisplay_drawAllButtons();
             break;
         case yay_win_st:
-            // stay in the win message state until its counter expires
-            if(yayWinCounter > YAY_WIN_COUNTER_MAX) {
-                // win the counter expires, reset the counter to 0
-                yayWinCounter = 0;
-                drawWinScreen(ERASE); // erase the win message
-                drawNewLevelFeedbackScreen(NO_ERASE); // draw the new level feedback screen
-                currentState = new_level_feedback_st; // transition to the new level feedback state
-            }
+            drawWinScreen(NO_ERASE);
             break;
         case new_level_feedback_st:
-            // stay in level state until one of two conditions is satisfied
-            // first, if the screen counter maxes out, indicating the user is done with their session
-            if(newLevelCounter > NEW_LEVEL_COUNTER_MAX) {
-                newLevelCounter = 0; // reset the new level screen counter
-                drawNewLevelFeedbackScreen(ERASE); // erase the new level screen text
-                drawLongestSequenceScreen(NO_ERASE); // draw the next screen (longest sequence)
-                currentState = show_longest_sequence_st; // transition to longest sequence screen
-            // second, transition if the user touches the screen, indicating they want to start a new level
-            } else if(display_isTouched()) {
-                newLevelCounter = 0; // reset the the counter to 0
-                drawNewLevelFeedbackScreen(ERASE); // erase the current screen text
-                iterationSequenceLength = STARTING_ITERATION_SEQUENCE_LENGTH; // reset the iterationlength for the next session
-                globals_setSequenceIterationLength(iterationSequenceLength); //reset the global iteration length for the net session
-                sessionSequenceLength++; // increment the counter controlling the session sequence length
-                generateNewSequence(); // generate a fresh sequence for the next session
-                flashSequence_enable(); // enable the flash sequence SM, allowing it to start ticking
-                currentState = flashing_sequence_st; // transition to the flash sequence state
-            }
+            drawNewLevelFeedbackScreen(NO_ERASE);
             break;
         case lose_st:
-            // stay in the lose message state until the counter expires
-            if(loseMessageCounter > LOSE_MESSAGE_COUNTER_MAX) {
-                // once the counter expires, reset the counter to 0
-                loseMessageCounter = 0;
-                drawLoseScreen(ERASE); // erase the screen text
-                drawLongestSequenceScreen(NO_ERASE); // draw the longest sequence screen (next state)
-                currentState = show_longest_sequence_st; // transition to longest sequence state
-            }
+            drawLoseScreen(NO_ERASE);
             break;
         case show_longest_sequence_st:
-            // stay in the longest sequence message state until the counter expires
-            if(longestSequenceMessageCounter > LONGEST_SEQUENCE_MESSAGE_COUNTER_MAX) {
-                // once the counter expires reset the longest sequence counter to 0
-                longestSequenceMessageCounter = 0;
-                longestSequenceLength = 0; // reset the longest sequence length to 0
-                drawLongestSequenceScreen(ERASE); // erase the longest sequence screen text
-                drawSplashScreen(NO_ERASE); // draw the splash screen
-                currentState = splash_screen_st; // transition to the splash screen state
-            }
+            drawLongestSequenceScreen(NO_ERASE);
+            break;
+        default: // the init state draws nothing and the flash sequence draws its own squares
             break;
     }
 }
 
+// SM tick function
+void simonControl_tick() {
+    stateMachine_tick(&machine);
+}
+
 // helper function to draw the splash screen, bool erase passed in to determine if
 // screen should be drawn or erased
 static void drawSplashScreen(bool erase) {
@@ -263,24 +310,21 @@ static void drawNewLevelFeedbackScreen(bool erase) {
 
 // helper function to draw the longest sequence screen
 static void drawLongestSequenceScreen(bool erase) {
-    // since this function must be responsable for drawing the current score but erasing the previous score
-    // stoer the last printed as a static variable so that it can be used for erasing
-    static uint16_t lastPrinted;
-    char message[LONGEST_SEQ_MESSAGE_LENGTH]; // string containing the message
-    if(!erase) {
-        // if the message is not to be erased, concatenate the longest sequence into its message
-        sprintf(message, "Longest Sequence: %d\n", longestSequenceLength);
-        lastPrinted = longestSequenceLength; // and update the last printed (so that it may be erased in the future)
-    } else {
-        // if the message is to be erased, concatenate the last printed score into the message
-        sprintf(message, "Longest Sequence: %d\n", lastPrinted);
-    }
-    // if the erase bool was true, set the text color to black so that it will effectively erase the text,
-    // otherwhise, set the text color to white
+    // the length goes in a numeric field after the label, so erasing it is one fill instead of
+    // printing the old message again in black
+    static numericField_t longestSequenceField;
     erase ? display_setTextColor(DISPLAY_BLACK) : display_setTextColor(DISPLAY_WHITE);
     display_setTextSize(TEXT_SIZE_SMALL); // set the appropriate text size
     display_setCursor(MESSAGE_SCREEN_CURSOR_X, MESSAGE_SCREEN_CURSOR_Y); // set the cursor to the appropriate place for this message
-    display_println(message); // print the longest sequence message to the screen
+    display_print(LONGEST_SEQ_LABEL); // print the label of the message
+    if(erase) {
+        numericField_erase(&longestSequenceField); // and blank out the number after it
+        return;
+    }
+    numericField_init(&longestSequenceField, MESSAGE_SCREEN_CURSOR_X +
+            LONGEST_SEQ_LABEL_LENGTH * DISPLAY_CHAR_WIDTH * TEXT_SIZE_SMALL, MESSAGE_SCREEN_CURSOR_Y,
+            LONGEST_SEQ_DIGITS, TEXT_SIZE_SMALL, DISPLAY_WHITE, DISPLAY_BLACK, numericField_alignLeft_e);
+    numericField_draw(&longestSequenceField, longestSequenceLength); // then the longest sequence
 }
 
 // helper function to draw the lose screen
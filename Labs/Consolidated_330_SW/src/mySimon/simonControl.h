@@ -8,6 +8,12 @@
 #ifndef SIMONCONTROL_H_
 #define SIMONCONTROL_H_
 
+// Puts the game back at its start (the splash screen), stopping the flash, verify and button state machines.
+void simonControl_init();
+
+// Clears the screen and draws it again for the state the game is in.
+void simonControl_redraw();
+
 void simonControl_tick();
 
 
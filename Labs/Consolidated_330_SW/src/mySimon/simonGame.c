@@ -0,0 +1,36 @@
+/*
+ * simonGame.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "simonGame.h"
+#include "simonControl.h"
+#include "flashSequence.h"
+#include "verifySequence.h"
+#include "buttonHandler.h"
+#include "globals.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// same priorities as simonMain.c
+#define FLASH_SEQUENCE_PRIORITY 0
+#define VERIFY_SEQUENCE_PRIORITY 1
+#define BUTTON_HANDLER_PRIORITY 2
+#define SIMON_CONTROL_PRIORITY 3
+
+const game_t simonGame_descriptor = {
+    "Simon",
+    {
+        {"flashSequence_tick()", flashSequence_tick, TICK_PERIOD, FLASH_SEQUENCE_PRIORITY},
+        {"verifySequence_tick()", verifySequence_tick, TICK_PERIOD, VERIFY_SEQUENCE_PRIORITY},
+        {"buttonHandler_tick()", buttonHandler_tick, TICK_PERIOD, BUTTON_HANDLER_PRIORITY},
+        {"simonControl_tick()", simonControl_tick, TICK_PERIOD, SIMON_CONTROL_PRIORITY},
+    },
+    simonControl_init,
+    simonControl_redraw,
+    NULL,
+    NULL,
+    NULL,
+};
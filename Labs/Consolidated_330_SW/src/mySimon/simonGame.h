@@ -0,0 +1,16 @@
+/*
+ * simonGame.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SIMONGAME_H_
+#define SIMONGAME_H_
+
+#include "supportFiles/game.h"
+
+// Simon as a game for the launcher: the control, flash, verify and button state machines tick while it runs.
+extern const game_t simonGame_descriptor;
+
+#endif /* SIMONGAME_H_ */
@@ -8,6 +8,9 @@
 #ifndef VERIFYSEQUENCE_H_
 #define VERIFYSEQUENCE_H_
 
+// Puts the state machine back in its init state, disabled, wherever it was.
+void verifySequence_init();
+
 // State machine will run when enabled.
 void verifySequence_enable();
 
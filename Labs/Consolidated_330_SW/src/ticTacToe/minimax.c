@@ -11,23 +11,48 @@
 #include <limits.h>
 #include <stdio.h>
 
-#define MAX_BOARD_INDEX 2 // highets row / column index on the game boarde
+#define BOARD_SQUARE_COUNT (MINIMAX_BOARD_ROWS * MINIMAX_BOARD_COLUMNS) // number of squares on the board
+#define FULL_BOARD_MASK 0x1FF // all 9 squares taken
+#define WIN_TABLE_WORD_SHIFT 5 // selects the 32-bit word of the win table that holds a mask's bit
+#define WIN_TABLE_BIT_MASK 0x1F // selects the bit within that word
 #define MOVE_SCORE_TABLE_SIZE 10 // the size for each move / score array create during recursion
 #define INIT_SCORE_TABLE_VAL -5 // value that score arrays are initialized to
 #define INIT_MOVE_TABLE_VAL 255 // value that the move arrays are initialized to
 #define STARTING_RECURSION_DEPTH 0 // initial depth parameter for recursion
-#define CHOICE_INIT_VAL  255 // value that the choice global is initialized to
+#define CHOICE_INIT_VAL  255 // value that the selected move is initialized to
 #define COMPUTER_FIRST_MOVE_X 1 // if the computer is given the first move, it is hard coded to move to this x
 #define COMPUTER_FIRST_MOVE_Y 1 // if the computer is given the first move, it is hard coded to move to this y
-//for debugging: number of boards created in a run through of the recursion, reset after each computeNextStep is finished
-uint32_t boardCount = 0;
-
-// global variable that is overwritten during each call of minimax but contains the most recent selection
-minimax_move_t choice = { .row = CHOICE_INIT_VAL, .column = CHOICE_INIT_VAL };
+#define UNLIMITED_DEPTH BOARD_SQUARE_COUNT // no game lasts longer than this many moves
+#define PERCENT 100 // randomMovePercent is out of 100
+
+// search depth and random-move rate for each difficulty level (see minimax_level_t)
+typedef struct {
+    uint16_t maxDepth; // moves to look ahead before calling the position a draw
+    uint8_t randomMovePercent; // chance of playing a random empty square instead of searching
+} levelSettings_t;
+static const levelSettings_t levelSettings[MINIMAX_LEVEL_COUNT] = {
+    {1, 40},                // easy
+    {2, 15},                // medium
+    {4, 0},                 // hard
+    {UNLIMITED_DEPTH, 0}    // perfect
+};
+
+// NOTE: the search keeps no global state (the selected move is passed down by pointer), so it can
+// run on CPU1 as an amp job while CPU0 keeps ticking the game (see ticTacToeControl.c).
+
+// The 8 win lines as 9-bit masks (bit i is square i, row-major):
+// rows 0x007 0x038 0x1C0, columns 0x049 0x092 0x124, diagonals 0x111 0x054.
+// Bit m of this 512-bit table is set if mask m contains at least one of them,
+// so win detection is a single lookup (generated offline from the 8 masks above).
+static const uint32_t winningMaskTable[] = {
+    0x80808080, 0xFF808080, 0xFAF0AA80, 0xFFF0AA80, 0xCCCC8080, 0xFFCC8080, 0xFEFCAA80, 0xFFFCAA80,
+    0xAAAA8080, 0xFFFAF0F0, 0xFAFAAA80, 0xFFFAFAF0, 0xEEEE8080, 0xFFFEF0F0, 0xFFFFFFFF, 0xFFFFFFFF
+};
 
 // function delcarations -- definitions found below
 uint16_t findChoiceIndex(minimax_score_t* scoreTable, bool player);
-minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth);
+minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth, uint16_t maxDepth, minimax_move_t* choice);
+bool pickRandomSquare(minimax_board_t* board, uint32_t randomValue, minimax_move_t* move);
 void initArrays(minimax_move_t* moveTable, minimax_score_t* scoreTable);
 void addMoveToTable(minimax_move_t* moveTable, minimax_move_t move);
 void addScoreToTable(minimax_score_t* scoreTable, minimax_score_t score);
@@ -43,27 +68,37 @@ bool minimax_isGameOver(minimax_score_t score) {
 // the current board,
 // the player. true means the computer is X. false means the computer is O.
 void minimax_computeNextMove(minimax_board_t* board, bool player, uint8_t* row, uint8_t* column) {
-    if(isBoardEmpty(board)) {
+    // full strength: no random moves, so randomValue does not matter
+    minimax_computeNextMoveAtLevel(board, player, minimax_level_perfect, 0, row, column);
+}
+
+// Same as minimax_computeNextMove() but plays at the given difficulty level.
+void minimax_computeNextMoveAtLevel(minimax_board_t* board, bool player, minimax_level_t level,
+                                    uint32_t randomValue, uint8_t* row, uint8_t* column) {
+    const levelSettings_t* settings = &levelSettings[level];
+    // overwritten at each level of the recursion, but the top level writes it last
+    minimax_move_t choice = { .row = CHOICE_INIT_VAL, .column = CHOICE_INIT_VAL };
+    // lower levels sometimes skip the search and play a random empty square
+    bool playedRandomSquare = randomValue % PERCENT < settings->randomMovePercent
+                              && pickRandomSquare(board, randomValue / PERCENT, &choice);
+    if(playedRandomSquare) {
+        // choice already holds the random square
+    } else if(isBoardEmpty(board)) {
         choice.row = COMPUTER_FIRST_MOVE_Y;
         choice.column = COMPUTER_FIRST_MOVE_X;
     } else {
-        // recurses and stores the new choice in the global choice varaible
-        minimax_rec(board, player, STARTING_RECURSION_DEPTH);
+        // recurses and stores the new choice in the local choice varaible
+        minimax_rec(board, player, STARTING_RECURSION_DEPTH, settings->maxDepth, &choice);
     }
-    // extract the row value to a global variable
+    // extract the row value to the caller's variable
     *row = choice.row;
-    // extract the column value to a global variable
+    // extract the column value to the caller's variable
     *column = choice.column;
-    // reset the global that keeps track of boards created during recursion to 0
-    boardCount = 0;
 }
 
 // the recursive function that produces all possible board combinations and caclutes the most
 // advantageous move for the computer to take
-minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth) {
-    // transfer the blobal value of the board count to give each created board a unique number
-    uint16_t boardNum = boardCount;
-
+minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth, uint16_t maxDepth, minimax_move_t* choice) {
     // base case of the recursion
         // first, compute the board score
     minimax_score_t score = minimax_computeBoardScore(board, !player);
@@ -74,6 +109,11 @@ minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth)
         return minimax_computeBoardScore(board, !player);
     }
 
+    // past the depth limit of a lower level, an unfinished game is scored as a draw
+    if(depth >= maxDepth) {
+        return MINIMAX_DRAW_SCORE;
+    }
+
     // if the base case is passed, all possible moves from this board on will be calculated
     // the following arrays represent a move / score table that will keep track of the best
     // possible move
@@ -95,7 +135,7 @@ minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth)
 
                 // compute the best possible score of this board by recursively calling miminmax
                 // on this board, but switching the player (it is the next players turn)
-                minimax_score_t score = minimax_rec(board, !player, depth);
+                minimax_score_t score = minimax_rec(board, !player, depth + 1, maxDepth, choice);
 
                 // create a move struct and store the current i and j values (corresponding to
                 // row and column values) in the move
@@ -117,7 +157,7 @@ minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth)
     // in order to return the most advantageous move, first find the index of the highest score
     uint16_t index = findChoiceIndex(scoreTable, player);
     // then return the move that corresponds to that score
-    choice = moveTable[index];
+    *choice = moveTable[index];
     return scoreTable[index];
 }
 
@@ -132,72 +172,26 @@ minimax_score_t minimax_rec(minimax_board_t* board, bool player, uint16_t depth)
 // you don't need to look for 'O's, and vice-versa.
 minimax_score_t minimax_computeBoardScore(minimax_board_t* board, bool player) {
     // since only either X or O needs to be searched based off the player argument, determine which one will be searched for
-    uint16_t valToSearch;
-    valToSearch = player ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
-
-    // search for wins in rows, columns, and diagonals
-    uint32_t i, j, rowCount, columnCount, diagonalCount1, diagonalCount2, nonEmptyCount;
-    // keep a count of each row, column, and diagonal so that a win can be detected
-    rowCount = columnCount = diagonalCount1 = diagonalCount2 = nonEmptyCount = 0;
-    // iterate through each row
-    for(i = 0; i < MINIMAX_BOARD_ROWS; i++) {\
-        // iterate through each column
-        for(j = 0; j < MINIMAX_BOARD_COLUMNS; j++) {
-
-            // search each row
-            if(board->squares[i][j] == valToSearch) {
-                // increment row count if the appropriate value is detected
-                rowCount++;
-            }
-
-            // search each column by using the reversed coordinates of the row check
-            if(board->squares[j][i] == valToSearch) {
-                // increment  count if the appropriate value is detected
-                columnCount++;
-            }
-
-            // search diagonal 1 (top right to bottom left) by checking only when i = j
-            if(i == j && board->squares[i][j] == valToSearch) {
-                // increment diagonal1 count if the appropriate value is detected
-                diagonalCount1++;
-            }
-
-            // search diagonal 1 (top left to bottom right)
-            if(i + j == MAX_BOARD_INDEX && board->squares[i][j] == valToSearch) {
-                // increment diagonal2 count if the appropriate value is detected
-                diagonalCount2++;
-            }
-
-            // if a square is non zero, it is non empty and should be counted so that recursion
-            // can end when the game is in a draw
-            if(board->squares[i][j]) {
-                nonEmptyCount++;
-            }
-        }
-
-        // check to see if the row count or column count reached a win
-        if(rowCount == MINIMAX_BOARD_ROWS || columnCount == MINIMAX_BOARD_COLUMNS) {
-            // return the appropriate score if a win is detected
-            return player ? MINIMAX_PLAYER_WINNING_SCORE : MINIMAX_OPPONENT_WINNING_SCORE;
-        }
-        // reset the row and column count after each row / column
-        rowCount = columnCount = 0;
-    }
-
-    // after iterating through the whole board, check to see if either diagonal reached a win
-    if(diagonalCount1 == MINIMAX_BOARD_ROWS || diagonalCount2 == MINIMAX_BOARD_ROWS) {
-        // return the apropriate end game score if a win is reached
-        return player ? MINIMAX_PLAYER_WINNING_SCORE : MINIMAX_OPPONENT_WINNING_SCORE;
+    uint8_t valToSearch = player ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+    const uint8_t* squares = &board->squares[0][0];
+
+    // pack the board into two 9-bit masks (bit i is square i, row-major): the squares holding
+    // valToSearch, and the squares that are taken at all. the compares produce 0 or 1, no branches
+    uint32_t mask = 0, occupied = 0, i;
+    for(i = 0; i < BOARD_SQUARE_COUNT; i++) {
+        mask |= (uint32_t) (squares[i] == valToSearch) << i;
+        occupied |= (uint32_t) (squares[i] != MINIMAX_EMPTY_SQUARE) << i;
     }
 
-    // if the non empty count indicates that the board is full
-    if(nonEmptyCount == (MINIMAX_BOARD_COLUMNS * MINIMAX_BOARD_ROWS)) {
-        // return the score indicating that the game is a draw
-        return MINIMAX_DRAW_SCORE;
-    }
+    // one table lookup tells if the mask contains any of the 8 win lines
+    int32_t isWin = (winningMaskTable[mask >> WIN_TABLE_WORD_SHIFT] >> (mask & WIN_TABLE_BIT_MASK)) & 1;
+    int32_t isFull = occupied == FULL_BOARD_MASK;
 
-    // if no endgame is reached return the approprate score
-    return MINIMAX_NOT_ENDGAME;
+    // select the score with masks instead of branches (all ones when the condition holds)
+    int32_t winSelect = -isWin, fullSelect = -isFull, playerSelect = -(int32_t) player;
+    int32_t winScore = (MINIMAX_PLAYER_WINNING_SCORE & playerSelect) | (MINIMAX_OPPONENT_WINNING_SCORE & ~playerSelect);
+    int32_t otherScore = (MINIMAX_DRAW_SCORE & fullSelect) | (MINIMAX_NOT_ENDGAME & ~fullSelect);
+    return (minimax_score_t) ((winScore & winSelect) | (otherScore & ~winSelect));
 }
 
 // helper function to init the board to all empty squares.
@@ -281,6 +275,33 @@ uint16_t findChoiceIndex(minimax_score_t* scoreTable, bool player) {
     return player ? highestIndex : lowestIndex;
 }
 
+// helper function that sets move to one of the empty squares, chosen by randomValue.
+// returns false if the board is full
+bool pickRandomSquare(minimax_board_t* board, uint32_t randomValue, minimax_move_t* move) {
+    uint32_t i, j, emptyCount = 0;
+    // count the empty squares
+    for(i = 0; i < MINIMAX_BOARD_ROWS; i++) {
+        for(j = 0; j < MINIMAX_BOARD_COLUMNS; j++) {
+            emptyCount += board->squares[i][j] == MINIMAX_EMPTY_SQUARE;
+        }
+    }
+    if(!emptyCount) {
+        return false;
+    }
+    // walk to the selected empty square
+    uint32_t target = randomValue % emptyCount;
+    for(i = 0; i < MINIMAX_BOARD_ROWS; i++) {
+        for(j = 0; j < MINIMAX_BOARD_COLUMNS; j++) {
+            if(board->squares[i][j] == MINIMAX_EMPTY_SQUARE && target-- == 0) {
+                move->row = i;
+                move->column = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 // helper function to determine if the board is empty
 bool isBoardEmpty(minimax_board_t* board) {
     uint32_t i, j;
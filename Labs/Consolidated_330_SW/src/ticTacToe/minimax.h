@@ -43,12 +43,28 @@ typedef struct {
 // Define a score type.
 typedef int16_t minimax_score_t;
 
+// Difficulty levels. Lower levels look fewer moves ahead and sometimes play a random square,
+// which makes them both easier to beat and cheaper to compute. Perfect is the exhaustive search.
+typedef enum {
+    minimax_level_easy,     // looks 1 move ahead (takes a win), 40% random moves
+    minimax_level_medium,   // looks 2 moves ahead (also blocks), 15% random moves
+    minimax_level_hard,     // looks 4 moves ahead, never random
+    minimax_level_perfect   // searches to the end of the game
+} minimax_level_t;
+#define MINIMAX_LEVEL_COUNT 4
+
 // This routine is not recursive but will invoke the recursive minimax function.
 // It computes the row and column of the next move based upon:
 // the current board,
 // the player. true means the computer is X. false means the computer is O.
 void minimax_computeNextMove(minimax_board_t* board, bool player, uint8_t* row, uint8_t* column);
 
+// Same as minimax_computeNextMove() but plays at the given difficulty level.
+// randomValue decides the random moves of the lower levels (pass rand(), or a fixed value to repeat a game).
+// The caller supplies it so that the search itself keeps no state and can run on CPU1.
+void minimax_computeNextMoveAtLevel(minimax_board_t* board, bool player, minimax_level_t level,
+                                    uint32_t randomValue, uint8_t* row, uint8_t* column);
+
 // Determine that the game is over by looking at the score.
 bool minimax_isGameOver(minimax_score_t score);
 
@@ -0,0 +1,301 @@
+/*
+ * minimaxBench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "minimaxBench.h"
+#include "minimax.h"
+#include "supportFiles/testSupport.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BOARD_SQUARES (MINIMAX_BOARD_ROWS * MINIMAX_BOARD_COLUMNS) // 9 squares
+#define WIN_LINE_COUNT 8 // 3 rows, 3 columns, 2 diagonals
+#define POSITION_KEY_COUNT 19683 // 3^9: every board encoded as a base-3 number
+#define REACHABLE_POSITION_COUNT 5478 // known count of distinct positions reachable in legal play
+#define PERFT_TOTAL_NODES 549946 // known size of the full game tree (games stop at a win)
+#define SCORE_REPEATS 100 // computeBoardScore calls per position per timing sample
+#define NS_PER_SECOND 1.0E9 // converts seconds to nanoseconds
+#define PERCENTILE_50 50 // median
+#define PERCENTILE_90 90 // 90th percentile
+#define PERCENTILE_99 99 // 99th percentile
+#define PERCENT 100 // divisor for percentiles
+#define LEVEL_RANDOM_MULTIPLIER 2654435761u // Knuth's multiplicative hash, spreads position indices into random values
+
+// Perfect-play values of a position, from X's point of view.
+#define VALUE_X_WINS 1
+#define VALUE_DRAW 0
+#define VALUE_O_WINS -1
+#define VALUE_UNKNOWN 2 // not computed yet
+
+// known tic-tac-toe perft numbers: nodes at each ply of the full game tree
+static const uint32_t perftReference[BOARD_SQUARES + 1] = {1, 9, 72, 504, 3024, 15120, 54720, 148176, 200448, 127872};
+
+// The 8 lines that win, as square indices (row * 3 + column).
+static const uint8_t winLines[WIN_LINE_COUNT][MINIMAX_BOARD_ROWS] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8}, // rows
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, // columns
+    {0, 4, 8}, {2, 4, 6}             // diagonals
+};
+
+static uint32_t perftCounts[BOARD_SQUARES + 1]; // nodes found at each ply
+static uint8_t positionSeen[POSITION_KEY_COUNT]; // true once a position has been added to the list
+static uint16_t positions[REACHABLE_POSITION_COUNT]; // keys of every distinct reachable position
+static uint32_t positionCount; // number of entries in positions
+static int8_t positionValues[POSITION_KEY_COUNT]; // perfect-play values, VALUE_UNKNOWN until computed
+static uint32_t subtreeSizes[POSITION_KEY_COUNT]; // game-tree nodes below (and including) a position, 0 until computed
+static uint32_t latencies[REACHABLE_POSITION_COUNT]; // per-position latency samples in ns
+
+// ******************************** board helpers ********************************
+// encodes a board as a base-3 number, square 0 being the least significant digit
+static uint16_t encodeBoard(minimax_board_t* board) {
+    uint16_t key = 0;
+    for(int32_t i = BOARD_SQUARES - 1; i >= 0; i--) {
+        key = key * 3 + board->squares[i / MINIMAX_BOARD_COLUMNS][i % MINIMAX_BOARD_COLUMNS];
+    }
+    return key;
+}
+
+// decodes a base-3 key back into a board
+static void decodeBoard(uint16_t key, minimax_board_t* board) {
+    for(uint32_t i = 0; i < BOARD_SQUARES; i++) {
+        board->squares[i / MINIMAX_BOARD_COLUMNS][i % MINIMAX_BOARD_COLUMNS] = key % 3;
+        key /= 3;
+    }
+}
+
+// returns true if it is X's turn (X always moves first)
+static bool isXToMove(minimax_board_t* board) {
+    int32_t balance = 0; // X count minus O count
+    for(uint32_t i = 0; i < BOARD_SQUARES; i++) {
+        uint8_t square = board->squares[i / MINIMAX_BOARD_COLUMNS][i % MINIMAX_BOARD_COLUMNS];
+        balance += (square == MINIMAX_PLAYER_SQUARE) - (square == MINIMAX_OPPONENT_SQUARE);
+    }
+    return balance == 0;
+}
+
+// independent scorer: same contract as minimax_computeBoardScore() but checks each of the 8 lines directly
+static minimax_score_t referenceScore(minimax_board_t* board, bool player) {
+    uint8_t* squares = &board->squares[0][0];
+    uint8_t mark = player ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+    for(uint32_t line = 0; line < WIN_LINE_COUNT; line++) {
+        if(squares[winLines[line][0]] == mark && squares[winLines[line][1]] == mark && squares[winLines[line][2]] == mark) {
+            return player ? MINIMAX_PLAYER_WINNING_SCORE : MINIMAX_OPPONENT_WINNING_SCORE;
+        }
+    }
+    for(uint32_t i = 0; i < BOARD_SQUARES; i++) {
+        if(squares[i] == MINIMAX_EMPTY_SQUARE) {
+            return MINIMAX_NOT_ENDGAME;
+        }
+    }
+    return MINIMAX_DRAW_SCORE;
+}
+
+// ******************************** reference search *****************************
+// walks the full game tree, counting nodes per ply and recording each distinct position once
+static void perft(minimax_board_t* board, bool xToMove, uint32_t ply) {
+    perftCounts[ply]++;
+    uint16_t key = encodeBoard(board);
+    if(!positionSeen[key] && positionCount < REACHABLE_POSITION_COUNT) {
+        positionSeen[key] = true;
+        positions[positionCount++] = key;
+    }
+    // stop at the end of a game (the last mover is !xToMove)
+    if(minimax_isGameOver(referenceScore(board, !xToMove))) {
+        return;
+    }
+    uint8_t* squares = &board->squares[0][0];
+    for(uint32_t i = 0; i < BOARD_SQUARES; i++) {
+        if(squares[i] == MINIMAX_EMPTY_SQUARE) {
+            squares[i] = xToMove ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+            perft(board, !xToMove, ply + 1);
+            squares[i] = MINIMAX_EMPTY_SQUARE;
+        }
+    }
+}
+
+// memoized perfect-play value of a position (from X's point of view); also fills in subtree sizes
+static int8_t solve(minimax_board_t* board, bool xToMove) {
+    uint16_t key = encodeBoard(board);
+    if(positionValues[key] != VALUE_UNKNOWN) {
+        return positionValues[key];
+    }
+    int8_t value;
+    uint32_t nodes = 1;
+    minimax_score_t score = referenceScore(board, !xToMove);
+    if(minimax_isGameOver(score)) {
+        value = score == MINIMAX_PLAYER_WINNING_SCORE ? VALUE_X_WINS : score == MINIMAX_OPPONENT_WINNING_SCORE ? VALUE_O_WINS : VALUE_DRAW;
+    } else {
+        value = xToMove ? VALUE_O_WINS : VALUE_X_WINS; // start from the worst case for the side to move
+        uint8_t* squares = &board->squares[0][0];
+        for(uint32_t i = 0; i < BOARD_SQUARES; i++) {
+            if(squares[i] == MINIMAX_EMPTY_SQUARE) {
+                squares[i] = xToMove ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+                int8_t childValue = solve(board, !xToMove);
+                nodes += subtreeSizes[encodeBoard(board)];
+                squares[i] = MINIMAX_EMPTY_SQUARE;
+                if(xToMove ? childValue > value : childValue < value) {
+                    value = childValue;
+                }
+            }
+        }
+    }
+    positionValues[key] = value;
+    subtreeSizes[key] = nodes;
+    return value;
+}
+
+// ******************************** reporting ************************************
+// comparison function for qsort
+static int compareLatencies(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+    return (x > y) - (x < y);
+}
+
+// sorts the latency samples and prints the percentiles
+static void printLatencies(const char* name, uint32_t sampleCount) {
+    qsort(latencies, sampleCount, sizeof(latencies[0]), compareLatencies);
+    printf("%s latency (ns): p50 %lu, p90 %lu, p99 %lu, max %lu\n\r", name,
+            (unsigned long) latencies[(sampleCount - 1) * PERCENTILE_50 / PERCENT],
+            (unsigned long) latencies[(sampleCount - 1) * PERCENTILE_90 / PERCENT],
+            (unsigned long) latencies[(sampleCount - 1) * PERCENTILE_99 / PERCENT],
+            (unsigned long) latencies[sampleCount - 1]);
+}
+
+// ******************************** benchmark ************************************
+// Runs the checks and the benchmark. Returns true if every check passed.
+bool minimaxBench_run() {
+    testSupport_begin("minimax benchmark");
+    minimax_board_t board;
+    printf("=============== minimax benchmark ===============\n\r");
+
+    // 1. perft: check that the tree walk itself is right before trusting anything built on it
+    for(uint32_t i = 0; i < POSITION_KEY_COUNT; i++) {
+        positionSeen[i] = false;
+        positionValues[i] = VALUE_UNKNOWN;
+        subtreeSizes[i] = 0;
+    }
+    positionCount = 0;
+    for(uint32_t ply = 0; ply <= BOARD_SQUARES; ply++) {
+        perftCounts[ply] = 0;
+    }
+    minimax_initBoard(&board);
+    testSupport_startTimer();
+    perft(&board, true, 0);
+    double perftSeconds = testSupport_stopTimer();
+    uint32_t perftTotal = 0;
+    for(uint32_t ply = 0; ply <= BOARD_SQUARES; ply++) {
+        perftTotal += perftCounts[ply];
+        if(perftCounts[ply] != perftReference[ply]) {
+            printf("perft ply %lu: expected %lu, found %lu\n\r", (unsigned long) ply, (unsigned long) perftReference[ply], (unsigned long) perftCounts[ply]);
+            testSupport_check(false, "perft node count");
+        }
+    }
+    printf("perft: %lu nodes, %lu distinct positions in %f s\n\r", (unsigned long) perftTotal, (unsigned long) positionCount, perftSeconds);
+    if(perftTotal != PERFT_TOTAL_NODES || positionCount != REACHABLE_POSITION_COUNT) {
+        printf("perft: expected %lu nodes, %lu positions\n\r", (unsigned long) PERFT_TOTAL_NODES, (unsigned long) REACHABLE_POSITION_COUNT);
+        testSupport_check(false, "perft totals");
+        return testSupport_end();
+    }
+    minimax_initBoard(&board);
+    solve(&board, true);
+
+    // 2. minimax_computeBoardScore(): correctness, then timing (contract: player is whoever moved last)
+    uint32_t scoreFailures = 0;
+    volatile minimax_score_t scoreSink; // keeps the timed calls from being optimized away
+    double scoreSeconds = 0;
+    for(uint32_t p = 0; p < positionCount; p++) {
+        decodeBoard(positions[p], &board);
+        bool lastMover = !isXToMove(&board);
+        if(minimax_computeBoardScore(&board, lastMover) != referenceScore(&board, lastMover)) {
+            scoreFailures++;
+        }
+        testSupport_startTimer();
+        for(uint32_t r = 0; r < SCORE_REPEATS; r++) {
+            scoreSink = minimax_computeBoardScore(&board, lastMover);
+        }
+        double seconds = testSupport_stopTimer();
+        scoreSeconds += seconds;
+        latencies[p] = (uint32_t) (seconds * NS_PER_SECOND / SCORE_REPEATS);
+    }
+    (void) scoreSink;
+    uint32_t scoreCalls = positionCount * SCORE_REPEATS;
+    printf("computeBoardScore: %lu mismatches over %lu positions\n\r", (unsigned long) scoreFailures, (unsigned long) positionCount);
+    printf("computeBoardScore: %lu calls in %f s, %f calls/s\n\r", (unsigned long) scoreCalls, scoreSeconds, scoreCalls / scoreSeconds);
+    printLatencies("computeBoardScore", positionCount);
+    testSupport_check(!scoreFailures, "computeBoardScore mismatches");
+
+    // 3. minimax_computeNextMove(): every position that is not over must get a legal, optimal move
+    uint32_t moveFailures = 0;
+    uint32_t searchCount = 0;
+    uint64_t searchNodes = 0;
+    double searchSeconds = 0;
+    for(uint32_t p = 0; p < positionCount; p++) {
+        decodeBoard(positions[p], &board);
+        bool xToMove = isXToMove(&board);
+        if(minimax_isGameOver(referenceScore(&board, !xToMove))) {
+            continue;
+        }
+        uint8_t row, column;
+        testSupport_startTimer();
+        minimax_computeNextMove(&board, xToMove, &row, &column);
+        double seconds = testSupport_stopTimer();
+        searchSeconds += seconds;
+        latencies[searchCount++] = (uint32_t) (seconds * NS_PER_SECOND);
+        // minimax answers the empty board without searching, so it adds no nodes
+        searchNodes += positions[p] ? subtreeSizes[positions[p]] : 0;
+        // the move must be on the board, on an empty square, and keep the perfect-play value
+        if(row >= MINIMAX_BOARD_ROWS || column >= MINIMAX_BOARD_COLUMNS || board.squares[row][column] != MINIMAX_EMPTY_SQUARE) {
+            moveFailures++;
+            continue;
+        }
+        board.squares[row][column] = xToMove ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+        if(positionValues[encodeBoard(&board)] != positionValues[positions[p]]) {
+            moveFailures++;
+        }
+    }
+    printf("computeNextMove: %lu non-optimal or illegal moves over %lu positions\n\r", (unsigned long) moveFailures, (unsigned long) searchCount);
+    printf("computeNextMove: %lu searches, %llu nodes in %f s, %f nodes/s\n\r", (unsigned long) searchCount,
+            (unsigned long long) searchNodes, searchSeconds, searchNodes / searchSeconds);
+    printLatencies("computeNextMove", searchCount);
+    testSupport_check(!moveFailures, "computeNextMove non-optimal or illegal moves");
+
+    // 4. difficulty levels: cost per move and how often each level still finds an optimal move
+    static const char* levelNames[MINIMAX_LEVEL_COUNT] = {"easy", "medium", "hard", "perfect"};
+    for(uint32_t level = 0; level < MINIMAX_LEVEL_COUNT; level++) {
+        uint32_t optimalCount = 0;
+        double levelSeconds = 0;
+        searchCount = 0;
+        for(uint32_t p = 0; p < positionCount; p++) {
+            decodeBoard(positions[p], &board);
+            bool xToMove = isXToMove(&board);
+            if(minimax_isGameOver(referenceScore(&board, !xToMove))) {
+                continue;
+            }
+            uint8_t row, column;
+            testSupport_startTimer();
+            // a fixed, well-mixed random value per position keeps runs repeatable
+            minimax_computeNextMoveAtLevel(&board, xToMove, (minimax_level_t) level, p * LEVEL_RANDOM_MULTIPLIER, &row, &column);
+            double seconds = testSupport_stopTimer();
+            levelSeconds += seconds;
+            latencies[searchCount++] = (uint32_t) (seconds * NS_PER_SECOND);
+            board.squares[row][column] = xToMove ? MINIMAX_PLAYER_SQUARE : MINIMAX_OPPONENT_SQUARE;
+            optimalCount += positionValues[encodeBoard(&board)] == positionValues[positions[p]];
+        }
+        printf("level %s: %f s total, %lu%% optimal moves\n\r", levelNames[level], levelSeconds,
+                (unsigned long) (optimalCount * PERCENT / searchCount));
+        printLatencies(levelNames[level], searchCount);
+    }
+
+    return testSupport_end();
+}
+
+#ifdef MINIMAXBENCH_HOST
+// host entry point; the board build calls minimaxBench_run() from minimaxMain.c
+int main() {
+    return minimaxBench_run() ? 0 : 1;
+}
+#endif
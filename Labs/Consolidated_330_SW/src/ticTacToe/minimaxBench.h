@@ -0,0 +1,19 @@
+/*
+ * minimaxBench.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef MINIMAXBENCH_H_
+#define MINIMAXBENCH_H_
+
+#include <stdbool.h>
+
+// Walks the whole game tree and checks the perft counts, computeBoardScore() and that computeNextMove() plays
+// optimally everywhere, then prints calls/sec and latency percentiles for both and for each level.
+// Returns true if every check passed. Host build (from this directory):
+//   gcc -O2 -I../.. -DMINIMAXBENCH_HOST -DTESTSUPPORT_HOST minimax.c minimaxTest.c minimaxBench.c ../../supportFiles/testSupport.c -o minimaxBench
+bool minimaxBench_run();
+
+#endif /* MINIMAXBENCH_H_ */
@@ -5,10 +5,11 @@
  *      Author: cdmoo
  */
 #include "minimax.h"
+#include "minimaxBench.h"
 #include <stdio.h>
 
 int main() {
-    printf("hello \n");
+    minimaxBench_run(); // checks the engine against the reference and prints timings
     return 0;
 }
 
@@ -8,44 +8,47 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
 #include "ticTacToeDisplay.h"
 #include "supportFiles/display.h"
 #include "minimax.h"
 #include "minimaxTest.h"
 #include "../switchesAndButtons/buttons.h"
+#include "../switchesAndButtons/switches.h"
 #include "../intervalTimer/intervalTimer.h"
 #include "supportFiles/utils.h"
+#include "supportFiles/amp.h"
+#include "supportFiles/stateMachine.h"
+#include "ticTacToeControl.h"
 
-#define TIMER_PERIOD 50 // the current period of each interrupt
-// the maximum time in ms of the adc counter divided by the interrupt period
-// to determine the number of ticks to stay in that state
-#define ADC_COUNTER_MAX (50 / TIMER_PERIOD)
-// the maximum time in ms of the splash screen counter divided by the interrupt period
-// to determine the number of ticks to stay in that state
-#define SPLASH_SCREEN_COUNTER_MAX (3000 / TIMER_PERIOD)
-// the maximum time in ms of the first move counter divided by the interrupt period
-// to determine the number of ticks to stay in that state
-#define FIRST_MOVE_COUNTER_MAX (3000 / TIMER_PERIOD)
+#define ADC_SETTLE_MS 50 // time to wait after a touch for the touch-controller ADC to settle
+#define SPLASH_SCREEN_MS 3000 // how long the instructions are shown before the game begins
+#define FIRST_MOVE_MS 3000 // how long the player has to take the first move before the computer does
+#define THINKING_BLINK_MS 250 // time between blinks of the thinking indicator
 #define TEST_TICK_PERIOD_MS 50 // period of a tick while running the test
+// SW1 and SW0 select the difficulty: both down is perfect play, both up is easy
+#define LEVEL_SWITCHES_MASK (SWITCHES_SW0_MASK | SWITCHES_SW1_MASK)
 
 
 // States for the controller state machine.
-typedef enum gameControl_st_t {
+enum {
     init_st,                 // Start here, stay in this state for just one tick.
     splash_screen_st,       // state for displaying the instructions message before the game begins
     waiting_first_move_st,   // state for waiting on the player to make the first move (else computer makes first move)
     adc_counter_running_st,     // waiting for the touch-controller ADC to settle.
     player_turn_waiting_st,    // waiting for the player to make a move
     evaluate_player_move_st,   // state that determines validity of move, returning control to player if move was invalid
-    computer_turn_st,  // state waiting for computer to make move
-    end_game_st  // state at the end of the game, waiting for reset button to be pressed
-} gameControl_st_t;
-// initialize the state to initState
-static gameControl_st_t currentState = init_st;
+    computer_turn_st,  // state that hands the board to the minimax search (on CPU1 when it is running)
+    computer_thinking_st, // state waiting for the search to finish, blinking the thinking indicator
+    end_game_st,  // state at the end of the game, waiting for reset button to be pressed
+    state_count
+};
 
-static uint32_t adcCounter; // global keeping tracks of ticks in the adc state
-static uint32_t splashScreenCounter; // global keeping tracks of ticks in the splash screen state
-static uint32_t firstMoveCounter; // global keeping tack of the waiting for the first move state
+static bool thinkingIndicatorOn; // global keeping track of whether the thinking indicator is drawn
+static bool moveJobPosted; // global keeping track of whether the search was handed off
+static bool computerMoveReady; // global keeping track of whether the computer's move has been played
+static bool discardPendingResult; // global set when a restarted game still owes the mailbox a search result
 
 static bool isPlayerTurn; // global keeping track of whose turn it is
 static bool isPlayerX; // global keeping track of whose playing which character
@@ -53,137 +56,235 @@ static minimax_board_t gameBoard; // global game board used for keeping track of
 static minimax_move_t computerNextMove; // global holding the computers calculated next move
 static minimax_move_t playerNextMove; // global keeping track of the players next move
 static minimax_score_t currentScore; // global keeping track of score
+static minimax_level_t computerLevel = minimax_level_perfect; // difficulty, latched from the switches when a game starts
+
+// arguments and result of a next-move search, passed through the amp mailbox
+typedef struct {
+    minimax_board_t board; // copy of the game board to search
+    bool player; // true if the computer is playing x
+    minimax_level_t level; // difficulty to play at
+    uint32_t randomValue; // decides the random moves of the lower levels
+    minimax_move_t move; // the move the search selected
+} computerMoveJob_t;
 
 // function declarations (definitions found below)
-static void debugStatePrint();
-static bool isPlayerMoveValid();
 static void playNextMove();
-static bool resetGame();
 static void eraseGameBoard();
+static void computerMoveJob(void* data);
 
-void ticTacToeControl_tick() {
-    //perform state action first
-    switch(currentState) {
-        case init_st: // no state action in the init state
-            break;
-        case splash_screen_st:
-            splashScreenCounter++;  // increase the splash screen counter during each tick in the state
-            break;
-        case waiting_first_move_st:
-            firstMoveCounter++; // increase the first move counter during each tick in the state
-            break;
-        case adc_counter_running_st:
-            adcCounter++; // increase the adc counter during each tick in the state
-            break;
-        case player_turn_waiting_st:
-            isPlayerTurn = true; // during the play turn state, set the global indicating that it is the players turn
-            break;
-        case evaluate_player_move_st:
-            // to evaluate the player move, fetch and store the players move on the touch screen
-            ticTacToeDisplay_touchScreenComputeBoardRowColumn(&playerNextMove.row, &playerNextMove.column);
-            // reset the score to include the most recent computed score
-            currentScore = minimax_computeBoardScore(&gameBoard, isPlayerX);
-            break;
-        case computer_turn_st:
-            isPlayerTurn = false; // during the computer's turn, set the global indicating that it is not the players turn
-            // use minimax to compute the next move based off of the current board
-            minimax_computeNextMove(&gameBoard, !isPlayerX, &computerNextMove.row, &computerNextMove.column);
-            playNextMove(); // mark the move on the game board and draw it to the screen
-            currentScore = minimax_computeBoardScore(&gameBoard, !isPlayerX); // update the current score after the move
-            break;
-        case end_game_st: // no state action for the end game state
-            break;
+// the splash screen is over: clear it and draw an empty game board
+static void drawGameBoard(stateMachine_t* machine) {
+    ticTacToeDisplay_clearSplashScreen();
+    ticTacToeDisplay_drawBoardLines(); // draw the game board
+    minimax_initBoard(&gameBoard); // initialize the game board
+}
+
+// during action of waiting_first_move_st: the switches set the difficulty until the first move is made
+static void readLevelSwitches(stateMachine_t* machine) {
+    computerLevel = (minimax_level_t) (minimax_level_perfect - (switches_read() & LEVEL_SWITCHES_MASK));
+}
+
+// exit action of waiting_first_move_st: the time until the first touch seeds the random moves of the lower levels
+static void seedRandomMoves(stateMachine_t* machine) {
+    srand(stateMachine_getMsInState(machine));
+}
+
+static bool isTouched(stateMachine_t* machine) {
+    return display_isTouched();
+}
+
+static void clearOldTouchData(stateMachine_t* machine) {
+    display_clearOldTouchData();
+}
+
+// the player touched the board first, so they play x
+static void playerMovesFirst(stateMachine_t* machine) {
+    isPlayerX = true; // flag the player as playing x
+    isPlayerTurn = true; // flag the players turn
+    display_clearOldTouchData(); // clear out the old touch data
+}
+
+// nobody touched the board in time, so the computer plays x
+static void computerMovesFirst(stateMachine_t* machine) {
+    isPlayerX = false;
+}
+
+// entry action of player_turn_waiting_st
+static void startPlayerTurn(stateMachine_t* machine) {
+    isPlayerTurn = true; // set the global indicating that it is the players turn
+}
+
+// during action of evaluate_player_move_st: fetch and store the players move on the touch screen
+static void readPlayerMove(stateMachine_t* machine) {
+    ticTacToeDisplay_touchScreenComputeBoardRowColumn(&playerNextMove.row, &playerNextMove.column);
+    // reset the score to include the most recent computed score
+    currentScore = minimax_computeBoardScore(&gameBoard, isPlayerX);
+}
+
+static bool isGameOver(stateMachine_t* machine) {
+    return minimax_isGameOver(currentScore);
+}
+
+// the move is valid if the square is empty
+static bool isPlayerMoveValid(stateMachine_t* machine) {
+    return !gameBoard.squares[playerNextMove.row][playerNextMove.column];
+}
+
+// update the board with the players move
+static void playPlayerMove(stateMachine_t* machine) {
+    playNextMove();
+}
+
+// during action of computer_turn_st: hand a copy of the board to minimax; the search runs on CPU1 so that
+// this tick returns right away (if the mailbox is busy, try again next tick)
+static void postComputerMove(stateMachine_t* machine) {
+    isPlayerTurn = false; // set the global indicating that it is not the players turn
+    moveJobPosted = false;
+    // a search from before the last restart holds the mailbox until its result is collected and thrown away
+    if(discardPendingResult) {
+        computerMoveJob_t staleJob;
+        if(!amp_collectResult(&staleJob, sizeof(staleJob))) {
+            return;
+        }
+        discardPendingResult = false;
     }
+    computerMoveJob_t job = { .board = gameBoard, .player = !isPlayerX, .level = computerLevel, .randomValue = (uint32_t) rand() };
+    moveJobPosted = amp_postJob(computerMoveJob, &job, sizeof(job));
+}
 
-    // perform state update next
-    switch(currentState) {
-        case init_st:
-            // immediately transition from the init state to the splash screen state
-            currentState = splash_screen_st;
-            break;
-        case splash_screen_st:
-            // during the splash screen state, test to see if the counter has reached its maximum
-            if(splashScreenCounter >= SPLASH_SCREEN_COUNTER_MAX) {
-                // if the timer has expired, clear the splash screen
-                ticTacToeDisplay_clearSplashScreen();
-                ticTacToeDisplay_drawBoardLines(); // draw the game board
-                minimax_initBoard(&gameBoard); // initialize the game board
-                currentState = waiting_first_move_st; // transition to teh waiting for first move state
-            }
-            break;
-        case waiting_first_move_st:
-            // only leave this state for 2 conditions
-            //      1) if the display is touched (indicating the player will take the first move)
-            if(display_isTouched()) {
-                isPlayerX = true; // flag the player as playing x
-                isPlayerTurn = true; // flag the players turn
-                display_clearOldTouchData(); // clear out the old touch data
-                currentState = adc_counter_running_st; // transition to the adc state to determine location of touch
-            //     2) leave this state if the timer has expired (indicating that the computer will take the first turn)
-            } else if(firstMoveCounter >= FIRST_MOVE_COUNTER_MAX) {
-                // if it is the computers turn, set the flag indicating
-                isPlayerX = false;
-                currentState = computer_turn_st; // transition to the computer turn state
-            }
-            break;
-        case adc_counter_running_st:
-            // this state waits the prescribed amount after detecting a touch before determining its location
-            // if the counter expires and the player has stopped touching, return control to the player
-            if(!display_isTouched() && adcCounter >= ADC_COUNTER_MAX) {
-                currentState = player_turn_waiting_st; // leave back to the player turn state
-                // if the counter expires and the player is still touching
-            } else if(display_isTouched() && adcCounter >= ADC_COUNTER_MAX) {
-                // go to the state that will evaluate the players move for validity
-                currentState = evaluate_player_move_st;
-            }
-            break;
-        case player_turn_waiting_st: // waits for the player to make a move on the touch screen
-            // if the player touches
-            if(display_isTouched()) {
-                display_clearOldTouchData();  // clear old touch data
-                currentState = adc_counter_running_st; // go to the adc wait state to determine location
-            }
-            break;
-        case computer_turn_st: // state allowing computer to play
-            // if the game is over
-            if(minimax_isGameOver(currentScore)) {
-                // transition to the end game state
-                currentState = end_game_st;
-            } else {
-                // otherwise return control to the player
-                currentState = player_turn_waiting_st;
-            }
-            break;
-        case evaluate_player_move_st: // this states transition contains logic to determine validity of players move
-            // if the game is over
-            if(minimax_isGameOver(currentScore)) {
-                // transition to the end game state
-                currentState = end_game_st;
-                // if the players move was valid
-            } else if(isPlayerMoveValid()) {
-                // update the board with the players move
-                playNextMove();
-                currentState = computer_turn_st; // return control to the computer
-            } else {
-                // if the players move was invalid, return control to the player without
-                // playing his move
-                currentState = player_turn_waiting_st;
-            }
-            break;
-        case end_game_st:  // wait in the end game state for the game to be reset
-            if(resetGame()) { // if the game is reset, using button -
-                eraseGameBoard(); // erase all the moves on the game board
-                minimax_initBoard(&gameBoard); // re-initialize the game board
-                currentState = waiting_first_move_st; // transition the wiaiting for first move state
-                adcCounter = 0; // reset adc counter
-                splashScreenCounter = 0; // reset splash screen counter
-                firstMoveCounter = 0; // reset first move counter
-                currentScore = 0; // reset current score counter
+static bool isMoveJobPosted(stateMachine_t* machine) {
+    return moveJobPosted;
+}
+
+// entry action of computer_thinking_st (also entered again at every blink)
+static void startThinking(stateMachine_t* machine) {
+    computerMoveReady = false;
+}
+
+// during action of computer_thinking_st: once the search has finished, collect its move and play it
+static void collectComputerMove(stateMachine_t* machine) {
+    computerMoveJob_t job;
+    if(!amp_collectResult(&job, sizeof(job))) {
+        return;
+    }
+    // make sure the thinking indicator is left erased
+    if(thinkingIndicatorOn) {
+        ticTacToeDisplay_drawThinkingIndicator(true);
+        thinkingIndicatorOn = false;
+    }
+    computerNextMove = job.move; // store the move minimax selected
+    playNextMove(); // mark the move on the game board and draw it to the screen
+    currentScore = minimax_computeBoardScore(&gameBoard, !isPlayerX); // update the current score after the move
+    computerMoveReady = true;
+}
+
+static bool isComputerMoveReady(stateMachine_t* machine) {
+    return computerMoveReady;
+}
+
+static bool isGameOverAfterComputerMove(stateMachine_t* machine) {
+    return computerMoveReady && minimax_isGameOver(currentScore);
+}
+
+// blink the thinking indicator so the game visibly keeps running while the search finishes
+static void blinkThinkingIndicator(stateMachine_t* machine) {
+    thinkingIndicatorOn = !thinkingIndicatorOn; // toggle the indicator
+    ticTacToeDisplay_drawThinkingIndicator(!thinkingIndicatorOn); // draw or erase it
+}
+
+// the game is reset with button 0
+static bool isResetPressed(stateMachine_t* machine) {
+    return buttons_read() & BUTTONS_BTN0_MASK;
+}
+
+// erase all the moves and start over with an empty board
+static void restartGame(stateMachine_t* machine) {
+    eraseGameBoard(); // erase all the moves on the game board
+    minimax_initBoard(&gameBoard); // re-initialize the game board
+    currentScore = 0; // reset current score counter
+}
+
+static const stateMachine_state_t states[state_count] = {
+    {"init_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"splash_screen_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"waiting_first_move_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, readLevelSwitches, seedRandomMoves},
+    {"adc_counter_running_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"player_turn_waiting_st", STATEMACHINE_NONE, STATEMACHINE_NONE, startPlayerTurn, NULL, NULL},
+    {"evaluate_player_move_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, readPlayerMove, NULL},
+    {"computer_turn_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, postComputerMove, NULL},
+    {"computer_thinking_st", STATEMACHINE_NONE, STATEMACHINE_NONE, startThinking, collectComputerMove, NULL},
+    {"end_game_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+};
+
+static const stateMachine_transition_t transitions[] = {
+    {init_st, 0, NULL, NULL, splash_screen_st}, // immediately transition from the init state to the splash screen
+    {splash_screen_st, SPLASH_SCREEN_MS, NULL, drawGameBoard, waiting_first_move_st},
+    // a touch means the player takes the first move; if the time runs out the computer does
+    {waiting_first_move_st, 0, isTouched, playerMovesFirst, adc_counter_running_st},
+    {waiting_first_move_st, FIRST_MOVE_MS, NULL, computerMovesFirst, computer_turn_st},
+    // once the adc has settled, evaluate the touch if the player is still touching, otherwise ignore it
+    {adc_counter_running_st, ADC_SETTLE_MS, isTouched, NULL, evaluate_player_move_st},
+    {adc_counter_running_st, ADC_SETTLE_MS, NULL, NULL, player_turn_waiting_st},
+    {player_turn_waiting_st, 0, isTouched, clearOldTouchData, adc_counter_running_st},
+    // an invalid move returns control to the player without playing it
+    {evaluate_player_move_st, 0, isGameOver, NULL, end_game_st},
+    {evaluate_player_move_st, 0, isPlayerMoveValid, playPlayerMove, computer_turn_st},
+    {evaluate_player_move_st, 0, NULL, NULL, player_turn_waiting_st},
+    {computer_turn_st, 0, isMoveJobPosted, NULL, computer_thinking_st},
+    {computer_thinking_st, 0, isGameOverAfterComputerMove, NULL, end_game_st},
+    {computer_thinking_st, 0, isComputerMoveReady, NULL, player_turn_waiting_st},
+    {computer_thinking_st, THINKING_BLINK_MS, NULL, blinkThinkingIndicator, computer_thinking_st},
+    {end_game_st, 0, isResetPressed, restartGame, waiting_first_move_st},
+};
+
+static const stateMachine_definition_t definition = {
+    "ticTacToeControl", states, state_count, transitions, sizeof(transitions) / sizeof(transitions[0]), init_st
+};
+
+static stateMachine_t machine = STATEMACHINE_INIT(&definition, TICTACTOECONTROL_TICK_PERIOD_MS);
+
+// puts the game back at its start (the splash screen), wherever it was
+void ticTacToeControl_init() {
+    // a search still running on CPU1 is not waited for here; its result is thrown away before the next move is posted
+    if(stateMachine_isInState(&machine, computer_thinking_st) && !computerMoveReady) {
+        discardPendingResult = true;
+    }
+    stateMachine_reset(&machine);
+    thinkingIndicatorOn = false;
+    moveJobPosted = false;
+    computerMoveReady = false;
+    currentScore = 0;
+    minimax_initBoard(&gameBoard); // and the game board
+}
+
+// clears the screen and draws it again for the state the game is in: the splash screen, or the board with
+// the moves played so far and the thinking indicator if it is on
+void ticTacToeControl_redraw() {
+    if(stateMachine_isInState(&machine, init_st) || stateMachine_isInState(&machine, splash_screen_st)) {
+        ticTacToeDisplay_drawSplashScreen();
+        return;
+    }
+    display_fillScreen(DISPLAY_BLACK);
+    ticTacToeDisplay_drawBoardLines();
+    // iterate over each square and draw the move in it, if any
+    for(uint32_t i = 0; i < MINIMAX_BOARD_ROWS; i++) {
+        for(uint32_t j = 0; j < MINIMAX_BOARD_COLUMNS; j++) {
+            if(gameBoard.squares[i][j] == MINIMAX_PLAYER_SQUARE) {
+                ticTacToeDisplay_drawX(i, j, false);
+            } else if(gameBoard.squares[i][j] == MINIMAX_OPPONENT_SQUARE) {
+                ticTacToeDisplay_drawO(i, j, false);
             }
-            break;
+        }
+    }
+    if(thinkingIndicatorOn) {
+        ticTacToeDisplay_drawThinkingIndicator(false);
     }
 }
 
+void ticTacToeControl_tick() {
+    stateMachine_tick(&machine);
+}
+
 // helper function that contains logic for putting the next move onto the board
 static void playNextMove() {
     // if it is the players turn
@@ -217,16 +318,11 @@ static void playNextMove() {
     }
 }
 
-// helper function to determine the validity of a move
-static bool isPlayerMoveValid() {
-    // if the square is empty, return true
-    return !gameBoard.squares[playerNextMove.row][playerNextMove.column];
-}
-
-// helper functino to determine if the game should be reset
-static bool resetGame() {
-    // read the buttons and mask to extract the value of button 0
-    return buttons_read() & BUTTONS_BTN0_MASK;
+// runs the minimax search on a copy of the board. Posted to the amp mailbox, so it may run on CPU1 and
+// must only touch the job data.
+static void computerMoveJob(void* data) {
+    computerMoveJob_t* job = (computerMoveJob_t*) data;
+    minimax_computeNextMoveAtLevel(&job->board, job->player, job->level, job->randomValue, &job->move.row, &job->move.column);
 }
 
 // helper function that redraws the dispay as blank squares
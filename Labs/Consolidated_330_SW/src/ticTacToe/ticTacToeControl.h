@@ -8,6 +8,14 @@
 #ifndef TICTACTOECONTROL_H_
 #define TICTACTOECONTROL_H_
 
+#define TICTACTOECONTROL_TICK_PERIOD_MS 50 // Period (ms) at which ticTacToeControl_tick() must be called.
+
+// Puts the game back at its start (the splash screen). If the computer is thinking, waits for its move first.
+void ticTacToeControl_init();
+
+// Clears the screen and draws it again for the state the game is in.
+void ticTacToeControl_redraw();
+
 void ticTacToeControl_tick();
 
 
@@ -14,6 +14,9 @@
 #include "supportFiles/leds.h"
 #include "supportFiles/globalTimer.h"
 #include "supportFiles/interrupts.h"
+#include "supportFiles/amp.h"
+#include "supportFiles/display.h"
+#include "supportFiles/scheduler.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include "ticTacToeControl.h"
@@ -21,15 +24,8 @@
 #include "../intervalTimer/intervalTimer.h"
 
 #define TOTAL_SECONDS 60
-// The formula for computing the load value is based upon the formula from 4.1.1 (calculating timer intervals)
-// in the Cortex-A9 MPCore Technical Reference Manual 4-2.
-// Assuming that the prescaler = 0, the formula for computing the load value based upon the desired period is:
-// load-value = (period * timer-clock) - 1
-#define TIMER_PERIOD 50.0E-3
-#define TIMER_CLOCK_FREQUENCY (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
-#define TIMER_LOAD_VALUE ((TIMER_PERIOD * TIMER_CLOCK_FREQUENCY) - 1.0)
-
-static uint32_t isr_functionCallCount = 0;
+#define MS_PER_SECOND 1000
+#define TIC_TAC_TOE_CONTROL_PRIORITY 0  // Only task, so any priority will do.
 
 int main()
 {
@@ -39,30 +35,31 @@ int main()
     // Init all interrupts (but does not enable the interrupts at the devices).
     // Prints an error message if an internal failure occurs because the argument = true.
     interrupts_initAll(true);
-    interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE);
-    printf("timer load value:%ld\n\r", (int32_t) TIMER_LOAD_VALUE);
-    u32 privateTimerTicksPerSecond = interrupts_getPrivateTimerTicksPerSecond();
-    printf("private timer ticks per second: %ld\n\r", privateTimerTicksPerSecond);
-    interrupts_enableTimerGlobalInts();
+    // Wake CPU1 so the minimax search runs there. If it fails, the search simply runs on CPU0.
+    amp_init(true);
     // Initialization of the clock display is not time-dependent, do it outside of the state machine.
+    display_init();  // Must init all of the software and underlying hardware for LCD.
     ticTacToeDisplay_drawSplashScreen();
-    // Start the private ARM timer running.
-    interrupts_startArmPrivateTimer();
+    // The scheduler programs the private timer from the task periods and starts it.
+    scheduler_init();
+    scheduler_addTask("ticTacToeControl_tick()", ticTacToeControl_tick, TICTACTOECONTROL_TICK_PERIOD_MS,
+                      TIC_TAC_TOE_CONTROL_PRIORITY);
+    scheduler_start();
     // Enable interrupts at the ARM.
     interrupts_enableArmInts();
-    // The while-loop just waits until the total number of timer ticks have occurred before proceeding.
-    while (interrupts_isrInvocationCount() < (TOTAL_SECONDS * privateTimerTicksPerSecond));
-    // All done, now disable interrupts and print out the interrupt counts.
+    // Run the ready ticks and sleep in between until the total time has elapsed.
+    while (scheduler_getMs() < (TOTAL_SECONDS * MS_PER_SECOND))
+        scheduler_runOnce();
+    // All done, now disable interrupts and print out the interrupt count and the tick statistics.
     interrupts_disableArmInts();
     printf("isr invocation count: %ld\n\r", interrupts_isrInvocationCount());
-    printf("internal interrupt count: %ld\n\r", isr_functionCallCount);
+    scheduler_printReport();
     return 0;
 }
 
-// The clockControl_tick() function is now called directly by the timer interrupt service routine.
+// The game tick no longer runs inside the interrupt: the ISR releases it and main() runs it.
 void isr_function() {
-   isr_functionCallCount++; // increase the interrupt count
-    ticTacToeControl_tick(); // tick the game state machine
+    scheduler_isrTick();
 }
 
 
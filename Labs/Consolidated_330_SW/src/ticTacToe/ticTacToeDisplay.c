@@ -40,6 +40,10 @@
 #define SPLASH_LINE_OFFSET 20 // horizontal padding for the splash screen
 #define SPLASH_TEXT_SIZE 2 // text size for the splash screen text
 
+#define THINKING_INDICATOR_X (DISPLAY_WIDTH - 6) // x of the thinking dot, clear of any X or O in the corner square
+#define THINKING_INDICATOR_Y (DISPLAY_HEIGHT - 6) // y of the thinking dot
+#define THINKING_INDICATOR_RADIUS 4 // radius of the thinking dot
+
 // function in charge of preparing the display for drawing
 void ticTacToeDisplay_init() {
     display_init();  // Must init all of the software and underlying hardware for LCD.
@@ -110,8 +114,8 @@ void ticTacToeDisplay_touchScreenComputeBoardRowColumn(uint8_t* row, uint8_t* co
 
 // draws the splash screen to the board
 void ticTacToeDisplay_drawSplashScreen() {
-    display_init();  // Must init all of the software and underlying hardware for LCD.
     display_fillScreen(DISPLAY_BLACK);  // Blank the screen.
+    display_setTextColor(DISPLAY_WHITE); // the last screen may have left another color set
     display_setTextSize(SPLASH_TEXT_SIZE); // set the text to the prescribed size
     display_setCursor(SPLASH_CURSOR_POS_X, SPLASH_CURSOR_POS_Y); // set the cursor at the appropriate position
     display_println("Touch board to play X"); // print the first line of the splash screen
@@ -137,6 +141,12 @@ void ticTacToeDisplay_clearSplashScreen() {
     display_println("      and play O"); // black out the fourth line
 }
 
+// draws (or erases) the dot that blinks while the computer is computing its move
+void ticTacToeDisplay_drawThinkingIndicator(bool erase) {
+    // draw in black to erase, otherwise yellow to match the board
+    display_fillCircle(THINKING_INDICATOR_X, THINKING_INDICATOR_Y, THINKING_INDICATOR_RADIUS, erase ? DISPLAY_BLACK : DISPLAY_YELLOW);
+}
+
 // shows how the display module is usedf
 void ticTacToeDisplay_runTest() {
     bool exitTest = false; // flag for exiting the outer loop (entire program)
@@ -40,5 +40,9 @@ void ticTacToeDisplay_drawSplashScreen();
 
 void ticTacToeDisplay_clearSplashScreen();
 
+// Draws a small dot in the bottom-right corner while the computer is thinking.
+// erase == true means to erase the dot by redrawing it as background.
+void ticTacToeDisplay_drawThinkingIndicator(bool erase);
+
 
 #endif /* TICTACTOEDISPLAY_H_ */
@@ -0,0 +1,22 @@
+/*
+ * ticTacToeGame.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "ticTacToeGame.h"
+#include "ticTacToeControl.h"
+#include <stddef.h>
+
+#define TIC_TAC_TOE_CONTROL_PRIORITY 0  // Only task, so any priority will do.
+
+const game_t ticTacToeGame_descriptor = {
+    "Tic-Tac-Toe",
+    {{"ticTacToeControl_tick()", ticTacToeControl_tick, TICTACTOECONTROL_TICK_PERIOD_MS, TIC_TAC_TOE_CONTROL_PRIORITY}},
+    ticTacToeControl_init,
+    ticTacToeControl_redraw,
+    NULL,
+    NULL,
+    NULL,
+};
@@ -0,0 +1,17 @@
+/*
+ * ticTacToeGame.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TICTACTOEGAME_H_
+#define TICTACTOEGAME_H_
+
+#include "supportFiles/game.h"
+
+// Tic-tac-toe as a game for the launcher. The launcher brings up CPU1 (amp_init()) for the minimax search.
+// A search left running by a suspended game finishes meanwhile; its move is played when the game comes back.
+extern const game_t ticTacToeGame_descriptor;
+
+#endif /* TICTACTOEGAME_H_ */
@@ -9,10 +9,12 @@
 #include "stdlib.h"
 #include "supportFiles/display.h"
 #include "wamDisplay.h"
+#include "supportFiles/stateMachine.h"
+#include <stddef.h>
 #include <stdio.h>
 
-// maximum time that the SM wills stay in adc counter running state waiting for the adc to settle
-#define ADC_COUNTER_MAX ( 50 / msPerTick )
+// time that the SM stays in the adc counter running state waiting for the adc to settle
+#define ADC_SETTLE_MS 50
 #define STARTING_MAX_ACTIVE_MOLE_COUNT 1
 #define RAND_MS_UPPER_BOUND 2001
 #define RAND_MS_LOWER_BOUND 500
@@ -22,24 +24,79 @@ static uint16_t msPerTick; // global holding the ms per tick so that timing can
 static uint16_t maxActiveMoleCount;
 static uint32_t randomSeed; // random seed imported from the main so that the game is unpredictable
 static uint16_t maxMissCount; // maximum number of misses a player can incur before losing the game
-static uint16_t adcCounter; // counter keeping track of how long the SM has been in the adc state
 static int16_t lastTouchX, lastTouchY; // two globals that contained the last touched coordinates
 static uint8_t lastTouchZ; // global containing the last touched pressure
 
-typedef enum wam_state {
+enum {
     init_st, // dummy state that the SM starts out in, transitions immediately to wiating for touch state
     waiting_for_touch_st, // the SM stays in this state waiting for user input
     adc_counter_running_st, // SM stays in this state for 50 ms waiting for the adc to settle
-    end_st // enters this state when the player has lost
-} wam_state;
+    end_st, // enters this state when the player has lost
+    state_count
+};
+
+// during action of waiting_for_touch_st: update the moles, and activate one if too few are
+static void updateAndActivateMoles(stateMachine_t* machine) {
+    wamDisplay_updateAllMoleTickCounts(); // each tick, update the mole counts
+    // if the number of random moles falls below the correct amount
+    if(wamDisplay_getActiveMoleCount() < maxActiveMoleCount) {
+        wamDisplay_activateRandomMole(); // tell the display to initialize a random mole
+    }
+}
+
+// during action of adc_counter_running_st: the moles keep moving while the adc settles
+static void updateMoles(stateMachine_t* machine) {
+    wamDisplay_updateAllMoleTickCounts();
+}
 
-// start off the game at the init state
-static wam_state currentState = init_st;
+static bool isTouched(stateMachine_t* machine) {
+    return display_isTouched();
+}
+
+// when the display is touched, clear the old touch data
+static void clearOldTouchData(stateMachine_t* machine) {
+    display_clearOldTouchData();
+}
+
+// the player has missed the maximum amount and loses
+static bool isOutOfMisses(stateMachine_t* machine) {
+    return wamDisplay_getMissScore() >= maxMissCount;
+}
+
+// the adc has settled: get the touch point from the display module and whack a mole with it
+static void whack(stateMachine_t* machine) {
+    display_getTouchedPoint(&lastTouchX, &lastTouchY, &lastTouchZ);
+    wamDisplay_point_t touch = { .x = lastTouchX, .y = lastTouchY }; // store the touch point in a point struct
+    wamDisplay_whackMole(&touch);
+}
+
+static const stateMachine_state_t states[state_count] = {
+    {"init_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+    {"waiting_for_touch_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, updateAndActivateMoles, NULL},
+    {"adc_counter_running_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, updateMoles, NULL},
+    {"end_st", STATEMACHINE_NONE, STATEMACHINE_NONE, NULL, NULL, NULL},
+};
+
+static const stateMachine_transition_t transitions[] = {
+    {init_st, 0, NULL, NULL, waiting_for_touch_st}, // immediately start waiting for touches
+    // stay in the waiting for touch state until either the user touches, attmempting to whack a mole...
+    {waiting_for_touch_st, 0, isTouched, clearOldTouchData, adc_counter_running_st},
+    // ...or misses the maximum amount and loses
+    {waiting_for_touch_st, 0, isOutOfMisses, NULL, end_st},
+    {adc_counter_running_st, ADC_SETTLE_MS, NULL, whack, waiting_for_touch_st},
+    // no transitions for the end state, stay here until module is reinitialized
+};
+
+static const stateMachine_definition_t definition = {
+    "wamControl", states, state_count, transitions, sizeof(transitions) / sizeof(transitions[0]), init_st
+};
+
+static stateMachine_t machine = STATEMACHINE_INIT(&definition, WAMCONTROL_TICK_PERIOD_MS);
 
 // Call this before using any wamControl_ functions.
 void wamControl_init() {
     // any time the module is reinitialized, set the SM to the init state
-    currentState = init_st;
+    stateMachine_reset(&machine);
     maxActiveMoleCount = STARTING_MAX_ACTIVE_MOLE_COUNT; // and reset the maxActive mole count to 1
 }
 
@@ -47,6 +104,7 @@ void wamControl_init() {
 // This information makes it possible to set the awake and sleep time of moles in ms, not ticks.
 void wamControl_setMsPerTick(uint16_t msPerTickParam) {
     msPerTick = msPerTickParam;
+    stateMachine_setMsPerTick(&machine, msPerTickParam); // and the adc settling time
 }
 
 // This returns the time consumed by each tick of the controlling state machine.
@@ -56,58 +114,7 @@ uint16_t wamControl_getMsPerTick() {
 
 // Standard tick function.
 void wamControl_tick() {
-    // state actions
-    switch(currentState) {
-    case init_st: // no state actions for the init state
-        break;
-    case waiting_for_touch_st: // state actions for the waiting for touch state
-        wamDisplay_updateAllMoleTickCounts(); // each tick, update the mole counts
-        // if the number of random moles falls below the correct amount
-        if(wamDisplay_getActiveMoleCount() < maxActiveMoleCount) {
-            wamDisplay_activateRandomMole(); // tell the display to initialize a random mole
-        }
-        break;
-    case adc_counter_running_st:
-        wamDisplay_updateAllMoleTickCounts(); // each tick, update the mole counts
-        adcCounter++; // increase the adc counter
-        break;
-    case end_st: // no state actions for the end state
-        break;
-    }
-
-    // state transitions
-    switch(currentState) {
-    case init_st: // in the init state, immediately transition to the waiting for touch state
-        currentState = waiting_for_touch_st;
-        break;
-    case waiting_for_touch_st: // state transitions for the waiting for touch state
-        // stay in the waiting for touch state until either the user touches, attmempting to whack a mole
-        if(display_isTouched()) {
-            // when the display is touched, clear the old touch data
-            display_clearOldTouchData();
-            // and transition to the adc state
-            currentState = adc_counter_running_st;
-        // or the misses the maximum amount and loses
-        } else if(wamDisplay_getMissScore() >= maxMissCount) {
-            currentState = end_st; // transition to end state if the user loses
-        }
-        break;
-    case adc_counter_running_st: // state transitions for the adc counter running state
-        // stay in this state until the counter expires
-        if(adcCounter >= ADC_COUNTER_MAX) {
-            // once the counter expires, clear the counter
-            adcCounter = 0;
-            // get the touch point from the display module
-            display_getTouchedPoint(&lastTouchX, &lastTouchY, &lastTouchZ);
-            // store the touch point in a point struct
-            wamDisplay_point_t touch = { .x = lastTouchX, .y = lastTouchY };
-            wamDisplay_whackMole(&touch); // whack a mole with the touch struct
-            currentState = waiting_for_touch_st; // transition back to waiting state
-        }
-        break;
-    case end_st: // no transitions for the end state, stay here until module is reinitialized
-        break;
-    }
+    stateMachine_tick(&machine);
 }
 
 // Returns a random value that indicates how long the mole should sleep before awaking.
@@ -144,5 +151,5 @@ void wamControl_setMaxMissCount(uint16_t missCount) {
 // Use this function to see if the game is finished.
 bool wamControl_isGameOver() {
     // if the game is in the end state, that means that the game is over
-    return currentState == end_st;
+    return stateMachine_isInState(&machine, end_st);
 }
@@ -11,6 +11,8 @@
 #include "wamDisplay.h"
 #include <stdint.h>
 
+#define WAMCONTROL_TICK_PERIOD_MS 50 // Period (ms) at which wamControl_tick() is scheduled.
+
 // Call this before using any wamControl_ functions.
 void wamControl_init();
 
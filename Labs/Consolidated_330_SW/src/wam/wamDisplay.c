@@ -13,6 +13,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include "supportFiles/utils.h"
+#include "supportFiles/timerWheel.h"
+#include "wamLayout.h"
+#include "wamSprites.h"
+#include "supportFiles/numericField.h"
 
 #define MOLE_BACKGROUND_MARGIN_X 10 // spacing between the mole board and the edge of the screen
 #define MOLE_BACKGROUND_MARGIN_Y_TOP 10 // spacing between the mole board and the top of the screen
@@ -20,56 +24,23 @@
 #define MOLE_BACKGROUND_WIDTH (DISPLAY_WIDTH - 2 * MOLE_BACKGROUND_MARGIN_X) // width of the mole board
 // height of the mole board
 #define MOLE_BACKGROUND_HEIGHT (DISPLAY_HEIGHT - MOLE_BACKGROUND_MARGIN_Y_BOTTOM - MOLE_BACKGROUND_MARGIN_Y_TOP)
-#define HOLE_RADIUS 25 // radius of a hole / mole on the board
-#define MAX_NUMBER_OF_MOLES 9 // highest possible number of holes for the mole board
-#define MOLE_NUM_SIX 6 // middle option for number of holes for the mole board
-#define MOLE_NUM_NINE 9 // highest possible number of holes for the mole board
-#define MOLE_NUM_FOUR 4 // lowest possible number of holes for the mole board
-#define ERASE true // flag to draw a mole as black to erase
-#define NO_ERASE false // flag to draw a mole as its true color
-
-// the following 8 constants define grid lines accross the board for touch reasons
-#define MOLE_BACKGROUND_X0 MOLE_BACKGROUND_MARGIN_X // leftmost vertical gridline
-#define MOLE_BACKGROUND_X1 (MOLE_BACKGROUND_MARGIN_X + MOLE_BACKGROUND_WIDTH / 3) // 2nd from the left vertical grid line
-#define MOLE_BACKGROUND_X2 (MOLE_BACKGROUND_MARGIN_X + 2 * MOLE_BACKGROUND_WIDTH / 3) // 2nd from the right vertical grid line
-#define MOLE_BACKGROUND_X3 (MOLE_BACKGROUND_MARGIN_X + MOLE_BACKGROUND_WIDTH) // rightomst vertival grid line
-
-#define MOLE_BACKGROUND_Y0 MOLE_BACKGROUND_MARGIN_Y_TOP // top horizontal grid line
-#define MOLE_BACKGROUND_Y1 (MOLE_BACKGROUND_MARGIN_Y_TOP + MOLE_BACKGROUND_HEIGHT / 3) // 2nd from the top horizontal grid line
-#define MOLE_BACKGROUND_Y2 (MOLE_BACKGROUND_MARGIN_Y_TOP + 2 * MOLE_BACKGROUND_HEIGHT / 3) // 2nd from the bottom horizontal grid line
-#define MOLE_BACKGROUND_Y3 (MOLE_BACKGROUND_MARGIN_Y_TOP + MOLE_BACKGROUND_HEIGHT) // bottom horizontal grid line
-
-// the following 9 constants define different indecies in the array of moles
-// used for relating touch regions to moles
-#define MOLE_INDEX_NOT_A_MOLE (-1) // this indicates that a touch occured off of the game board
-#define MOLE_INDEX_ZERO 0 // 1st touch region / mole
-#define MOLE_INDEX_ONE 1 // 2nd touch region / mole
-#define MOLE_INDEX_TWO 2 // 3rd touch region / mole
-#define MOLE_INDEX_THREE 3 // 4th touch region / mole
-#define MOLE_INDEX_FOUR 4 // 5th touch region / mole
-#define MOLE_INDEX_FIVE 5 // 6th touch region / mole
-#define MOLE_INDEX_SIX 6 // 7th touch region / mole
-#define MOLE_INDEX_SEVEN 7 // 8th touch region / mole
-#define MOLE_INDEX_EIGHT 8 // 9th touch region / mole
-
-// maximum number of trues that the 'activate random mole' will try to find an inactive mole space
-// to activate
-#define MAX_NUMBER_RAND_TRIES 50
+#define MAX_NUMBER_OF_MOLES WAMLAYOUT_MAX_HOLES // highest possible number of holes for the mole board
+#define DEFAULT_ROWS 3 // board used when the selected grid does not fit: 3 rows...
+#define DEFAULT_COLUMNS 3 // ...of 3 moles
+#define SMALL_BOARD_ROWS 2 // the 4 and 6 mole boards have 2 rows (of 2 and 3)
+#define SMALL_BOARD_COLUMNS 2 // the 4 mole board has 2 columns
+#define BOARD_COLOR DISPLAY_GREEN // color of the board around the holes
+#define MOLE_INDEX_NOT_A_MOLE WAMLAYOUT_NOT_A_HOLE // this indicates that a touch occured off of the game board
+
+// the free-hole and animating-mole bitmaps keep one bit per hole in 32-bit words
+#define MOLE_BITMAP_WORD_BITS 32
+#define MOLE_BITMAP_WORD_COUNT ((MAX_NUMBER_OF_MOLES + MOLE_BITMAP_WORD_BITS - 1) / MOLE_BITMAP_WORD_BITS)
+#define MOLE_BITMAP_HALF_WORD_BITS (MOLE_BITMAP_WORD_BITS / 2) // first step of the bit select
 // since the hits to advance a level increase with each level, this is the starting number
 #define STARTING_HITS_PER_LEVEL 7
 #define HITS_PER_LEVEL_INC_FACTOR 2 // the rate at which the hits per level increases each round
 #define INCREMENT_BY_ONE 1 // for incrementing the level by one each passing of a level
 
-// coordinate definitions for each of the origins of the nine holes, the final board is a three by three
-// board, thus 3 X and 3 y points yield 9 origin points possible on the game board containing 4, 6, or
-// 9 moles
-#define X1 70
-#define X2 160
-#define X3 250
-#define Y1 50
-#define Y2 110
-#define Y3 170
-
 // splash screen cursor positions and text sizes
 #define SPLASH_CURSOR_X1 50 // various starting position for the splash screen cursors
 #define SPLASH_CURSOR_Y1 70 // cursor for the splash screen 2nd line
@@ -100,172 +71,166 @@
 #define SCORE_CURSOR_X4 58
 #define SCORE_CURSOR_X5 160
 #define SCORE_CURSOR_X6 272
-#define SCORE_MESSAGE_SIZE 10
-
-
-/********************** typedefs **********************/
-// This keeps track of all mole information.
-typedef struct {
-        wamDisplay_point_t origin;  // This is the origin of the hole for this mole.
-        // A mole is active if either of the tick counts are non-zero. The mole is dormant otherwise.
-        // During operation, non-zero tick counts are decremented at a regular rate by the control state machine.
-        // The mole remains in his hole until ticksUntilAwake decrements to zero and then he pops out.
-        // The mole remains popped out of his hole until ticksUntilDormant decrements to zero.
-        // Once ticksUntilDomant goes to zero, the mole hides in his hole and remains dormant until activated again.
-        wamDisplay_moleTickCount_t ticksUntilAwake;  // Mole will wake up (pop out of hole) when this goes from 1 -> 0.
-        wamDisplay_moleTickCount_t ticksUntilDormant; // Mole will go dormant (back in hole) this goes 1 -> 0.
-} wamDisplay_moleInfo_t;
+#define SCORE_FIELD_DIGITS 3 // each number in the score bar has room for 3 digits before the next label
+
 
 // *** GLOBALS ***
-    // This will contain pointers to all of the mole info records.
-    // This will ultimately be treated as an array of pointers.
-static wamDisplay_moleInfo_t** wamDisplay_moleInfo;
-static wamDisplay_moleCount_e currentGameMoleCount; // a data type holding an enum value representing the moles in the game
+// Mole records, kept as a structure of arrays in a static pool so that restarting a game allocates
+// nothing. Index i of each array belongs to mole i.
+// Each mole has one timer in moleWheel, which the control state machine advances once per tick, so a
+// tick only touches the moles whose timer expires on it rather than counting every mole down.
+// A mole is active while its timer is scheduled. The mole is dormant otherwise.
+// An activated mole stays in his hole until his timer expires and then he pops out; the timer is then
+// rescheduled for moleAwakeTicks and the mole stays popped out until it expires again.
+// Then the mole hides in his hole and remains dormant until activated again.
+// freeHoles has a bit set for every dormant mole, so a random dormant mole is picked in one step.
+// Each mole also has a sprite player for his pop-up, hide and whack animations (wamSprites.c);
+// animatingMoles has a bit set for each one playing, so a tick only steps the moles that are moving.
+static wamDisplay_moleTickCount_t moleAwakeTicks[MAX_NUMBER_OF_MOLES]; // how long the mole stays out once he pops out
+static bool moleIsAwake[MAX_NUMBER_OF_MOLES]; // true while the mole is popped out (visible)
+static timerWheel_node_t moleTimers[MAX_NUMBER_OF_MOLES]; // the wheel's record of each mole's timer
+static timerWheel_t moleWheel; // wake and sleep deadlines of the active moles
+static uint32_t freeHoles[MOLE_BITMAP_WORD_COUNT]; // bit i is set while mole i is dormant
+static sprite_player_t molePlayers[MAX_NUMBER_OF_MOLES]; // the animation on each hole
+static uint32_t animatingMoles[MOLE_BITMAP_WORD_COUNT]; // bit i is set while mole i's animation plays
+static bool spritesBuiltFlag; // false if the sprites could not be rendered, moles are plain discs then
+static uint8_t selectedRows = DEFAULT_ROWS; // grid selected for the next game
+static uint8_t selectedColumns = DEFAULT_COLUMNS;
 static uint16_t hitScore; // number of hits a user has made
 static uint16_t missScore; // number of misses a user has incurred
 static uint8_t currentLevel; // current level that the user has reached, starts at 0
 static uint8_t activeMoleCount; // number of moles currently non-dormant
 
-// the following 3 data members store the most recently drawn score information, so that it can be
-// erased once the score information changes
-static uint16_t lastDrawnHitScore;
-static uint16_t lastDrawnMissScore;
-static uint8_t lastDrawnLevel;
+// the following 3 fields draw the numbers in the score bar; each remembers what it shows so that an
+// update only repaints the digits that changed
+static numericField_t hitScoreField;
+static numericField_t missScoreField;
+static numericField_t levelField;
 // private data memeber that keeps track of how many hits are required to level up from the current level
 static uint16_t hitsPerLevel = STARTING_HITS_PER_LEVEL;
 void wamDisplay_drawScoreScreen(); // function prototype so that it can be referenced below
 
 // private helper data
 static uint8_t numberOfMoles; // number of moles being used in the game
-    // coordinate array
-// the following array of originPoints are in an order that supports dynamic rendering
-// of the board based on the switches.  Indecies 0 through 3 correspond to 4 corners of a board
-// that has only 4 moles.  Indecies 4 and 5 correspond to the middle top and middle bottom origin
-// points that fill in the spaces and leave the board with 2 rows of 3, or a 6 board game set up.
-// Indecies 6 through 8 correspond to the middle row of points, filling in the board and creating
-// a 9 mole set up
-static wamDisplay_point_t originPoints[MAX_NUMBER_OF_MOLES] = {
-        { .x = X1, .y = Y1 },
-        { .x = X3, .y = Y1 },
-        { .x = X1, .y = Y3 },
-        { .x = X3, .y = Y3 },
-        { .x = X2, .y = Y1 },
-        { .x = X2, .y = Y3 },
-        { .x = X1, .y = Y2 },
-        { .x = X2, .y = Y2 },
-        { .x = X3, .y = Y2 },
-};
-
-
-// Allocates the memory for wamDisplay_moleInfo_t records.
-// Computes the origin for each mole assuming a simple row-column layout:
-// 9 moles: 3 rows, 3 columns, 6 moles: 2 rows, 3 columns, 4 moles: 2 rows, 2 columns
-// Also inits the tick counts for awake and dormant.
-static void wamDisplay_computeMoleInfo() {
-    wamDisplay_moleInfo = (wamDisplay_moleInfo_t**) malloc(numberOfMoles * sizeof(wamDisplay_moleInfo_t*));
-    // iterate through all of the moles in use for this game
+
+// Resets the mole pool for a new game: makes every mole dormant.
+// Only the first numberOfMoles slots are used; the rest stay dormant and never show up as free holes.
+// The hole origins come from the layout (wamLayout.c).
+static void wamDisplay_resetMolePool() {
+    memset(moleIsAwake, 0, sizeof(moleIsAwake)); // all moles start dormant
+    timerWheel_init(&moleWheel, moleTimers, MAX_NUMBER_OF_MOLES); // with no timers running
+    memset(freeHoles, 0, sizeof(freeHoles));
+    memset(animatingMoles, 0, sizeof(animatingMoles)); // nothing is moving
     for(uint16_t i = 0; i < numberOfMoles; i++) {
-        // allocate space for the mole info pointer
-        wamDisplay_moleInfo[i] = (wamDisplay_moleInfo_t*) malloc(sizeof(wamDisplay_moleInfo_t));
-        // set the origin to the correct point
-        wamDisplay_moleInfo[i]->origin = originPoints[i];
-        // init the tick counts to 0
-        wamDisplay_moleInfo[i]->ticksUntilDormant = 0;
-        wamDisplay_moleInfo[i]->ticksUntilAwake = 0;
+        freeHoles[i / MOLE_BITMAP_WORD_BITS] |= 1UL << (i % MOLE_BITMAP_WORD_BITS); // every hole in the game is free
     }
+    activeMoleCount = 0; // so nothing is counted as active
 }
 
-// private helper function that translates coordinate touch points to a corresponding mole on the game board
-static uint8_t computeMoleIndexFromTouchCoord(uint16_t x, uint16_t y) {
-    // first check to make sure that the touch was on the board
-    if(x < MOLE_BACKGROUND_X0 || x > MOLE_BACKGROUND_X3 || y < MOLE_BACKGROUND_Y0 || y > MOLE_BACKGROUND_Y3) {
-        return MOLE_INDEX_NOT_A_MOLE; // if it was not, return the corresponding mole index (not a mole)
+// Marks a hole as free (dormant mole) or taken (active mole) in the free-hole bitmap.
+static void wamDisplay_setHoleFree(wamDisplay_moleIndex_t index, bool free) {
+    uint32_t bit = 1UL << (index % MOLE_BITMAP_WORD_BITS);
+    if(free) {
+        freeHoles[index / MOLE_BITMAP_WORD_BITS] |= bit;
     }
-    // 3 columns farthest to the left
-    if(x < MOLE_BACKGROUND_X1) {
-        // next, the y grid lines are checked against in descending order
-        if(y < MOLE_BACKGROUND_Y1) { // highest y line
-            return MOLE_INDEX_ZERO; // return the mole 0 index corresponding to this grid square
-        }
-        if(y < MOLE_BACKGROUND_Y2) { // middle y line
-            return MOLE_INDEX_SIX; // return the mole 6 index corresponding to this grid square
-        }
-        if(y < MOLE_BACKGROUND_Y3) { // lowest y line
-            return MOLE_INDEX_TWO; // return the mole 2 index corresponding to this grid square
-        }
+    else {
+        freeHoles[index / MOLE_BITMAP_WORD_BITS] &= ~bit;
     }
+}
 
-    // 3 columns in the middle
-    if(x < MOLE_BACKGROUND_X2) {
-        // next, the y grid lines are checked against in descending order
-        if(y < MOLE_BACKGROUND_Y1) { // highest y line
-            return MOLE_INDEX_FOUR; // return the mole 4 index corresponding to this grid square
-        }
-        if(y < MOLE_BACKGROUND_Y2) { // middle y line
-            return MOLE_INDEX_SEVEN; // return the mole 7 index corresponding to this grid square
-        }
-        if(y < MOLE_BACKGROUND_Y3) { // lowest y line
-            return MOLE_INDEX_FIVE; // return the mole 5 index corresponding to this grid square
-        }
+// Returns the number of free holes.
+static uint16_t wamDisplay_countFreeHoles() {
+    uint16_t count = 0;
+    for(uint16_t w = 0; w < MOLE_BITMAP_WORD_COUNT; w++) {
+        count += __builtin_popcount(freeHoles[w]);
     }
+    return count;
+}
 
-    // 3 columns to the right
-    if(x < MOLE_BACKGROUND_X3) {
-        // next, the y grid lines are checked against in descending order
-        if(y < MOLE_BACKGROUND_Y1) { // highest y line
-            return MOLE_INDEX_ONE; // return the mole 1 index corresponding to this grid square
+// Returns the index of the n-th free hole (counting from 0), n must be less than the free-hole count.
+// Skips whole words by popcount, then halves the word until the bit is found.
+static wamDisplay_moleIndex_t wamDisplay_selectFreeHole(uint16_t n) {
+    for(uint16_t w = 0; w < MOLE_BITMAP_WORD_COUNT; w++) {
+        uint32_t bits = freeHoles[w];
+        uint16_t count = __builtin_popcount(bits);
+        if(n >= count) {
+            n -= count; // the hole is in a later word
+            continue;
         }
-        if(y < MOLE_BACKGROUND_Y2) { // middle y line
-            return MOLE_INDEX_EIGHT; // return the mole 8 index corresponding to this grid square
-        }
-        if(y < MOLE_BACKGROUND_Y3) { // lowest y line
-            return MOLE_INDEX_THREE; // return the mole 3 index corresponding to this grid square
+        uint16_t index = w * MOLE_BITMAP_WORD_BITS;
+        for(uint16_t width = MOLE_BITMAP_HALF_WORD_BITS; width; width /= 2) {
+            uint16_t lowCount = __builtin_popcount(bits & ((1UL << width) - 1)); // free holes in the low half
+            if(n >= lowCount) {
+                n -= lowCount; // the hole is in the high half
+                bits >>= width;
+                index += width;
+            }
         }
+        return index;
     }
+    return MOLE_INDEX_NOT_A_MOLE;
 }
 
 // Call this before using any wamDisplay_ functions.
 void wamDisplay_init() {
-    // init the display by translating the currentGameMoleCount enum variable, to a real
-    // usable number
-    switch(currentGameMoleCount) {
-        case wamDisplay_moleCount_4:
-            // if the variable had the value of the four enum, save the number four to a different variable
-            numberOfMoles = MOLE_NUM_FOUR;
-            break;
-        case wamDisplay_moleCount_6:
-            // if the variable had the value of the six enum, save the number six to a different variable
-            numberOfMoles = MOLE_NUM_SIX;
-            break;
-        case wamDisplay_moleCount_9:
-            // if the variable had the value of the nine enum, save the number nine to a different variable
-            numberOfMoles = MOLE_NUM_NINE;
-            break;
-        default:
-            numberOfMoles = 0; // should not arrive hear, assign 0 just in case
-            break;
+    // generate the board for the selected grid: hole origins, the touch index and the hole sprite
+    if(!wamLayout_generate(selectedRows, selectedColumns, MOLE_BACKGROUND_MARGIN_X, MOLE_BACKGROUND_MARGIN_Y_TOP,
+            MOLE_BACKGROUND_WIDTH, MOLE_BACKGROUND_HEIGHT)) {
+        // the grid does not fit, fall back to the standard 3 x 3 board
+        wamLayout_generate(DEFAULT_ROWS, DEFAULT_COLUMNS, MOLE_BACKGROUND_MARGIN_X, MOLE_BACKGROUND_MARGIN_Y_TOP,
+                MOLE_BACKGROUND_WIDTH, MOLE_BACKGROUND_HEIGHT);
+    }
+    numberOfMoles = wamLayout_getHoleCount(); // one mole per hole
+    spritesBuiltFlag = wamSprites_build(wamLayout_getHoleRadius()); // render the mole animations for this hole size
+    if(!spritesBuiltFlag) {
+        printf("wamDisplay_init: mole sprites do not fit, drawing plain moles.\n\r");
     }
-    wamDisplay_computeMoleInfo(); // compute the mole info records based on the newly found number of moles
+    wamDisplay_resetMolePool(); // reset the mole records for the newly found number of moles
 }
 
 // Draw the game display with a background and mole holes.
 void wamDisplay_drawMoleBoard() {
     display_fillScreen(DISPLAY_BLACK); // first clear the screen
     display_fillRect(MOLE_BACKGROUND_MARGIN_X, MOLE_BACKGROUND_MARGIN_Y_TOP, MOLE_BACKGROUND_WIDTH,
-            MOLE_BACKGROUND_HEIGHT, DISPLAY_GREEN); // next draw the green background for the board
+            MOLE_BACKGROUND_HEIGHT, BOARD_COLOR); // next draw the green background for the board
     for(uint16_t i = 0; i < numberOfMoles; i++) {
-        // iterate through all of the moles in use for this game and draw circles at their origins
-        display_fillCircle(wamDisplay_moleInfo[i]->origin.x, wamDisplay_moleInfo[i]->origin.y, HOLE_RADIUS, DISPLAY_BLACK);
+        // iterate through all of the moles in use for this game and draw their holes
+        wamDisplay_point_t origin = wamLayout_getHoleOrigin(i);
+        int16_t radius = wamLayout_getHoleRadius();
+        if(spritesBuiltFlag) {
+            sprite_draw(wamSprites_getHoleFrame(), origin.x - radius, origin.y - radius);
+        }
+        else {
+            wamLayout_drawHole(i, DISPLAY_BLACK);
+        }
+        // each mole's animations are drawn over the hole just drawn
+        sprite_initPlayer(&molePlayers[i], origin.x - radius, origin.y - radius, wamSprites_getHoleFrame(), BOARD_COLOR);
     }
+    memset(animatingMoles, 0, sizeof(animatingMoles)); // nothing is moving on a fresh board
     wamDisplay_drawScoreScreen(); // draw the score screen at the bottom
 }
 
-// private helper funciton for drawing one mole, accepts an index - referring to the position of the mole
-// in the mole info records array, and a bool erase for indicating if the mole should be drawn in red (asleep)
-// or in black
-static void drawMole(uint8_t index, bool erase) {
-    uint16_t color = erase ? DISPLAY_BLACK : DISPLAY_RED;
-    display_fillCircle(wamDisplay_moleInfo[index]->origin.x, wamDisplay_moleInfo[index]->origin.y, HOLE_RADIUS, color);
+// private helper function that starts an animation on one mole, accepts an index - referring to the position
+// of the mole in the mole pool. The first frame is drawn now, the rest on the following ticks.
+static void animateMole(uint8_t index, wamSprites_animation_e animation) {
+    if(!spritesBuiltFlag) {
+        // no sprites: just draw the mole in red when he pops up and in black when he goes away
+        wamLayout_drawHole(index, animation == wamSprites_popUp_e ? DISPLAY_RED : DISPLAY_BLACK);
+        return;
+    }
+    sprite_play(&molePlayers[index], wamSprites_getAnimation(animation));
+    animatingMoles[index / MOLE_BITMAP_WORD_BITS] |= 1UL << (index % MOLE_BITMAP_WORD_BITS);
+}
+
+// Draws the board again as it was, e.g., when the game comes back after being suspended: the holes,
+// the scores, and each awake mole popping out again.
+void wamDisplay_redrawMoleBoard() {
+    wamDisplay_drawMoleBoard(); // every hole comes back empty
+    for(uint16_t i = 0; i < numberOfMoles; i++) {
+        if(moleIsAwake[i]) {
+            animateMole(i, wamSprites_popUp_e); // then the moles that were out pop back out
+        }
+    }
 }
 
 // Draw the initial splash (instruction) screen.
@@ -318,70 +283,62 @@ void wamDisplay_drawScoreScreen() {
 
     display_setCursor(SCORE_CURSOR_X1, SCORE_CURSOR_Y); // set the cursor to the appropriate position
     display_print("Hit:");
-    display_setCursor(SCORE_CURSOR_X4, SCORE_CURSOR_Y);
-    char hitsMessage[SCORE_MESSAGE_SIZE]; // store the message in this string
-    sprintf(hitsMessage, "%d", hitScore); // create the message string
-    display_print(hitsMessage);
-
     display_setCursor(SCORE_CURSOR_X2, SCORE_CURSOR_Y); // set the cursor to the appropriate position
     display_print("Miss:");
-    display_setCursor(SCORE_CURSOR_X5, SCORE_CURSOR_Y);
-    char missesMessage[SCORE_MESSAGE_SIZE]; // store the message in this string
-    sprintf(missesMessage, "%d", missScore); // create the message string
-    display_print(missesMessage);
-
     display_setCursor(SCORE_CURSOR_X3, SCORE_CURSOR_Y); // set the cursor to the appropriate position
     display_print("Level:");
-    display_setCursor(SCORE_CURSOR_X6, SCORE_CURSOR_Y);
-    char levelMessage[SCORE_MESSAGE_SIZE]; // store the message in this string
-    sprintf(levelMessage, "%d", currentLevel); // create the message string
-    display_print(levelMessage);
 
-    // store these values so that when erasing, the previously drawn value is already stored so that it
-    // can be drawn over in black
-    lastDrawnHitScore = hitScore;
-    lastDrawnMissScore = missScore;
-    lastDrawnLevel = currentLevel;
+    // the numbers go in fixed-width fields after their labels, drawn white on the black background
+    numericField_init(&hitScoreField, SCORE_CURSOR_X4, SCORE_CURSOR_Y, SCORE_FIELD_DIGITS, TEXT_SIZE_MEDIUM,
+            DISPLAY_WHITE, DISPLAY_BLACK, numericField_alignLeft_e);
+    numericField_init(&missScoreField, SCORE_CURSOR_X5, SCORE_CURSOR_Y, SCORE_FIELD_DIGITS, TEXT_SIZE_MEDIUM,
+            DISPLAY_WHITE, DISPLAY_BLACK, numericField_alignLeft_e);
+    numericField_init(&levelField, SCORE_CURSOR_X6, SCORE_CURSOR_Y, SCORE_FIELD_DIGITS, TEXT_SIZE_MEDIUM,
+            DISPLAY_WHITE, DISPLAY_BLACK, numericField_alignLeft_e);
+    numericField_draw(&hitScoreField, hitScore);
+    numericField_draw(&missScoreField, missScore);
+    numericField_draw(&levelField, currentLevel);
 }
 
+// redraws the digits of the hit score that changed
 static void drawNewHitScore() {
-    display_setCursor(SCORE_CURSOR_X4, SCORE_CURSOR_Y); // set the cursor to the appropriate position
-    display_setTextColor(DISPLAY_BLACK); // set the color to black to match the background
-    display_print(lastDrawnHitScore); // draw the last printed score in black to erase it
-
-    display_setCursor(SCORE_CURSOR_X4, SCORE_CURSOR_Y); // reset the cursor
-    display_setTextColor(DISPLAY_WHITE); // set the color to be white for text
-    display_print(hitScore); // print the hit score
-    lastDrawnHitScore = hitScore; // reset the last drawn hit score to what was just drawn
+    numericField_update(&hitScoreField, hitScore);
 }
 
+// redraws the digits of the miss score that changed
 static void drawNewMissScore() {
-    display_setCursor(SCORE_CURSOR_X5, SCORE_CURSOR_Y); // set the cursor to the appropriate position
-    display_setTextColor(DISPLAY_BLACK); // set the color to black to match the background
-    display_print(lastDrawnMissScore); // redraw the last drawn score in black to erase it
-
-    display_setCursor(SCORE_CURSOR_X5, SCORE_CURSOR_Y); // set the cursor to the appropriate position
-    display_setTextColor(DISPLAY_WHITE); // set the cursor to white for text
-    display_print(missScore); // draw the miss score
-    lastDrawnMissScore = missScore; // reset the last drawn score to what was just drawn
+    numericField_update(&missScoreField, missScore);
 }
 
+// redraws the digits of the level that changed
 static void drawNewLevelValue() {
-    display_setCursor(SCORE_CURSOR_X6, SCORE_CURSOR_Y); // set the cursor to the appropriate position
-    display_setTextColor(DISPLAY_BLACK); // set the color to black to match the background
-    display_print(lastDrawnLevel); // draw the last drawn score in black to erase it
-
-    display_setCursor(SCORE_CURSOR_X6, SCORE_CURSOR_Y); // reset the cursor
-    display_setTextColor(DISPLAY_WHITE); // set the cursor to white for text
-    display_print(currentLevel); // draw the new score
-    lastDrawnLevel = currentLevel; // reset the last drawn score to what was just drawn
+    numericField_update(&levelField, currentLevel);
 }
 
 // GETTERS AND SETTERS
     // Provide support to set games with varying numbers of moles. This function
     // would be called prior to calling wamDisplay_init();
+// 9 moles: 3 rows, 3 columns, 6 moles: 2 rows, 3 columns, 4 moles: 2 rows, 2 columns
 void wamDisplay_selectMoleCount(wamDisplay_moleCount_e moleCount) {
-    currentGameMoleCount = moleCount;
+    switch(moleCount) {
+        case wamDisplay_moleCount_4:
+            wamDisplay_selectGrid(SMALL_BOARD_ROWS, SMALL_BOARD_COLUMNS);
+            break;
+        case wamDisplay_moleCount_6:
+            wamDisplay_selectGrid(SMALL_BOARD_ROWS, DEFAULT_COLUMNS);
+            break;
+        default:
+            wamDisplay_selectGrid(DEFAULT_ROWS, DEFAULT_COLUMNS);
+            break;
+    }
+}
+
+// Selects a board of rows x columns moles for the next call to wamDisplay_init().
+// Returns false if the grid cannot be laid out on the board; wamDisplay_init() then uses 3 x 3.
+bool wamDisplay_selectGrid(uint8_t rows, uint8_t columns) {
+    selectedRows = rows;
+    selectedColumns = columns;
+    return wamLayout_fits(rows, columns, MOLE_BACKGROUND_WIDTH, MOLE_BACKGROUND_HEIGHT);
 }
 
 // Sets the hit value in the score window.
@@ -439,14 +396,16 @@ void wamDisplay_resetAllScoresAndLevel() {
 // whacked without having to implement the entire game).
 wamDisplay_moleIndex_t wamDisplay_whackMole(wamDisplay_point_t* whackOrigin) {
     // call the helper function to associate the touch with a touched region
-    uint8_t moleIndex = computeMoleIndexFromTouchCoord(whackOrigin->x, whackOrigin->y);
+    wamDisplay_moleIndex_t moleIndex = wamLayout_findHole(whackOrigin->x, whackOrigin->y);
 
-    // first check to make sure that the touch was on the mole board
-    if(moleIndex != MOLE_INDEX_NOT_A_MOLE) {
+    // first check to make sure that the touch was on a mole in this game's board
+    if(moleIndex != MOLE_INDEX_NOT_A_MOLE && moleIndex < numberOfMoles) {
         // if the mole is currently visible, increase hit score
-        if(wamDisplay_moleInfo[moleIndex]->ticksUntilDormant && !wamDisplay_moleInfo[moleIndex]->ticksUntilAwake) {
-            drawMole(moleIndex, ERASE); // erase the mole
-            wamDisplay_moleInfo[moleIndex]->ticksUntilDormant = 0; // reset the mole's ticks until dormant to 0
+        if(moleIsAwake[moleIndex]) {
+            animateMole(moleIndex, wamSprites_whack_e); // squash the mole
+            timerWheel_cancel(&moleWheel, moleIndex); // he is not going back in on his own now
+            moleIsAwake[moleIndex] = false; // the mole is dormant again
+            wamDisplay_setHoleFree(moleIndex, true); // and his hole can be picked again
             hitScore++; // this indicates a that a hit was registered, so increase the hit score
             activeMoleCount--; // reduce the number of active moles since one was just hit
             drawNewHitScore(); // draw an updated version of the hit score
@@ -473,8 +432,8 @@ wamDisplay_moleIndex_t wamDisplay_whackMole(wamDisplay_point_t* whackOrigin) {
 void wamDisplay_runMilestone1_test() {
     // test function demonstrating functionality required for milestone 1
     display_fillScreen(DISPLAY_BLACK); // clear the screen
-    numberOfMoles = MAX_NUMBER_OF_MOLES; // set the number of moles to the starting value
-    wamDisplay_computeMoleInfo(); // allocate mole info records
+    wamDisplay_selectGrid(DEFAULT_ROWS, DEFAULT_COLUMNS); // use the standard 3 x 3 board
+    wamDisplay_init(); // generate its layout and reset the mole records
     wamDisplay_drawMoleBoard(); // draw the game board
     wamDisplay_drawScoreScreen(); // draw the score screen
     while(!display_isTouched()); // pause while there is no touch
@@ -488,62 +447,78 @@ void wamDisplay_runMilestone1_test() {
 
 
 // Selects a random mole and activates it.
-// Activating a mole means that the ticksUntilAwake and ticksUntilDormant counts are initialized.
-// See the comments for wamDisplay_moleInfo_t for details.
+// Activating a mole means that its timer is started for the asleep interval and its awake interval is stored.
+// See the comments on the mole pool in wamDisplay.c for details.
 // Returns true if a mole was successfully activated. False otherwise. You can
 // use the return value for error checking as this function should always be successful
 // unless you have a bug somewhere.
 bool wamDisplay_activateRandomMole() {
-    uint8_t randMoleIndex;
-    // try to activate an inactive mole only 50 times incase there is a bug
-    for(uint16_t i = 0; i < MAX_NUMBER_RAND_TRIES; i++) {
-        randMoleIndex = rand() % numberOfMoles; // get an index based off of the number of moles in the game
-        // if the mole is inactive, break out of the loop saving the corresponding index
-        if(wamDisplay_moleInfo[randMoleIndex]->ticksUntilAwake == 0 && wamDisplay_moleInfo[randMoleIndex]->ticksUntilDormant == 0) {
-            break;
-        }
+    uint16_t freeHoleCount = wamDisplay_countFreeHoles();
+    // every hole already has an active mole
+    if(!freeHoleCount) {
+        return false;
+    }
+    // pick one of the free holes directly, rather than retrying random holes until a free one comes up
+    wamDisplay_moleIndex_t randMoleIndex = wamDisplay_selectFreeHole(rand() % freeHoleCount);
+    if(randMoleIndex == MOLE_INDEX_NOT_A_MOLE) {
+        return false;
     }
 
     // activate this mole by getting random times for the asleep and awake intervals, thus creating random
     // behavior for the user
-    wamDisplay_moleInfo[randMoleIndex]->ticksUntilAwake = wamControl_getRandomMoleAsleepInterval();
-    wamDisplay_moleInfo[randMoleIndex]->ticksUntilDormant = wamControl_getRandomMoleAwakeInterval();
+    wamDisplay_setHoleFree(randMoleIndex, false);
+    moleIsAwake[randMoleIndex] = false;
+    timerWheel_schedule(&moleWheel, randMoleIndex, wamControl_getRandomMoleAsleepInterval());
+    moleAwakeTicks[randMoleIndex] = wamControl_getRandomMoleAwakeInterval();
     activeMoleCount++; // increase the active count
     return true;
 }
 
+// Called by the mole wheel when a mole's timer expires: an asleep mole pops out, an awake one goes
+// back in and counts as a miss.
+static void wamDisplay_moleTimerExpired(timerWheel_timerId_t index, void* context) {
+    // an asleep mole pops out: start his pop-up animation and the awake interval
+    if(!moleIsAwake[index]) {
+        moleIsAwake[index] = true;
+        animateMole(index, wamSprites_popUp_e);
+        timerWheel_schedule(&moleWheel, index, moleAwakeTicks[index]);
+    }
+    // an awake mole was not whacked in time: increment the miss count and hide the mole
+    else {
+        moleIsAwake[index] = false;
+        missScore++; // this indicates the user has missed, increment the count
+        animateMole(index, wamSprites_hide_e); // the mole goes back in
+        wamDisplay_setHoleFree(index, true); // the hole can be picked again
+        activeMoleCount--; // stop counting this mole as active
+        drawNewMissScore(); // draw an updated version of the miss score
+    }
+}
 
-// This updates the ticksUntilAwake/ticksUntilDormant clocks for all of the moles.
-void wamDisplay_updateAllMoleTickCounts() {
-    // iterates through the entire array of moles currently being used by the game
-    for(uint16_t i = 0; i < numberOfMoles; i++) {
-        // first checks to see if the mole is active but asleep
-        if(wamDisplay_moleInfo[i]->ticksUntilAwake) {
-            // if it is, decrement the ticks until awake
-            wamDisplay_moleInfo[i]->ticksUntilAwake--;
-            // if the ticks until awake expire, draw the mole
-            if(!wamDisplay_moleInfo[i]->ticksUntilAwake) {
-                drawMole(i, NO_ERASE);
-            }
-        }
-        // next check to see if the mole is active and awake
-        else if(wamDisplay_moleInfo[i]->ticksUntilDormant) {
-            // if it is, decrement the ticks until dormant
-            wamDisplay_moleInfo[i]->ticksUntilDormant--;
-            // if the ticks until dormant expire, increment the miss count and erase the mole
-            if(!wamDisplay_moleInfo[i]->ticksUntilDormant) {
-                missScore++; // this indicates the user has missed, increment the count
-                drawMole(i, ERASE); // erase the mole
-                activeMoleCount--; // stop counting this mole as active
-                drawNewMissScore(); // draw an updated version of the miss score
+// Steps the animations that are playing by one tick.
+static void wamDisplay_stepMoleAnimations() {
+    for(uint16_t w = 0; w < MOLE_BITMAP_WORD_COUNT; w++) {
+        uint32_t bits = animatingMoles[w];
+        // visit only the set bits, lowest first
+        while(bits) {
+            uint16_t bit = __builtin_ctz(bits);
+            bits &= bits - 1; // clear the bit just found
+            if(!sprite_tick(&molePlayers[w * MOLE_BITMAP_WORD_BITS + bit])) {
+                animatingMoles[w] &= ~(1UL << bit); // the animation finished
             }
         }
     }
 }
 
+// This advances the mole clocks by one tick; only moles whose timers expire on this tick are touched.
+void wamDisplay_updateAllMoleTickCounts() {
+    // step the animations first, so one started by a timer below shows its first frame for a whole tick
+    wamDisplay_stepMoleAnimations();
+    timerWheel_advance(&moleWheel, wamDisplay_moleTimerExpired, NULL);
+}
+
 // Returns the count of currently active moles.
 // A mole is active if it is not dormant, if:
-// ticksUntilAwake or ticksUntilDormant are non-zero (in the moleInfo_t struct).
+// its timer is running (in the mole pool).
 uint16_t wamDisplay_getActiveMoleCount() {
     return activeMoleCount;
 }
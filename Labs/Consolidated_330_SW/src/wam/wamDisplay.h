@@ -25,14 +25,23 @@ typedef enum {wamDisplay_moleCount_9, wamDisplay_moleCount_6, wamDisplay_moleCou
 
 // Provide support to set games with varying numbers of moles. This function
 // would be called prior to calling wamDisplay_init();
+// 9 moles: 3 rows, 3 columns, 6 moles: 2 rows, 3 columns, 4 moles: 2 rows, 2 columns
 void wamDisplay_selectMoleCount(wamDisplay_moleCount_e moleCount);
 
+// Selects a board of rows x columns moles (numbered row by row from the top left) for the next
+// call to wamDisplay_init(). Returns false if the grid cannot be laid out on the board, in which case
+// wamDisplay_init() uses 3 x 3 instead. See wamLayout.h for the limits.
+bool wamDisplay_selectGrid(uint8_t rows, uint8_t columns);
+
 // Call this before using any wamDisplay_ functions.
 void wamDisplay_init();
 
 // Draw the game display with a background and mole holes.
 void wamDisplay_drawMoleBoard();
 
+// Draws the mole board again with the moles that are out, without changing the game.
+void wamDisplay_redrawMoleBoard();
+
 // Draw the initial splash (instruction) screen.
 void wamDisplay_drawSplashScreen();
 
@@ -40,8 +49,8 @@ void wamDisplay_drawSplashScreen();
 void wamDisplay_drawGameOverScreen();
 
 // Selects a random mole and activates it.
-// Activating a mole means that the ticksUntilAwake and ticksUntilDormant counts are initialized.
-// See the comments for wamDisplay_moleInfo_t for details.
+// Activating a mole means that its timer is started for the asleep interval and its awake interval is stored.
+// See the comments on the mole pool in wamDisplay.c for details.
 // Returns true if a mole was successfully activated. False otherwise. You can
 // use the return value for error checking as this function should always be successful
 // unless you have a bug somewhere.
@@ -54,12 +63,12 @@ bool wamDisplay_activateRandomMole();
 // whacked without having to implement the entire game).
 wamDisplay_moleIndex_t wamDisplay_whackMole(wamDisplay_point_t* whackOrigin);
 
-// This updates the ticksUntilAwake/ticksUntilDormant clocks for all of the moles.
+// This advances the mole clocks by one tick; only moles whose timers expire on this tick are touched.
 void wamDisplay_updateAllMoleTickCounts();
 
 // Returns the count of currently active moles.
 // A mole is active if it is not dormant, if:
-// ticksUntilAwake or ticksUntilDormant are non-zero (in the moleInfo_t struct).
+// its timer is running (in the mole pool).
 uint16_t wamDisplay_getActiveMoleCount();
 
 // Sets the hit value in the score window.
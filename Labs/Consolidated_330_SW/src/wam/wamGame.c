@@ -0,0 +1,131 @@
+/*
+ * wamGame.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "wamGame.h"
+#include "wamControl.h"
+#include "wamDisplay.h"
+#include "supportFiles/display.h"
+#include "supportFiles/globalTimer.h"
+#include "../switchesAndButtons/switches.h"
+#include <stddef.h>
+
+#define WAM_GAME_PRIORITY 0 // Only task, so any priority will do.
+
+#define SWITCH_MASK 0xf   // Ignore potentially extraneous bits.
+#define SWITCH_PATTERN_COUNT (SWITCH_MASK + 1)  // One board size per switch pattern.
+
+// Board size (rows, columns) for each switch pattern. The original patterns keep their boards
+// (1001 - nine moles, 0110 - 6 moles, 0100 - 4 moles); the rest grow up to the largest grid that fits.
+static const struct {uint8_t rows, columns;} switchGrids[SWITCH_PATTERN_COUNT] = {
+    {3, 3},  // 0000
+    {1, 3},  // 0001
+    {2, 4},  // 0010
+    {3, 4},  // 0011
+    {2, 2},  // 0100 - 4 moles
+    {4, 4},  // 0101
+    {2, 3},  // 0110 - 6 moles
+    {4, 5},  // 0111
+    {4, 6},  // 1000
+    {3, 3},  // 1001 - 9 moles
+    {5, 6},  // 1010
+    {5, 7},  // 1011
+    {6, 8},  // 1100
+    {6, 9},  // 1101
+    {7, 10}, // 1110
+    {8, 10}, // 1111
+};
+
+// Where the player is between games.
+typedef enum {
+    splash_st,          // splash screen up, waiting for a touch
+    release_st,         // touched, waiting for the finger to come off to start a game
+    playing_st,         // the mole controller is running the game
+    game_over_st        // game-over screen up, waiting for a touch to play again
+} wamGame_st_t;
+
+static wamGame_st_t currentState = splash_st;
+static uint32_t randomSeed; // how long the player took to touch, makes the game seem more random
+
+// Mole count is selected by setting the slide switches. The binary value for the switches
+// selects the board from switchGrids (1001 - nine moles, 0110 - 6 moles, 0100 - 4 moles).
+void wamGame_selectGridFromSwitches(uint16_t switchValue) {
+    uint16_t pattern = switchValue & SWITCH_MASK;
+    wamDisplay_selectGrid(switchGrids[pattern].rows, switchGrids[pattern].columns);
+}
+
+// Starts at the splash screen with the scores cleared.
+static void wamGame_init() {
+    currentState = splash_st;
+    wamControl_setMaxActiveMoles(WAMGAME_MAX_ACTIVE_MOLES); // Start out with this many simultaneous active moles.
+    wamControl_setMaxMissCount(WAMGAME_MAX_MISSES);         // Allow this many misses before ending game.
+    wamControl_setMsPerTick(WAMCONTROL_TICK_PERIOD_MS); // Let the controller know how ms per tick.
+    wamDisplay_resetAllScoresAndLevel();
+}
+
+// Draws the screen for the current state.
+static void wamGame_draw() {
+    switch(currentState) {
+    case splash_st:
+    case release_st:
+        display_fillScreen(DISPLAY_BLACK);
+        wamDisplay_drawSplashScreen();
+        break;
+    case playing_st:
+        wamDisplay_redrawMoleBoard();
+        break;
+    case game_over_st:
+        wamDisplay_drawGameOverScreen();
+        break;
+    }
+}
+
+// Runs the splash and game-over screens, and the mole controller while a game is on.
+static void wamGame_tick() {
+    switch(currentState) {
+    case splash_st:
+        if(display_isTouched()) {
+            randomSeed = (uint32_t) globalTimer_getTimerValue(); // How long that took makes a random seed.
+            currentState = release_st;
+        }
+        break;
+    case release_st:
+        // the game starts when the finger comes off, so the touch is not taken as a whack
+        if(!display_isTouched()) {
+            wamGame_selectGridFromSwitches(switches_read()); // Mole count selected via slide switches.
+            wamDisplay_init();                      // Initialize the WAM display.
+            wamControl_init();                      // Initialize the WAM controller.
+            wamControl_setRandomSeed(randomSeed);   // Set the random-seed.
+            wamDisplay_drawMoleBoard();             // Draw the WAM mole board.
+            currentState = playing_st;
+        }
+        break;
+    case playing_st:
+        wamControl_tick();
+        if(wamControl_isGameOver()) {
+            wamDisplay_drawGameOverScreen();
+            currentState = game_over_st;
+        }
+        break;
+    case game_over_st:
+        if(display_isTouched()) {
+            wamDisplay_resetAllScoresAndLevel();    // Reset all game statistics so you can start over.
+            randomSeed = (uint32_t) globalTimer_getTimerValue();
+            currentState = release_st;
+        }
+        break;
+    }
+}
+
+const game_t wamGame_descriptor = {
+    "Whack-a-Mole",
+    {{"wamGame_tick()", wamGame_tick, WAMCONTROL_TICK_PERIOD_MS, WAM_GAME_PRIORITY}},
+    wamGame_init,
+    wamGame_draw,
+    NULL,
+    NULL,
+    NULL,
+};
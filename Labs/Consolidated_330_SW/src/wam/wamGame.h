@@ -0,0 +1,24 @@
+/*
+ * wamGame.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef WAMGAME_H_
+#define WAMGAME_H_
+
+#include "supportFiles/game.h"
+#include <stdint.h>
+
+#define WAMGAME_MAX_ACTIVE_MOLES 1  // Start out with this many moles (wamMain.c uses the same settings).
+#define WAMGAME_MAX_MISSES 5        // Game is over when there are this many misses.
+
+// Whack-a-mole as a game for the launcher. The splash screen, play and the game-over screen that
+// wamMain.c runs with while-loops are a state machine here, ticked with the mole controller.
+extern const game_t wamGame_descriptor;
+
+// Selects the board for the next game from the slide switches (see the table in wamGame.c).
+void wamGame_selectGridFromSwitches(uint16_t switchValue);
+
+#endif /* WAMGAME_H_ */
@@ -0,0 +1,141 @@
+/*
+ * wamLayout.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "wamLayout.h"
+#include "supportFiles/display.h"
+
+#define NOT_IN_A_CELL (-1) // entry of the row/column tables outside the board
+// the hole fills this fraction of the smaller side of its cell, 2/5 gives 25 pixels on the 3x3 board
+#define RADIUS_NUMERATOR 2
+#define RADIUS_DENOMINATOR 5
+#define MAX_SPRITE_BANDS (2 * WAMLAYOUT_MAX_RADIUS + 1) // worst case: every row of the circle differs
+
+// one filled rectangle of the hole sprite, relative to the hole's center
+typedef struct {
+    int16_t dy; // top row of the band
+    int16_t height; // rows in the band
+    int16_t halfWidth; // the band spans dx = -halfWidth .. halfWidth
+} wamLayout_band_t;
+
+static uint8_t layoutRows; // size of the current grid
+static uint8_t layoutColumns;
+static int16_t holeRadius; // radius of every hole
+static wamDisplay_point_t holeOrigin[WAMLAYOUT_MAX_HOLES]; // center of each hole, row by row
+static int8_t rowOfY[DISPLAY_HEIGHT]; // spatial index: grid row at each screen y, or NOT_IN_A_CELL
+static int8_t columnOfX[DISPLAY_WIDTH]; // spatial index: grid column at each screen x, or NOT_IN_A_CELL
+static wamLayout_band_t spriteBands[MAX_SPRITE_BANDS]; // the hole sprite, top to bottom
+static uint16_t spriteBandCount;
+
+// Fills one axis of the spatial index: size pixels starting at start split into count equal cells.
+static void wamLayout_indexAxis(int8_t* cellOf, int16_t screenSize, int16_t start, int16_t size, uint8_t count) {
+    for(int16_t i = 0; i < screenSize; i++) {
+        int16_t offset = i - start;
+        // the cell is offset * count / size, so each cell gets its share of any leftover pixels
+        cellOf[i] = (offset < 0 || offset >= size) ? NOT_IN_A_CELL : (int8_t) (offset * count / size);
+    }
+}
+
+// Builds the sprite of a circle of radius r: each row's half width, with runs of equal rows merged into one band.
+static void wamLayout_buildSprite(int16_t r) {
+    spriteBandCount = 0;
+    for(int16_t dy = -r; dy <= r; dy++) {
+        int16_t absDy = dy < 0 ? -dy : dy;
+        int16_t rowHalfWidth = 0;
+        // widest x with x^2 + dy^2 <= r^2, computed once per layout so no square roots are needed
+        while((rowHalfWidth + 1) * (rowHalfWidth + 1) + absDy * absDy <= r * r) {
+            rowHalfWidth++;
+        }
+        if(spriteBandCount && spriteBands[spriteBandCount - 1].halfWidth == rowHalfWidth) {
+            spriteBands[spriteBandCount - 1].height++; // same width as the row above, extend its band
+        }
+        else {
+            spriteBands[spriteBandCount].dy = dy; // start a new band
+            spriteBands[spriteBandCount].height = 1;
+            spriteBands[spriteBandCount].halfWidth = rowHalfWidth;
+            spriteBandCount++;
+        }
+    }
+}
+
+// Radius of the holes of a rows x columns grid in width x height (before clamping), 0 if the tables have no room.
+static int16_t wamLayout_computeRadius(uint8_t rows, uint8_t columns, int16_t width, int16_t height) {
+    if(!rows || !columns || rows > WAMLAYOUT_MAX_ROWS || columns > WAMLAYOUT_MAX_COLUMNS) {
+        return 0; // the tables have no room for this grid
+    }
+    int16_t cellWidth = width / columns;
+    int16_t cellHeight = height / rows;
+    return (cellWidth < cellHeight ? cellWidth : cellHeight) * RADIUS_NUMERATOR / RADIUS_DENOMINATOR;
+}
+
+// True if a rows x columns grid can be laid out in a rectangle of width x height.
+bool wamLayout_fits(uint8_t rows, uint8_t columns, int16_t width, int16_t height) {
+    return wamLayout_computeRadius(rows, columns, width, height) >= WAMLAYOUT_MIN_RADIUS;
+}
+
+// Generates the layout of a rows x columns grid in the rectangle at (left, top).
+bool wamLayout_generate(uint8_t rows, uint8_t columns, int16_t left, int16_t top, int16_t width, int16_t height) {
+    int16_t radius = wamLayout_computeRadius(rows, columns, width, height);
+    if(radius < WAMLAYOUT_MIN_RADIUS) {
+        return false; // too many holes for the space
+    }
+    if(radius > WAMLAYOUT_MAX_RADIUS) {
+        radius = WAMLAYOUT_MAX_RADIUS;
+    }
+
+    layoutRows = rows;
+    layoutColumns = columns;
+    holeRadius = radius;
+    // center each hole in its cell; the cells are the same ones the spatial index uses
+    for(uint8_t row = 0; row < rows; row++) {
+        for(uint8_t column = 0; column < columns; column++) {
+            wamDisplay_point_t* origin = &holeOrigin[row * columns + column];
+            origin->x = left + (2 * column + 1) * width / (2 * columns);
+            origin->y = top + (2 * row + 1) * height / (2 * rows);
+        }
+    }
+    wamLayout_indexAxis(columnOfX, DISPLAY_WIDTH, left, width, columns);
+    wamLayout_indexAxis(rowOfY, DISPLAY_HEIGHT, top, height, rows);
+    wamLayout_buildSprite(radius);
+    return true;
+}
+
+// Number of holes in the current layout (rows x columns).
+uint16_t wamLayout_getHoleCount() {
+    return layoutRows * layoutColumns;
+}
+
+// Radius of every hole in the current layout.
+int16_t wamLayout_getHoleRadius() {
+    return holeRadius;
+}
+
+// Center of a hole.
+wamDisplay_point_t wamLayout_getHoleOrigin(wamDisplay_moleIndex_t hole) {
+    return holeOrigin[hole];
+}
+
+// Returns the hole whose cell contains (x, y), WAMLAYOUT_NOT_A_HOLE if none does.
+wamDisplay_moleIndex_t wamLayout_findHole(int16_t x, int16_t y) {
+    if(x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT) {
+        return WAMLAYOUT_NOT_A_HOLE; // off the screen altogether
+    }
+    int8_t row = rowOfY[y];
+    int8_t column = columnOfX[x];
+    if(row == NOT_IN_A_CELL || column == NOT_IN_A_CELL) {
+        return WAMLAYOUT_NOT_A_HOLE; // on the screen but not on the board
+    }
+    return row * layoutColumns + column;
+}
+
+// Draws a hole (or a mole in it) in color using the precomputed sprite.
+void wamLayout_drawHole(wamDisplay_moleIndex_t hole, uint16_t color) {
+    wamDisplay_point_t origin = holeOrigin[hole];
+    for(uint16_t i = 0; i < spriteBandCount; i++) {
+        const wamLayout_band_t* band = &spriteBands[i];
+        display_fillRect(origin.x - band->halfWidth, origin.y + band->dy, 2 * band->halfWidth + 1, band->height, color);
+    }
+}
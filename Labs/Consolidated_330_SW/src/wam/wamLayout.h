@@ -0,0 +1,53 @@
+/*
+ * wamLayout.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef WAMLAYOUT_H_
+#define WAMLAYOUT_H_
+
+#include "wamDisplay.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Generates the mole board for any grid of rows x columns that fits in a rectangle of the screen.
+// The rectangle is split into equal cells with one hole centered in each; holes are numbered row by row
+// from the top left. Generating a layout also builds:
+// - a spatial index: the row of every screen y and the column of every screen x, so finding the hole
+//   under a touch is two table reads;
+// - the hole sprite: the circle as a short list of filled bands (rows of equal width merged), so drawing
+//   a hole or a mole is a few rectangle fills with nothing computed.
+
+#define WAMLAYOUT_MAX_ROWS 8        // Largest grid the layout tables are sized for.
+#define WAMLAYOUT_MAX_COLUMNS 10
+#define WAMLAYOUT_MAX_HOLES (WAMLAYOUT_MAX_ROWS * WAMLAYOUT_MAX_COLUMNS)
+#define WAMLAYOUT_MIN_RADIUS 4      // A grid whose holes come out smaller than this does not fit.
+#define WAMLAYOUT_MAX_RADIUS 80     // Larger holes (few big cells) are clamped to this.
+#define WAMLAYOUT_NOT_A_HOLE (-1)   // Returned for touches outside every cell.
+
+// True if a rows x columns grid can be laid out in a rectangle of width x height.
+bool wamLayout_fits(uint8_t rows, uint8_t columns, int16_t width, int16_t height);
+
+// Generates the layout of a rows x columns grid in the rectangle at (left, top).
+// Returns false (and keeps the previous layout) if the grid is empty, too large for the tables, or the
+// holes would be smaller than WAMLAYOUT_MIN_RADIUS.
+bool wamLayout_generate(uint8_t rows, uint8_t columns, int16_t left, int16_t top, int16_t width, int16_t height);
+
+// Number of holes in the current layout (rows x columns).
+uint16_t wamLayout_getHoleCount();
+
+// Radius of every hole in the current layout.
+int16_t wamLayout_getHoleRadius();
+
+// Center of a hole.
+wamDisplay_point_t wamLayout_getHoleOrigin(wamDisplay_moleIndex_t hole);
+
+// Returns the hole whose cell contains (x, y), WAMLAYOUT_NOT_A_HOLE if none does.
+wamDisplay_moleIndex_t wamLayout_findHole(int16_t x, int16_t y);
+
+// Draws a hole (or a mole in it) in color using the precomputed sprite.
+void wamLayout_drawHole(wamDisplay_moleIndex_t hole, uint16_t color);
+
+#endif /* WAMLAYOUT_H_ */
@@ -7,53 +7,21 @@
 
 #include "wamDisplay.h"
 #include "wamControl.h"
+#include "wamGame.h"
 #include "supportFiles/utils.h"
 #include "supportFiles/display.h"
 #include "../intervalTimer/intervalTimer.h"  // Modify as necessary to point to your intervalTimer.h
 #include "supportFiles/leds.h"
 #include "supportFiles/interrupts.h"
+#include "supportFiles/scheduler.h"
+#include "supportFiles/globalTimer.h"
 #include "../switchesAndButtons/switches.h"  // Modify as necessary to point to your switches.h
 #include "../switchesAndButtons/buttons.h"   // Modify as necessary to point to your buttons.h
 #include <stdio.h>
 #include <xparameters.h>
 
-// The formula for computing the load value is based upon the formula from 4.1.1 (calculating timer intervals)
-// in the Cortex-A9 MPCore Technical Reference Manual 4-2.
-// Assuming that the prescaler = 0, the formula for computing the load value based upon the desired period is:
-// load-value = (period * timer-clock) - 1
-#define TIMER_PERIOD 50.0E-3    // 50 ms.
-#define TIMER_CLOCK_FREQUENCY (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
-#define TIMER_LOAD_VALUE ((TIMER_PERIOD * TIMER_CLOCK_FREQUENCY) - 1.0)
-
-#define MAX_ACTIVE_MOLES 1  // Start out with this many moles.
-#define MAX_MISSES 5       // Game is over when there are this many misses.
 #define FOREVER 1           // Syntactic sugar for while (1) statements.
-#define MS_PER_TICK (TIMER_PERIOD * 1000)   // Just multiply the timer period by 1000 to get ms.
-
-#define SWITCH_VALUE_9 9  // Binary 9 on the switches indicates 9 moles.
-#define SWITCH_VALUE_6 6  // Binary 6 on the switches indicates 6 moles.
-#define SWITCH_VALUE_4 4  // Binary 9 on the switches indicates 4 moles.
-#define SWITCH_MASK 0xf   // Ignore potentially extraneous bits.
-
-// Mole count is selected by setting the slide switches. The binary value for the switches
-// determines the mole count (1001 - nine moles, 0110 - 6 moles, 0100 - 4 moles).
-// All other switch values should default to 9 moles).
-void wamMain_selectMoleCountFromSwitches(uint16_t switchValue) {
-    switch(switchValue & SWITCH_MASK) {
-    case SWITCH_VALUE_9:    // this switch pattern = 9 moles.
-        wamDisplay_selectMoleCount(wamDisplay_moleCount_9);
-        break;
-    case SWITCH_VALUE_6:    // this switch pattern = 6 moles.
-        wamDisplay_selectMoleCount(wamDisplay_moleCount_6);
-        break;
-    case SWITCH_VALUE_4:   // this switch pattern = 4 moles.
-        wamDisplay_selectMoleCount(wamDisplay_moleCount_4);
-        break;
-    default:    // Any other pattern of switches = 9 moles.
-        wamDisplay_selectMoleCount(wamDisplay_moleCount_9);
-        break;
-    }
-}
+#define WAM_CONTROL_PRIORITY 0  // Only task, so any priority will do.
 
 // Milestone 1 passoff main
 //int main() {
@@ -65,12 +33,18 @@ void wamMain_selectMoleCountFromSwitches(uint16_t switchValue) {
 //
 //    /******************** Game-Specific Code ********************/
 //    while(FOREVER) {
-//        wamMain_selectMoleCountFromSwitches(switches_read());  // Mole count selected via slide switches.
+//        wamGame_selectGridFromSwitches(switches_read());  // Mole count selected via slide switches.
 //        wamDisplay_runMilestone1_test();
 //    }
 //}
 
 
+// Sleeps in the scheduler (tickless, so the CPU is idle) until the screen is touched or released.
+static void wamMain_waitForTouch(bool touchedFlag) {
+    while (display_isTouched() != touchedFlag)
+        scheduler_runOnce();    // Wakes at least once per wamControl period to poll the screen again.
+}
+
 // Top-level control loop is implemented with while-loops in main().
 int main() {
     /************************* System Initialization Code ***********************/
@@ -80,47 +54,49 @@ int main() {
     // Init all interrupts (but does not enable the interrupts at the devices).
     // Prints an error message if an internal failure occurs because the argument = true.
     interrupts_initAll(true);   // Init the interrupt code.
-    interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE);  // Set the timer period.
-    interrupts_enableTimerGlobalInts();  // Enable interrupts at the timer.
-    interrupts_startArmPrivateTimer();   // Start the private ARM timer running.
-    uint32_t personalInterruptCount = 0; // Used to compare with internal count from interrupt code.
+    scheduler_init();           // The scheduler sets the timer period from the task periods.
+    scheduler_taskId_t wamControlTask =
+        scheduler_addTask("wamControl_tick()", wamControl_tick, WAMCONTROL_TICK_PERIOD_MS, WAM_CONTROL_PRIORITY);
+    scheduler_setTaskEnabled(wamControlTask, false);  // Only ticks while a game is running.
+    scheduler_setTickless(true); // Sleep through the splash and game-over screens.
+    scheduler_start();          // Start the private ARM timer running.
+    interrupts_enableArmInts(); // Enable interrupts at the ARM.
     /******************** Game-Specific Code ********************/
     uint32_t randomSeed;    // Used to make the game seem more random.
     display_init();         // Init the display (make sure to do it only once).
-    wamControl_setMaxActiveMoles(MAX_ACTIVE_MOLES); // Start out with this many simultaneous active moles.
-    wamControl_setMaxMissCount(MAX_MISSES);         // Allow this many misses before ending game.
-    wamControl_setMsPerTick(MS_PER_TICK);           // Let the controller know how ms per tick..
+    wamControl_setMaxActiveMoles(WAMGAME_MAX_ACTIVE_MOLES); // Start out with this many simultaneous active moles.
+    wamControl_setMaxMissCount(WAMGAME_MAX_MISSES);         // Allow this many misses before ending game.
+    wamControl_setMsPerTick(WAMCONTROL_TICK_PERIOD_MS); // Let the controller know how ms per tick..
     wamDisplay_drawSplashScreen();  // Draw the game splash screen.
     while (FOREVER) {               // Endless loop.
-        wamMain_selectMoleCountFromSwitches(switches_read());  // Mole count selected via slide switches.
+        wamGame_selectGridFromSwitches(switches_read());  // Mole count selected via slide switches.
         wamDisplay_init();              // Initialize the WAM display.
         wamControl_init();              // Initialize the WAM controller.
-        while (!display_isTouched()) {  // Wait for the user to touch the screen.
-            randomSeed++;               // Increment a random seed while you wait.
-        }
-        while (display_isTouched());            // Now wait for the user to remove their finger.
+        scheduler_resetCpuLoad();
+        wamMain_waitForTouch(true);     // Wait for the user to touch the screen.
+        randomSeed = (uint32_t) globalTimer_getTimerValue();  // How long that took makes a random seed.
+        wamMain_waitForTouch(false);            // Now wait for the user to remove their finger.
+        printf("splash screen CPU load: %ld%%\n\r", (long) scheduler_getCpuLoadPercent());
         wamControl_setRandomSeed(randomSeed);   // Set the random-seed.
         wamDisplay_drawMoleBoard();             // Draw the WAM mole board.
-        interrupts_enableArmInts();             // Enable interrupts at the ARM.
-        while (!wamControl_isGameOver() && !buttons_read()) {// Game runs until over or interrupted.
-            if (interrupts_isrFlagGlobal) {     // If an interrupt occurs, time to call tick.
-                interrupts_isrFlagGlobal = 0;   // Reset the interrupt flag.
-                personalInterruptCount++;       // Count interrupts.
-                wamControl_tick();              // tick the WAM controller.
-            }
-        }
-        interrupts_disableArmInts();            // Game is over, turn off interrupts.
-        // Print out the interrupt counts to ensure that you didn't miss any interrupts.
+        scheduler_setTaskEnabled(wamControlTask, true);
+        while (!wamControl_isGameOver() && !buttons_read()) // Game runs until over or interrupted.
+            scheduler_runOnce();                // Tick the WAM controller when due, sleep otherwise.
+        scheduler_setTaskEnabled(wamControlTask, false);  // Game is over, stop ticking.
+        // Print out the interrupt count and the tick overruns to ensure that you didn't miss any ticks.
         printf("isr invocation count: %ld\n\r", interrupts_isrInvocationCount());
-        printf("internal interrupt count: %ld\n\r", personalInterruptCount);
+        scheduler_printReport();
         wamDisplay_drawGameOverScreen();        // Draw the game-over screen.
-        while (!display_isTouched());           // Wait here until the user touches the screen to try again.
+        scheduler_resetCpuLoad();
+        wamMain_waitForTouch(true);             // Wait here until the user touches the screen to try again.
+        printf("game-over screen CPU load: %ld%%\n\r", (long) scheduler_getCpuLoadPercent());
         wamDisplay_resetAllScoresAndLevel();    // Reset all game statistics so you can start over.
     }
 }
 
+// Releases the ticks that are due; they run from main().
 void isr_function() {
-    // Empty for now.
+    scheduler_isrTick();
 }
 
 
@@ -0,0 +1,137 @@
+/*
+ * wamSprites.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "wamSprites.h"
+#include "wamLayout.h"
+#include "supportFiles/display.h"
+
+#define TICKS_PER_FRAME 1 // each frame stays up for one wamControl tick (50 ms)
+#define RISE_STEPS 4 // frames it takes the mole to come all the way up
+// the mole's body is this fraction of the hole's radius
+#define BODY_NUMERATOR 4
+#define BODY_DENOMINATOR 5
+#define EYE_RADIUS_DIVISOR 6 // eyes are radius / 6 across
+#define EYE_X_DIVISOR 3 // eyes sit radius / 3 either side of center
+#define EYE_Y_DIVISOR 5 // and radius / 5 above center
+#define SQUASH_HEIGHT_DIVISOR 3 // a squashed mole is a third as tall
+#define MOLE_COLOR DISPLAY_RED
+#define FLASH_COLOR DISPLAY_YELLOW // color of a mole the moment he is whacked
+#define EYE_COLOR DISPLAY_WHITE
+#define HOLE_COLOR DISPLAY_BLACK
+#define MAX_SIZE (2 * WAMLAYOUT_MAX_RADIUS + 1) // width and height of the largest frames
+// room for the runs of every frame; the frames of the largest hole take about 4100 words since most
+// rows are 1 or 3 runs
+#define RUN_CAPACITY (6 * 1024)
+
+// the frames, in the order they are rendered
+typedef enum {
+    hole_e, // empty hole
+    rise1_e, // mole a quarter of the way up
+    rise2_e, // half way up
+    rise3_e, // three quarters up
+    awake_e, // all the way up with his eyes open
+    flash_e, // just whacked
+    squash_e, // squashed flat
+    frameCount_e
+} wamSprites_frame_e;
+
+static int16_t holeRadius; // radius the frames were rendered for
+static sprite_frame_t frames[frameCount_e];
+static uint16_t rowOffsets[frameCount_e][MAX_SIZE + 1];
+static uint16_t runs[RUN_CAPACITY];
+
+static const sprite_frame_t* const popUpFrames[] = {&frames[rise1_e], &frames[rise2_e], &frames[rise3_e], &frames[awake_e]};
+static const sprite_frame_t* const hideFrames[] = {&frames[rise3_e], &frames[rise2_e], &frames[rise1_e], &frames[hole_e]};
+static const sprite_frame_t* const whackFrames[] = {&frames[flash_e], &frames[squash_e], &frames[hole_e]};
+static const sprite_animation_t animations[] = {
+    {popUpFrames, sizeof(popUpFrames) / sizeof(popUpFrames[0]), TICKS_PER_FRAME},
+    {hideFrames, sizeof(hideFrames) / sizeof(hideFrames[0]), TICKS_PER_FRAME},
+    {whackFrames, sizeof(whackFrames) / sizeof(whackFrames[0]), TICKS_PER_FRAME},
+};
+
+// true if (x, y) is inside the ellipse with radii rx, ry centered on (cx, cy)
+static bool insideEllipse(int32_t x, int32_t y, int32_t cx, int32_t cy, int32_t rx, int32_t ry) {
+    int32_t dx = x - cx;
+    int32_t dy = y - cy;
+    return dx * dx * ry * ry + dy * dy * rx * rx <= rx * rx * ry * ry;
+}
+
+// Pixel (x, y) of a frame, x and y measured from the top-left corner; context points at the frame's enum.
+static uint32_t wamSprites_paint(int16_t x, int16_t y, void* context) {
+    wamSprites_frame_e frame = *(const wamSprites_frame_e*) context;
+    int16_t r = holeRadius;
+    int16_t dx = x - r; // from the center of the hole
+    int16_t dy = y - r;
+    if(!insideEllipse(dx, dy, 0, 0, r, r)) {
+        return SPRITE_TRANSPARENT; // outside the hole the board shows through
+    }
+    int16_t body = r * BODY_NUMERATOR / BODY_DENOMINATOR;
+    switch(frame) {
+        case rise1_e:
+        case rise2_e:
+        case rise3_e: {
+            // the body starts below the hole and moves up; the rim of the hole hides the rest
+            int16_t bodyCenterY = (RISE_STEPS - (frame - hole_e)) * 2 * body / RISE_STEPS;
+            return insideEllipse(dx, dy, 0, bodyCenterY, body, body) ? MOLE_COLOR : HOLE_COLOR;
+        }
+        case awake_e: {
+            int16_t eyeRadius = r / EYE_RADIUS_DIVISOR ? r / EYE_RADIUS_DIVISOR : 1;
+            int16_t eyeX = r / EYE_X_DIVISOR;
+            int16_t eyeY = -r / EYE_Y_DIVISOR;
+            if(insideEllipse(dx, dy, -eyeX, eyeY, eyeRadius, eyeRadius) ||
+                    insideEllipse(dx, dy, eyeX, eyeY, eyeRadius, eyeRadius)) {
+                // pupils are half the eye, looking down at the player
+                int16_t pupilRadius = eyeRadius / 2;
+                if(pupilRadius && (insideEllipse(dx, dy, -eyeX, eyeY + pupilRadius, pupilRadius, pupilRadius) ||
+                        insideEllipse(dx, dy, eyeX, eyeY + pupilRadius, pupilRadius, pupilRadius))) {
+                    return HOLE_COLOR;
+                }
+                return EYE_COLOR;
+            }
+            return insideEllipse(dx, dy, 0, 0, body, body) ? MOLE_COLOR : HOLE_COLOR;
+        }
+        case flash_e:
+            return insideEllipse(dx, dy, 0, 0, body, body) ? FLASH_COLOR : HOLE_COLOR;
+        case squash_e: {
+            // flattened onto the bottom of the hole
+            int16_t squashHeight = body / SQUASH_HEIGHT_DIVISOR ? body / SQUASH_HEIGHT_DIVISOR : 1;
+            return insideEllipse(dx, dy, 0, body - squashHeight, body, squashHeight) ? MOLE_COLOR : HOLE_COLOR;
+        }
+        default:
+            return HOLE_COLOR;
+    }
+}
+
+// Renders every frame for holes of the given radius (at most WAMLAYOUT_MAX_RADIUS).
+bool wamSprites_build(int16_t radius) {
+    if(radius < 1 || radius > WAMLAYOUT_MAX_RADIUS) {
+        return false;
+    }
+    holeRadius = radius;
+    uint16_t size = 2 * radius + 1;
+    uint32_t used = 0;
+    for(uint16_t frame = 0; frame < frameCount_e; frame++) {
+        wamSprites_frame_e frameId = (wamSprites_frame_e) frame;
+        uint32_t words = sprite_encode(&frames[frame], rowOffsets[frame], &runs[used], RUN_CAPACITY - used, size, size,
+                wamSprites_paint, &frameId);
+        if(!words) {
+            return false; // out of room
+        }
+        used += words;
+    }
+    return true;
+}
+
+// The empty hole.
+const sprite_frame_t* wamSprites_getHoleFrame() {
+    return &frames[hole_e];
+}
+
+// One of the mole animations.
+const sprite_animation_t* wamSprites_getAnimation(wamSprites_animation_e animation) {
+    return &animations[animation];
+}
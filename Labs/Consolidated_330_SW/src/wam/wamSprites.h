@@ -0,0 +1,36 @@
+/*
+ * wamSprites.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef WAMSPRITES_H_
+#define WAMSPRITES_H_
+
+#include "supportFiles/sprite.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// The mole animations, rendered as RLE sprites (supportFiles/sprite.h) for the hole size of the current
+// layout. Every frame covers the whole hole, so going from one frame to the next only sends the rows and
+// runs that change. Frames are (2 * radius + 1) pixels square with the hole centered; corners are transparent.
+
+// Animations played on a mole.
+typedef enum {
+    wamSprites_popUp_e, // mole rises out of his hole and opens his eyes
+    wamSprites_hide_e, // mole sinks back into his hole
+    wamSprites_whack_e // mole flashes, is squashed and disappears
+} wamSprites_animation_e;
+
+// Renders every frame for holes of the given radius (at most WAMLAYOUT_MAX_RADIUS).
+// Returns false if the frames did not fit in the sprite buffers.
+bool wamSprites_build(int16_t radius);
+
+// The empty hole.
+const sprite_frame_t* wamSprites_getHoleFrame();
+
+// One of the mole animations.
+const sprite_animation_t* wamSprites_getAnimation(wamSprites_animation_e animation);
+
+#endif /* WAMSPRITES_H_ */
@@ -34,6 +34,7 @@
 
 #include "registers.h"
 #include "lcd.h"
+#include "perf.h"
 
 // Constructor for breakout board (configurable LCD control lines).
 // Can still use this w/shield, but parameters are ignored.
@@ -428,6 +429,7 @@ void Adafruit_TFTLCD::setLR(void) {
 // Requires setAddrWindow() has previously been called to set the fill
 // bounds.  'len' is inclusive, MUST be >= 1.
 void Adafruit_TFTLCD::flood(uint16_t color, uint32_t len) {
+  PERF_SCOPE("flood");
   uint16_t blocks;
   uint8_t  i, hi = color >> 8,
               lo = color;
@@ -0,0 +1,168 @@
+/*
+ * adcCapture.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "adcCapture.h"
+#include "amp.h"
+#include "globalTimer.h"
+#include "xparameters.h"
+#include "xsysmon_hw.h"
+#include "xil_cache.h"
+#include <stdio.h>
+
+#define ADCCAPTURE_DATA_SHIFT 4                   // Lower 4 bits of a conversion are noise (see interrupts_getAdcData()).
+#define ADCCAPTURE_TEST_MS 100                    // Length of the adcCapture_runTest() capture.
+#define ADCCAPTURE_MS_PER_SECOND 1000
+
+// Lives in uncached OCM so both cores see every write without cache maintenance.
+// CPU1 writes filledBlockCount, sampleCount and overrunCount; CPU0 writes runFlag and consumedBlockCount.
+typedef struct {
+  volatile uint32_t runFlag;             // CPU0 clears this to end the capture job.
+  volatile uint32_t filledBlockCount;    // Blocks CPU1 has completed. Free-running, like spscRing's head.
+  volatile uint32_t consumedBlockCount;  // Blocks CPU0 has handed back. Free-running, like spscRing's tail.
+  volatile uint32_t sampleCount;         // Samples kept, including dropped ones.
+  volatile uint32_t overrunCount;        // Samples dropped because no block was free.
+} adcCapture_control_t;
+
+// Arguments carried to CPU1 in the AMP mailbox.
+typedef struct {
+  adcCapture_control_t* control;
+  uint16_t* blocks;        // ADCCAPTURE_BLOCK_COUNT * ADCCAPTURE_BLOCK_SIZE samples.
+  uint32_t decimation;     // Keep every decimation-th conversion.
+} adcCapture_job_t;
+
+// Sample blocks in DDR. CPU1 writes them with its caches off; CPU0 only reads them, after invalidating
+// its cached copy. Aligned so invalidating one block never touches a line of another.
+static uint16_t blocks[ADCCAPTURE_BLOCK_COUNT][ADCCAPTURE_BLOCK_SIZE] __attribute__((aligned(32)));
+static adcCapture_control_t* const control = (adcCapture_control_t*) AMP_OCM_SHARED_ADDR;
+static adcCapture_blockCallback_t blockCallback = NULL;
+static bool runningFlag = false;
+
+// Runs on CPU1 until runFlag is cleared. MMU and D-cache are off there, so accesses are strongly ordered
+// and go straight to memory. Uses raw register reads: the XSysMon instance belongs to CPU0.
+static void adcCapture_cpu1Job(void* data) {
+  adcCapture_job_t* job = (adcCapture_job_t*) data;
+  adcCapture_control_t* shared = job->control;
+  uint32_t filled = 0;              // Local copy of filledBlockCount.
+  uint32_t sampleIndex = 0;         // Next slot in the block being filled.
+  uint32_t conversionsToSkip = 0;   // Decimation countdown.
+  while (shared->runFlag) {
+    // The EOC bit in the interrupt status register latches even though the interrupt is not connected.
+    if (!(XSysMon_ReadReg(XPAR_AXI_XADC_0_BASEADDR, XSM_IPISR_OFFSET) & XSM_IPIXR_EOC_MASK))
+      continue;
+    XSysMon_WriteReg(XPAR_AXI_XADC_0_BASEADDR, XSM_IPISR_OFFSET, XSM_IPIXR_EOC_MASK);  // Write 1 to clear.
+    uint16_t sample = XSysMon_ReadReg(XPAR_AXI_XADC_0_BASEADDR, XSM_AUX14_OFFSET) >> ADCCAPTURE_DATA_SHIFT;
+    if (conversionsToSkip) {
+      conversionsToSkip--;
+      continue;
+    }
+    conversionsToSkip = job->decimation - 1;
+    shared->sampleCount++;
+    if (filled - shared->consumedBlockCount >= ADCCAPTURE_BLOCK_COUNT) {  // Every block is waiting for CPU0.
+      shared->overrunCount++;
+      continue;
+    }
+    job->blocks[(filled & (ADCCAPTURE_BLOCK_COUNT - 1)) * ADCCAPTURE_BLOCK_SIZE + sampleIndex] = sample;
+    if (++sampleIndex == ADCCAPTURE_BLOCK_SIZE) {
+      sampleIndex = 0;
+      filled++;
+      shared->filledBlockCount = filled;  // Strongly ordered: the samples are in DDR before this lands.
+    }
+  }
+}
+
+// Starts capturing on CPU1.
+int adcCapture_start(adcCapture_blockCallback_t callback, uint32_t decimation) {
+  if (runningFlag || !callback || !amp_isCpu1Running() || !amp_isIdle()) {
+    printf("adcCapture_start: CPU1 is not running or is busy.\n\r");
+    return ADCCAPTURE_STATUS_FAIL;
+  }
+  blockCallback = callback;
+  control->filledBlockCount = 0;
+  control->consumedBlockCount = 0;
+  control->sampleCount = 0;
+  control->overrunCount = 0;
+  control->runFlag = true;
+  // Write back and drop any lines CPU0 holds for the blocks (e.g., from zeroing .bss) so a later
+  // eviction cannot overwrite samples that CPU1 has written underneath.
+  Xil_DCacheFlushRange((u32) blocks, sizeof(blocks));
+  adcCapture_job_t job = {.control = control, .blocks = &blocks[0][0], .decimation = decimation ? decimation : 1};
+  if (!amp_postJob(adcCapture_cpu1Job, &job, sizeof(job))) {
+    printf("adcCapture_start: could not post the capture job.\n\r");
+    return ADCCAPTURE_STATUS_FAIL;
+  }
+  runningFlag = true;
+  return ADCCAPTURE_STATUS_OK;
+}
+
+// Stops the capture and waits for CPU1 to return from the job.
+void adcCapture_stop() {
+  if (!runningFlag)
+    return;
+  control->runFlag = false;
+  adcCapture_job_t job;
+  while (!amp_collectResult(&job, sizeof(job)));
+  runningFlag = false;
+}
+
+bool adcCapture_isRunning() {
+  return runningFlag;
+}
+
+// Hands every filled block to the callback.
+uint32_t adcCapture_poll() {
+  if (!runningFlag)
+    return 0;
+  uint32_t consumed = control->consumedBlockCount;
+  uint32_t filled = __atomic_load_n(&control->filledBlockCount, __ATOMIC_ACQUIRE);  // Samples are read after this.
+  uint32_t delivered = 0;
+  for (; consumed != filled; consumed++, delivered++) {
+    uint16_t* block = blocks[consumed & (ADCCAPTURE_BLOCK_COUNT - 1)];
+    Xil_DCacheInvalidateRange((u32) block, sizeof(blocks[0]));  // Drop stale lines from the last trip around the ring.
+    blockCallback(block, ADCCAPTURE_BLOCK_SIZE);
+    // Hand the block back only after the callback is done with it (release orders its reads first).
+    __atomic_store_n(&control->consumedBlockCount, consumed + 1, __ATOMIC_RELEASE);
+  }
+  return delivered;
+}
+
+uint32_t adcCapture_getSampleCount() {
+  return control->sampleCount;
+}
+
+uint32_t adcCapture_getOverrunCount() {
+  return control->overrunCount;
+}
+
+static uint32_t testBlockCount;   // Blocks seen by the test callback.
+static uint32_t testSampleSum;    // Keeps the test callback from being trivial.
+
+// Touches every sample, like a real consumer would.
+static void adcCapture_testCallback(const uint16_t* samples, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++)
+    testSampleSum += samples[i];
+  testBlockCount++;
+}
+
+// Captures for ADCCAPTURE_TEST_MS and prints what arrived.
+void adcCapture_runTest() {
+  testBlockCount = testSampleSum = 0;
+  globalTimer_startTimer(false);
+  if (adcCapture_start(adcCapture_testCallback, 1) != ADCCAPTURE_STATUS_OK) {
+    printf("adcCapture_runTest: FAILED (capture did not start).\n\r");
+    return;
+  }
+  u64 startTime = globalTimer_getTimerValue();
+  u64 endTime = startTime + (u64) GLOBAL_TIMER_TICKS_PER_SECOND * ADCCAPTURE_TEST_MS / ADCCAPTURE_MS_PER_SECOND;
+  while (globalTimer_getTimerValue() < endTime)
+    adcCapture_poll();
+  adcCapture_stop();
+  uint32_t sampleRate = (uint32_t) ((u64) adcCapture_getSampleCount() * ADCCAPTURE_MS_PER_SECOND / ADCCAPTURE_TEST_MS);
+  printf("adcCapture_runTest: %ld samples/s (expected about %ld), %ld blocks, %ld overruns, mean sample %ld.\n\r",
+         (long) sampleRate, (long) ADCCAPTURE_SAMPLE_RATE_HZ, (long) testBlockCount, (long) adcCapture_getOverrunCount(),
+         (long) (testBlockCount ? testSampleSum / (testBlockCount * ADCCAPTURE_BLOCK_SIZE) : 0));
+  printf("adcCapture_runTest: %s\n\r", testBlockCount && !adcCapture_getOverrunCount() ? "PASSED" : "FAILED");
+}
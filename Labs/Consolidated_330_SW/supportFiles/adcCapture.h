@@ -0,0 +1,58 @@
+/*
+ * adcCapture.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef ADCCAPTURE_H_
+#define ADCCAPTURE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Block capture of XADC auxiliary channel 14 at the full conversion rate (about 960 kSPS).
+// The XADC interrupt is not wired to the GIC in this hardware design and there is no DMA engine, so CPU1
+// does the DMA's job: adcCapture_start() posts a long-running AMP job that polls the latched
+// end-of-conversion bit, reads each conversion and fills fixed-size blocks in DDR.
+// Filled blocks are handed to CPU0 in order through a ring of ADCCAPTURE_BLOCK_COUNT blocks
+// (2 = classic double buffering). CPU0 calls adcCapture_poll() from main (e.g., a scheduler task) and
+// gets one callback per block. If CPU0 falls behind and every block is full, CPU1 drops samples and
+// counts them as overruns rather than overwriting a block the callback may still be reading.
+// The timer ISR does no ADC work. CPU1 is busy until adcCapture_stop(), so no other AMP jobs can run
+// during a capture.
+
+#define ADCCAPTURE_BLOCK_SIZE 1024                // Samples per block.
+#define ADCCAPTURE_BLOCK_COUNT 8                  // Blocks in the ring. Must be a power of two, at least 2.
+#define ADCCAPTURE_SAMPLE_RATE_HZ (100000000 / 4 / 26)  // 100 MHz AXI clock / XADC clock divider / 26 ADC clocks per conversion.
+#define ADCCAPTURE_STATUS_OK 1                    // Returned by adcCapture_start() when CPU1 is capturing.
+#define ADCCAPTURE_STATUS_FAIL 0                  // Returned by adcCapture_start() if CPU1 is not running or busy.
+
+// Called from adcCapture_poll() with each filled block, oldest first. samples holds 12-bit values
+// (the noisy lower 4 bits are shifted out, as in interrupts_getAdcData()). The block is recycled on return.
+typedef void (*adcCapture_blockCallback_t)(const uint16_t* samples, uint32_t count);
+
+// Starts capturing on CPU1. Only every decimation-th conversion is kept (1 keeps them all), so the block
+// rate is ADCCAPTURE_SAMPLE_RATE_HZ / decimation / ADCCAPTURE_BLOCK_SIZE.
+// Requires amp_init() to have succeeded. Returns ADCCAPTURE_STATUS_OK or ADCCAPTURE_STATUS_FAIL.
+int adcCapture_start(adcCapture_blockCallback_t callback, uint32_t decimation);
+
+// Stops the capture and waits for CPU1 to finish its job. Blocks still in the ring are discarded.
+void adcCapture_stop();
+
+// True between adcCapture_start() and adcCapture_stop().
+bool adcCapture_isRunning();
+
+// Hands every filled block to the callback. Returns the number of blocks delivered.
+uint32_t adcCapture_poll();
+
+// Samples kept since adcCapture_start(), including any dropped as overruns.
+uint32_t adcCapture_getSampleCount();
+
+// Samples dropped because every block was full.
+uint32_t adcCapture_getOverrunCount();
+
+// Captures for a short while, then prints the measured sample rate, block count and overruns.
+void adcCapture_runTest();
+
+#endif /* ADCCAPTURE_H_ */
@@ -0,0 +1,283 @@
+/*
+ * amp.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "amp.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef AMP_HOST_PTHREAD
+#include <pthread.h>
+#else
+#include "xparameters.h"
+#include "xil_io.h"
+#include "xil_mmu.h"
+#include "xil_cache.h"
+#include "xpseudo_asm.h"
+#include "xscugic_hw.h"
+#include "xstatus.h"
+#include "interrupts.h"
+#endif
+
+#define AMP_MAILBOX_BASE_ADDR 0xFFFF0000    // Start of high OCM (ps7_ram_1). lscript.ld places nothing here.
+#define AMP_CPU1_STACK_TOP_LOWER "0x8000"   // CPU1 stack grows down from 0xFFFF8000 (~32 KB above the mailbox).
+#define AMP_CPU1_STACK_TOP_UPPER "0xFFFF"   // Upper half of the CPU1 stack address (movw/movt avoids a literal pool).
+#define AMP_CPU1_START_ADDR_REG 0xFFFFFFF0  // The boot ROM parks CPU1 in WFE and jumps to the address stored here.
+#define AMP_OCM_UNCACHED_ATTRIBUTES 0x14de2 // Section attributes: S=1 TEX=100 AP=11 Domain=1111 C=0 B=0 (shared, non-cacheable).
+#define AMP_JOB_DONE_SGI_ID 15              // Software-generated interrupt that CPU1 raises on CPU0 when a job finishes.
+#define AMP_SGI_TARGET_CPU0 0x00010000      // CPU target-list field of the SGI trigger register (CPU0 only).
+#define AMP_CPU1_READY_MAGIC 0xC0DE0001     // CPU1 writes this into the mailbox once its worker loop is running.
+#define AMP_CPU1_WAKE_TIMEOUT 10000000      // Polls of the ready word before amp_init() gives up on CPU1.
+
+#define AMP_TEST_JOB_COUNT 10          // Number of jobs posted by amp_runTest().
+#define AMP_TEST_TERMS_PER_JOB 1000    // Each test job sums this many terms.
+
+// Mailbox states. CPU0 moves idle->posted and done->idle. The worker moves posted->running->done.
+typedef enum {amp_idle_st, amp_posted_st, amp_running_st, amp_done_st} amp_mailboxState_t;
+
+// Shared between the cores. All fields are written by exactly one side at a time, as given by state.
+typedef struct {
+  uint8_t data[AMP_MAILBOX_DATA_SIZE];  // Job arguments in, results out. Kept first so it is word aligned.
+  volatile amp_jobFunction_t job;       // Function the worker runs on data.
+  volatile uint32_t state;              // One of amp_mailboxState_t.
+  volatile uint32_t cpu1Ready;          // AMP_CPU1_READY_MAGIC once the worker loop is running.
+  volatile uint32_t completedJobCount;  // Written by the worker only.
+} amp_mailbox_t;
+
+// Until amp_init() succeeds, jobs run inline on CPU0 out of this DDR copy of the mailbox.
+static amp_mailbox_t inlineMailbox;
+static amp_mailbox_t* mailbox = &inlineMailbox;
+static bool cpu1RunningFlag = false;
+static volatile uint32_t jobDoneInterruptCount = 0;
+
+#ifdef AMP_HOST_PTHREAD
+// ******************************** Host stand-in ********************************
+static pthread_t workerThread;
+static pthread_mutex_t mailboxLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobPostedCondition = PTHREAD_COND_INITIALIZER;
+
+#define amp_lock() pthread_mutex_lock(&mailboxLock)
+#define amp_unlock() pthread_mutex_unlock(&mailboxLock)
+#define amp_publish()                                      // The mutex orders the mailbox writes.
+#define amp_wakeCpu1() pthread_cond_signal(&jobPostedCondition)
+
+// Stands in for CPU1. Bumping jobDoneInterruptCount stands in for the SGI.
+static void* amp_hostWorkerLoop(void* arg) {
+  amp_lock();
+  mailbox->cpu1Ready = AMP_CPU1_READY_MAGIC;
+  while (1) {
+    while (mailbox->state != amp_posted_st)
+      pthread_cond_wait(&jobPostedCondition, &mailboxLock);
+    mailbox->state = amp_running_st;
+    amp_unlock();
+    mailbox->job(mailbox->data);  // Run the job without holding the lock so CPU0 can poll.
+    amp_lock();
+    mailbox->completedJobCount++;
+    mailbox->state = amp_done_st;
+    jobDoneInterruptCount++;
+  }
+  return NULL;
+}
+
+int amp_init(bool printFailedStatusFlag) {
+  if (pthread_create(&workerThread, NULL, amp_hostWorkerLoop, NULL)) {
+    if (printFailedStatusFlag)
+      printf("amp_init: could not start the worker thread.\n\r");
+    return AMP_STATUS_FAIL;
+  }
+  cpu1RunningFlag = true;
+  return AMP_STATUS_OK;
+}
+
+#else
+// ******************************** ZYBO (CPU0 + CPU1) ****************************
+#define amp_lock()
+#define amp_unlock()
+#define amp_publish() dmb()                                // Data and job must land before the state word.
+#define amp_wakeCpu1() do {dsb(); __asm__ __volatile__("sev");} while (0)
+
+// amp_cpu1Entry() branches here by name. The board build compiles this file as C++, so give the worker
+// C linkage; a static (or C++-mangled) symbol would not match the name in the asm and would not link.
+#ifdef __cplusplus
+extern "C" void amp_cpu1WorkerLoop();
+#endif
+
+// CPU1 runs this with its MMU and D-cache off, so everything it touches goes straight to memory.
+// It must not call printf() or anything else that is not reentrant.
+void __attribute__((used)) amp_cpu1WorkerLoop() {
+  amp_mailbox_t* sharedMailbox = (amp_mailbox_t*) AMP_MAILBOX_BASE_ADDR;
+  sharedMailbox->cpu1Ready = AMP_CPU1_READY_MAGIC;
+  while (1) {
+    while (sharedMailbox->state != amp_posted_st)
+      __asm__ __volatile__("wfe");  // CPU0 executes SEV after posting.
+    sharedMailbox->state = amp_running_st;
+    sharedMailbox->job(sharedMailbox->data);
+    sharedMailbox->completedJobCount++;
+    dmb();
+    sharedMailbox->state = amp_done_st;
+    dsb();
+    // Raise the job-done SGI on CPU0 only.
+    Xil_Out32(XPAR_PS7_SCUGIC_0_DIST_BASEADDR + XSCUGIC_SFI_TRIG_OFFSET, AMP_SGI_TARGET_CPU0 | AMP_JOB_DONE_SGI_ID);
+  }
+}
+
+// CPU1 leaves the boot ROM here in SVC mode with interrupts masked and the MMU off.
+// Invalidate and enable its I-cache (legal with the MMU off), give it a stack in OCM and run the worker loop.
+static void __attribute__((naked, used)) amp_cpu1Entry() {
+  __asm__ __volatile__(
+    "mov r0, #0\n\t"
+    "mcr p15, 0, r0, c7, c5, 0\n\t"    // ICIALLU
+    "mrc p15, 0, r0, c1, c0, 0\n\t"    // SCTLR
+    "orr r0, r0, #0x1000\n\t"          // SCTLR.I
+    "mcr p15, 0, r0, c1, c0, 0\n\t"
+    "isb\n\t"
+    "movw r0, #" AMP_CPU1_STACK_TOP_LOWER "\n\t"
+    "movt r0, #" AMP_CPU1_STACK_TOP_UPPER "\n\t"
+    "mov sp, r0\n\t"
+    "b amp_cpu1WorkerLoop\n\t");
+}
+
+// CPU0 side of the SGI. Callers poll the mailbox state; this just counts so the path can be verified.
+static void amp_jobDoneIsr(void* callBackRef) {
+  jobDoneInterruptCount++;
+}
+
+// Wakes CPU1 and waits for it to report in.
+int amp_init(bool printFailedStatusFlag) {
+  amp_mailbox_t* sharedMailbox = (amp_mailbox_t*) AMP_MAILBOX_BASE_ADDR;
+  // CPU1 does not snoop CPU0's D-cache, so the mailbox must not be cached on CPU0 either.
+  Xil_SetTlbAttributes(AMP_MAILBOX_BASE_ADDR, AMP_OCM_UNCACHED_ATTRIBUTES);
+  memset(sharedMailbox, 0, sizeof(amp_mailbox_t));
+  sharedMailbox->state = amp_idle_st;
+  if (interrupts_connectSoftwareInterrupt(AMP_JOB_DONE_SGI_ID, amp_jobDoneIsr, NULL) != XST_SUCCESS) {
+    if (printFailedStatusFlag)
+      printf("amp_init: could not connect the job-done SGI.\n\r");
+    return AMP_STATUS_FAIL;
+  }
+  // CPU1 fetches code and constants straight from DDR. Make sure they are there.
+  Xil_DCacheFlush();
+  Xil_Out32(AMP_CPU1_START_ADDR_REG, (u32) amp_cpu1Entry);
+  amp_wakeCpu1();
+  uint32_t polls = 0;
+  while (sharedMailbox->cpu1Ready != AMP_CPU1_READY_MAGIC) {
+    if (++polls >= AMP_CPU1_WAKE_TIMEOUT) {
+      if (printFailedStatusFlag)
+        printf("amp_init: CPU1 did not start, jobs will run on CPU0.\n\r");
+      return AMP_STATUS_FAIL;
+    }
+  }
+  mailbox = sharedMailbox;
+  cpu1RunningFlag = true;
+  return AMP_STATUS_OK;
+}
+#endif
+
+// True if CPU1 is up and jobs are being run there.
+bool amp_isCpu1Running() {
+  return cpu1RunningFlag;
+}
+
+// Copies the job data into the mailbox and hands the job to CPU1 (or runs it here if CPU1 is not running).
+bool amp_postJob(amp_jobFunction_t job, const void* data, uint32_t size) {
+  if (size > AMP_MAILBOX_DATA_SIZE)
+    return false;
+  amp_lock();
+  if (mailbox->state != amp_idle_st) {
+    amp_unlock();
+    return false;
+  }
+  memcpy(mailbox->data, data, size);
+  mailbox->job = job;
+  if (!cpu1RunningFlag) {
+    job(mailbox->data);
+    mailbox->state = amp_done_st;
+    amp_unlock();
+    return true;
+  }
+  amp_publish();
+  mailbox->state = amp_posted_st;
+  amp_unlock();
+  amp_wakeCpu1();
+  return true;
+}
+
+// True if no job is outstanding.
+bool amp_isIdle() {
+  amp_lock();
+  bool idle = mailbox->state == amp_idle_st;
+  amp_unlock();
+  return idle;
+}
+
+// True once the posted job has finished.
+bool amp_isJobDone() {
+  amp_lock();
+  bool done = mailbox->state == amp_done_st;
+  amp_unlock();
+  return done;
+}
+
+// Copies the results out and frees the mailbox for the next job.
+bool amp_collectResult(void* data, uint32_t size) {
+  if (size > AMP_MAILBOX_DATA_SIZE)
+    return false;
+  amp_lock();
+  if (mailbox->state != amp_done_st) {
+    amp_unlock();
+    return false;
+  }
+  memcpy(data, mailbox->data, size);
+  mailbox->state = amp_idle_st;
+  amp_unlock();
+  return true;
+}
+
+uint32_t amp_getJobDoneInterruptCount() {
+  return jobDoneInterruptCount;
+}
+
+// ******************************** Test ******************************************
+// Test job: sums the integers firstTerm .. firstTerm + termCount - 1.
+typedef struct {
+  uint32_t firstTerm;
+  uint32_t termCount;
+  uint32_t sum;
+} ampTest_sumJob_t;
+
+static void ampTest_sumJob(void* data) {
+  ampTest_sumJob_t* sumJob = (ampTest_sumJob_t*) data;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < sumJob->termCount; i++)
+    sum += sumJob->firstTerm + i;
+  sumJob->sum = sum;
+}
+
+// Posts AMP_TEST_JOB_COUNT jobs, one at a time, and checks each result. Counts how many
+// polls CPU0 got in while waiting to show that it stays free while CPU1 works.
+void amp_runTest() {
+  printf("amp_runTest: jobs running on %s.\n\r", cpu1RunningFlag ? "CPU1" : "CPU0 (inline)");
+  uint32_t startingInterruptCount = jobDoneInterruptCount;
+  uint32_t failures = 0;
+  for (uint32_t i = 0; i < AMP_TEST_JOB_COUNT; i++) {
+    ampTest_sumJob_t sumJob = {.firstTerm = i, .termCount = AMP_TEST_TERMS_PER_JOB, .sum = 0};
+    if (!amp_postJob(ampTest_sumJob, &sumJob, sizeof(sumJob))) {
+      printf("amp_runTest: post of job %ld failed.\n\r", (long) i);
+      failures++;
+      continue;
+    }
+    uint32_t polls = 0;
+    while (!amp_collectResult(&sumJob, sizeof(sumJob)))
+      polls++;
+    uint32_t expected = AMP_TEST_TERMS_PER_JOB * i + (AMP_TEST_TERMS_PER_JOB * (AMP_TEST_TERMS_PER_JOB - 1)) / 2;
+    if (sumJob.sum != expected) {
+      printf("amp_runTest: job %ld expected %ld, got %ld.\n\r", (long) i, (long) expected, (long) sumJob.sum);
+      failures++;
+    }
+    printf("amp_runTest: job %ld done after %ld polls.\n\r", (long) i, (long) polls);
+  }
+  printf("amp_runTest: job-done interrupts taken: %ld.\n\r", (long) (jobDoneInterruptCount - startingInterruptCount));
+  printf("amp_runTest: %s\n\r", failures ? "FAILED" : "PASSED");
+}
@@ -0,0 +1,64 @@
+/*
+ * amp.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef AMP_H_
+#define AMP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Asymmetric multi-processing (AMP) service. Everything normally runs on CPU0.
+// amp_init() wakes CPU1 and parks it in a small worker loop that waits on a mailbox
+// in on-chip memory (OCM). CPU0 posts a job (function + data) to the mailbox and keeps
+// ticking its state machines; CPU1 runs the job, writes the result back into the
+// mailbox and raises a software-generated interrupt (SGI) on CPU0.
+// Only one job can be outstanding at a time.
+//
+// Define AMP_HOST_PTHREAD to build the host stand-in: CPU1 is replaced by a pthread and
+// the SGI by a flag set from that thread. The API is identical.
+
+#define AMP_STATUS_OK 1    // Returned by amp_init() when CPU1 is up and waiting for jobs.
+#define AMP_STATUS_FAIL 0  // Returned by amp_init() when CPU1 did not answer.
+
+#define AMP_MAILBOX_DATA_SIZE 64  // Bytes of job data (arguments in, results out) carried by the mailbox.
+#define AMP_OCM_SHARED_ADDR 0xFFFF8000  // Uncached OCM above CPU1's stack, for state a long-running job shares with CPU0.
+#define AMP_OCM_SHARED_SIZE 0x7F00      // Bytes available there (the top of OCM holds the CPU1 start-address register).
+
+// Jobs are plain functions that work in place on the mailbox data.
+// The function must only touch the data it is handed and its own stack (CPU1 runs with its data cache off).
+typedef void (*amp_jobFunction_t)(void* data);
+
+// Wakes CPU1 and waits for it to report in. Call after interrupts_initAll() so that the
+// job-done SGI can be connected. If amp_init() is never called (or fails), jobs run inline
+// on CPU0 when they are posted, so callers never need a separate code path.
+// if printFailedStatusFlag is true, it prints out diagnostic messages if something goes awry.
+int amp_init(bool printFailedStatusFlag);
+
+// True if CPU1 is up and jobs are being run there.
+bool amp_isCpu1Running();
+
+// Copies size bytes of data into the mailbox and hands the job to CPU1.
+// Returns false if a job is already outstanding or the data does not fit.
+bool amp_postJob(amp_jobFunction_t job, const void* data, uint32_t size);
+
+// True if no job is outstanding (a finished job counts as outstanding until it is collected).
+bool amp_isIdle();
+
+// True once the posted job has finished and its results are ready to collect.
+bool amp_isJobDone();
+
+// Copies size bytes of the finished job's data out of the mailbox and frees the mailbox.
+// Returns false (and copies nothing) if the job has not finished yet.
+bool amp_collectResult(void* data, uint32_t size);
+
+// Number of job-done interrupts CPU0 has taken. Handy for checking that the SGI path works.
+uint32_t amp_getJobDoneInterruptCount();
+
+// Posts a few jobs and checks the results. Prints the outcome.
+void amp_runTest();
+
+#endif /* AMP_H_ */
@@ -7,192 +7,288 @@
 
 #include "supportFiles/bluetooth.h"
 #include <Xuartlite.h>
+#include "xuartlite_l.h"   // Register-level access for the ISR.
 #include <xparameters.h>
 #include <stdio.h>
+#include "xil_exception.h"
+#include "xpseudo_asm.h"
+#include "xuartps_hw.h"
+#include "interrupts.h"
+#include "spscRing.h"
 
 static XUartLite bluetooth_uartInstance;        // Handle to the bluetooth UART.
 static XUartLite_Config bluetooth_uartConfig;   // Handle to the bluetooth UART config.
 
-// This implements a dedicated buffer for storing values from the ADC
-// until they are read and processed by detector().
-// adcBuffer_t is similar to a queue.
-#define BLUETOOTH_QUEUE_SIZE 1000
-#define BLUETOOTH_UART_FIFO_SIZE 16
-typedef struct {
-    uint16_t indexIn;   // New values go here.
-    uint16_t indexOut;  // Pull old values from here.
-    uint8_t data[BLUETOOTH_QUEUE_SIZE];  // Store values here.
-    uint16_t elementCount;  // Number of values contained in adcBuffer_t.
-    uint16_t size;          // queue can hold this many elements.
-} bluetooth_queue_t;
-
-static bluetooth_queue_t bluetooth_receiveQueue;   // characters read from the bluetooth UART go here.
-static bluetooth_queue_t bluetooth_transmitQueue;  // characters that need to be transmitted to the bluetooth UART go here.
-
-// Init the q.
-void bluetooth_queueInit(bluetooth_queue_t* q, uint16_t size) {
-    q->indexIn = 0;
-    q->indexOut = 0;
-    q->elementCount = 0;
-    q->size = size;
-}
-
-// Implemented as a fixed-size circular buffer.
-// indexIn always points to an empty location (by definition).
-// indexOut always points to the oldest element.
-// buffer is empty if indexIn == indexOut. Buffer is full if incremented indexIn == indexOut
-void bluetooth_queuePush(bluetooth_queue_t* q, uint8_t data) {
-    if (q->elementCount < q->size)  // Increment the element count unless you are already full.
-        q->elementCount++;
-    q->data[q->indexIn] = data;                    // write,
-    q->indexIn = (q->indexIn + 1) % q->size;  // then increment.
-    if (q->indexIn == q->indexOut) {                  // If you are now pointing at the out pointer,
-        q->indexOut = (q->indexOut + 1) % q->size;  // move the out pointer up.
-    }
-}
+#define BLUETOOTH_UART_BASEADDR XPAR_BLUETOOTH_UARTLITE_0_BASEADDR
+// The UART interrupt only exists if the hardware platform routes it to the GIC.
+#ifdef XPAR_FABRIC_BLUETOOTH_UARTLITE_0_INTERRUPT_INTR
+#define BLUETOOTH_UART_INTR XPAR_FABRIC_BLUETOOTH_UARTLITE_0_INTERRUPT_INTR
+#endif
 
-// Removes a single item from the ADC buffer.
-// Does not signal an error if the ADC buffer is currently
-// empty. Simply returns a default value of 0 if the buffer is currently empty.
-uint8_t bluetooth_queuePop(bluetooth_queue_t* q) {
-    uint8_t returnValue = 0;
-    if (q->indexIn == q->indexOut)  // Just return 0 if empty.
-        return 0;
-    else {
-        returnValue = q->data[q->indexOut];  // Not empty, get the return value from buffer.
-        q->indexOut = (q->indexOut + 1) % q->size;  // increment the out index.
-        q->elementCount--;  // One less element.
-    }
-    return returnValue;
-}
+// Received characters are pushed by the UART ISR (or bluetooth_poll()) and popped by the user;
+// transmitted characters go the other way. Each queue has one producer and one consumer, so
+// spscRing needs no interrupt masking, except where overwrite and stall make the ISR touch both ends.
+#define BLUETOOTH_QUEUE_SIZE 1024   // Must be a power of two.
+#define BLUETOOTH_LINE_SIZE 128     // Longest line bluetooth_interactiveLoop() sends.
+
+static spscRing_t bluetooth_receiveQueue;   // characters read from the bluetooth UART go here.
+static spscRing_t bluetooth_transmitQueue;  // characters that need to be transmitted to the bluetooth UART go here.
+static uint8_t bluetooth_receiveStorage[BLUETOOTH_QUEUE_SIZE];
+static uint8_t bluetooth_transmitStorage[BLUETOOTH_QUEUE_SIZE];
 
-// Provides read access to all elements in the ADC buffer.
-// No error messages are provided. In cases of error, a 0 is returned.
-// index = 0 indexes the oldest data in the queue.
-uint32_t bluetooth_queueReadElementAt(bluetooth_queue_t* q, uint32_t index) {
-  // Just return 0 if there if the buffer is empty or not enough elements for the index.
-  if ((q->indexIn == q->indexOut) || (index + 1 > q->elementCount))
-    return 0;
-  // Otherwise, there are enough elements, just do modulo addressing.
-  return q->data[(q->indexOut + index) % q->size];
+static bool bluetooth_interruptDriven;      // True once the UART interrupt is connected.
+static volatile bluetooth_backpressure_t bluetooth_backpressure = bluetooth_backpressure_dropNewest;
+static volatile bool bluetooth_rxStalled;   // Stall left characters in the UART FIFO for want of room.
+static volatile uint32_t bluetooth_rxLostCount;
+static volatile uint32_t bluetooth_rxOverrunCount;
+static volatile uint32_t bluetooth_rxOverwriteCount;    // Characters the ISR removed from the receive queue.
+static uint32_t bluetooth_rxPeekOverwriteCount;         // bluetooth_rxOverwriteCount at the last peek.
+
+// Masks IRQs around the few places where the user side and the ISR both touch a queue.
+// Returns the CPSR to restore, so this also works when called from inside an ISR.
+static uint32_t bluetooth_enterCritical() {
+    uint32_t cpsr = mfcpsr();
+    Xil_ExceptionDisable();
+    return cpsr;
 }
 
+static void bluetooth_exitCritical(uint32_t cpsr) {
+    mtcpsr(cpsr);
+}
 
-// Functional interface to access element count.
-uint16_t bluetooth_queueElementCount(bluetooth_queue_t* q) {
-    return q->elementCount;
+// Reads the UART status register. Reading clears the overrun flag, so it is counted here.
+static uint32_t bluetooth_readStatus() {
+    uint32_t status = XUartLite_GetStatusReg(BLUETOOTH_UART_BASEADDR);
+    if (status & XUL_SR_OVERRUN_ERROR)
+        bluetooth_rxOverrunCount++;
+    return status;
 }
 
-// Check if the queue is empty.
-bool bluetooth_queueEmpty(bluetooth_queue_t* q) {
-    return (q->indexIn == q->indexOut);
+// Moves characters from the UART receive FIFO straight into the receive queue until the FIFO is empty
+// (or, under stall, the queue is full). Only the ISR or bluetooth_poll() side calls this, or the user
+// side with interrupts masked.
+static void bluetooth_serviceRx() {
+    while (bluetooth_readStatus() & XUL_SR_RX_FIFO_VALID_DATA) {
+        void* span;
+        uint32_t room = spscRing_writeSpan(&bluetooth_receiveQueue, &span);
+        if (!room) {
+            if (bluetooth_backpressure == bluetooth_backpressure_stall) {
+                bluetooth_rxStalled = true;     // Leave the rest in the FIFO until the user makes room.
+                return;
+            }
+            bluetooth_rxLostCount++;
+            if (bluetooth_backpressure == bluetooth_backpressure_dropNewest) {
+                XUartLite_ReadReg(BLUETOOTH_UART_BASEADDR, XUL_RX_FIFO_OFFSET);  // Throw the character away.
+                continue;
+            }
+            // Overwrite: the ISR takes the consumer's part for one character. The user side masks
+            // interrupts whenever it moves the tail in this mode.
+            spscRing_discard(&bluetooth_receiveQueue, 1);
+            bluetooth_rxOverwriteCount++;
+            room = spscRing_writeSpan(&bluetooth_receiveQueue, &span);
+        }
+        uint8_t* received = (uint8_t*) span;
+        uint32_t count = 0;
+        do {
+            received[count++] = XUartLite_ReadReg(BLUETOOTH_UART_BASEADDR, XUL_RX_FIFO_OFFSET);
+        } while (count < room && (bluetooth_readStatus() & XUL_SR_RX_FIFO_VALID_DATA));
+        spscRing_commit(&bluetooth_receiveQueue, count);
+    }
+    bluetooth_rxStalled = false;
 }
 
-// Check if the queue is full.
-bool bluetooth_queueFull(bluetooth_queue_t* q) {
-    return !(q->elementCount < q->size);
+// Moves characters from the transmit queue straight into the UART transmit FIFO until it is full.
+// The UART interrupts again when the FIFO empties, which sends the rest.
+static void bluetooth_serviceTx() {
+    void* span;
+    uint32_t count;
+    while ((count = spscRing_readSpan(&bluetooth_transmitQueue, &span))) {
+        const uint8_t* queued = (const uint8_t*) span;
+        uint32_t sent = 0;
+        while (sent < count && !(bluetooth_readStatus() & XUL_SR_TX_FIFO_FULL))
+            XUartLite_WriteReg(BLUETOOTH_UART_BASEADDR, XUL_TX_FIFO_OFFSET, queued[sent++]);
+        spscRing_discard(&bluetooth_transmitQueue, sent);
+        if (sent < count)
+            return;
+    }
 }
 
-uint16_t bluetooth_queueSize(bluetooth_queue_t* q) {
-    return q->size;
+#ifdef BLUETOOTH_UART_INTR
+// UART ISR: fires when the receive FIFO gets a character or the transmit FIFO empties.
+static void bluetooth_isr(void* callBackRef) {
+    bluetooth_serviceRx();
+    bluetooth_serviceTx();
 }
+#endif
 
 // Used to initialize any bluetooth data structures.
 // Must be called before accessing any of the bluetooth_ routines.
 int bluetooth_init() {
-    bluetooth_queueInit(&bluetooth_receiveQueue, BLUETOOTH_QUEUE_SIZE);  // init the receive q.
-    bluetooth_queueInit(&bluetooth_transmitQueue, BLUETOOTH_QUEUE_SIZE); // init the transmit q.
+    spscRing_init(&bluetooth_receiveQueue, bluetooth_receiveStorage, sizeof(uint8_t), BLUETOOTH_QUEUE_SIZE);    // init the receive q.
+    spscRing_init(&bluetooth_transmitQueue, bluetooth_transmitStorage, sizeof(uint8_t), BLUETOOTH_QUEUE_SIZE);  // init the transmit q.
     // Init the bluetooth UART.
-    int status = XUartLite_CfgInitialize(&bluetooth_uartInstance, &bluetooth_uartConfig, XPAR_BLUETOOTH_UARTLITE_0_BASEADDR);
+    int status = XUartLite_CfgInitialize(&bluetooth_uartInstance, &bluetooth_uartConfig, BLUETOOTH_UART_BASEADDR);
     if (status != XST_SUCCESS) {
         printf("bluetooth_init(): Unable to initialize bluetooth UART\n\r.");
         return BLUETOOTH_INIT_STATUS_FAIL;
     }
+    bluetooth_interruptDriven = false;
+#ifdef BLUETOOTH_UART_INTR
+    // The ISR reads and writes the FIFOs itself, so the driver's buffered interrupt handler is not used.
+    // The UART Lite pulses its interrupt for each RX character and TX-empty, so it must be edge-triggered.
+    if (interrupts_connectDeviceInterrupt(BLUETOOTH_UART_INTR, INTERRUPTS_TRIGGER_RISING_EDGE, bluetooth_isr, NULL)
+            == XST_SUCCESS) {
+        XUartLite_EnableIntr(BLUETOOTH_UART_BASEADDR);
+        bluetooth_interruptDriven = true;
+    }
+#endif
+    if (!bluetooth_interruptDriven)
+        printf("bluetooth_init(): UART interrupt not available, call bluetooth_poll().\n\r");
     return BLUETOOTH_INIT_STATUS_OK;
 }
 
-// Writes data to the bluetooth modem via the bluetooth_UART.
-// Returns the number of characters written.
-// Nonblocking.
-// Can be data or commands. Switch on bluetooth modem board determines whether is interpreted as data or commands.
-uint16_t bluetooth_uartWrite(uint8_t* data, uint16_t size) {
-    return XUartLite_Send(&bluetooth_uartInstance, data, size);
+bool bluetooth_isInterruptDriven() {
+    return bluetooth_interruptDriven;
+}
+
+void bluetooth_setBackpressure(bluetooth_backpressure_t policy) {
+    uint32_t cpsr = bluetooth_enterCritical();
+    bluetooth_backpressure = policy;
+    bluetooth_rxPeekOverwriteCount = bluetooth_rxOverwriteCount;
+    if (bluetooth_rxStalled)    // No longer stalling: let the ISR side empty the FIFO.
+        bluetooth_serviceRx();
+    bluetooth_exitCritical(cpsr);
+}
+
+uint32_t bluetooth_getRxLostCount() {
+    return bluetooth_rxLostCount;
+}
+
+uint32_t bluetooth_getRxOverrunCount() {
+    return bluetooth_rxOverrunCount;
 }
 
-// Reads data from the bluetooth modem via the bluetooth_UART.
-// Returns the number of characters read.
-// Nonblocking.
-uint16_t bluetooth_uartRead(uint8_t* data, uint16_t maxSize) {
-    return XUartLite_Recv(&bluetooth_uartInstance, data, maxSize);
+// Zero-copy receive: the oldest contiguous characters in the receive queue.
+uint32_t bluetooth_rxPeek(const uint8_t** data) {
+    void* span;
+    uint32_t count;
+    if (bluetooth_backpressure != bluetooth_backpressure_overwriteOldest) {
+        count = spscRing_readSpan(&bluetooth_receiveQueue, &span);
+    } else {
+        // The ISR may move the tail: take the span and the overwrite count together.
+        uint32_t cpsr = bluetooth_enterCritical();
+        bluetooth_rxPeekOverwriteCount = bluetooth_rxOverwriteCount;
+        count = spscRing_readSpan(&bluetooth_receiveQueue, &span);
+        bluetooth_exitCritical(cpsr);
+    }
+    *data = (const uint8_t*) span;
+    return count;
+}
+
+// Removes peeked characters, less any the ISR has overwritten since the peek.
+uint32_t bluetooth_rxConsume(uint32_t count) {
+    if (bluetooth_backpressure == bluetooth_backpressure_dropNewest)
+        return spscRing_discard(&bluetooth_receiveQueue, count);
+    uint32_t cpsr = bluetooth_enterCritical();
+    if (bluetooth_backpressure == bluetooth_backpressure_overwriteOldest) {
+        uint32_t overwritten = bluetooth_rxOverwriteCount - bluetooth_rxPeekOverwriteCount;
+        bluetooth_rxPeekOverwriteCount = bluetooth_rxOverwriteCount;
+        count = overwritten < count ? count - overwritten : 0;
+    }
+    count = spscRing_discard(&bluetooth_receiveQueue, count);
+    if (bluetooth_rxStalled)    // The UART won't interrupt for what is already in its FIFO.
+        bluetooth_serviceRx();
+    bluetooth_exitCritical(cpsr);
+    return count;
+}
+
+// Zero-copy transmit: contiguous free space in the transmit queue.
+uint32_t bluetooth_txReserve(uint8_t** data) {
+    void* span;
+    uint32_t count = spscRing_writeSpan(&bluetooth_transmitQueue, &span);
+    *data = (uint8_t*) span;
+    return count;
+}
+
+// Queues reserved characters. The UART only interrupts when its FIFO empties, so an idle UART is started here.
+void bluetooth_txCommit(uint32_t count) {
+    spscRing_commit(&bluetooth_transmitQueue, count);
+    uint32_t cpsr = bluetooth_enterCritical();
+    bluetooth_serviceTx();
+    bluetooth_exitCritical(cpsr);
 }
 
 // Reads characters from the bluetooth buffer. Characters are placed in the
 // bluetooth_receiveQueue by reading the bluetooth UART and pushing them into the queue.
 // Will only read upto maxSize characters. Returns the number of characters read.
 uint16_t bluetooth_receiveQueueRead(uint8_t* data, uint16_t maxSize) {
-    uint16_t bytesRead = 0;
-    // Read the characters unless the receive queue empties.
-    for (uint16_t i=0; i<maxSize && !bluetooth_queueEmpty(&bluetooth_receiveQueue); i++) {
-        data[i] = bluetooth_queuePop(&bluetooth_receiveQueue);
-        bytesRead++;
-    }
-    return bytesRead;   // Let the caller know how many bytes were read.
+    if (bluetooth_backpressure == bluetooth_backpressure_dropNewest)
+        return spscRing_popBulk(&bluetooth_receiveQueue, data, maxSize);   // Let the caller know how many bytes were read.
+    // The ISR may move the tail (overwrite) or be waiting for room (stall): copy with it masked.
+    uint32_t cpsr = bluetooth_enterCritical();
+    uint16_t count = spscRing_popBulk(&bluetooth_receiveQueue, data, maxSize);
+    if (bluetooth_rxStalled)
+        bluetooth_serviceRx();
+    bluetooth_exitCritical(cpsr);
+    return count;
 }
 
 // Writes characters to the bluetooth transmit queue. The characters from the buffer need to be written
 // from the queue to the bluetooth UART. Returns the number of characters written.
 uint16_t bluetooth_transmitQueueWrite(uint8_t* data, uint16_t size) {
-    uint16_t bytesWritten = 0;
     // Write the characters unless the transmit queue fills up.
-    for (uint16_t i=0; i<size && !bluetooth_queueFull(&bluetooth_transmitQueue); i++) {
-        bluetooth_queuePush(&bluetooth_transmitQueue, data[i]);
-        bytesWritten++;
-    }
-    return bytesWritten;    // Let the caller know how many bytes were written.
+    uint16_t written = spscRing_pushBulk(&bluetooth_transmitQueue, data, size);
+    bluetooth_txCommit(0);  // Start the UART if it is idle.
+    return written;     // Let the caller know how many bytes were written.
 }
 
-// Polls the bluetooth for data.
+// Polls the bluetooth for data when the UART interrupt is not connected.
 // Received data from the bluetooth UART are placed in the receive queue.
 // Data in the transmit queue are sent to the bluetooth UART.
 // bluetooth UART only operates at 9600 BAUD, so don't call this more than about every 5 ms or so.
 // Presumed that this will be called in a timer ISR.
 void bluetooth_poll() {
-    // Read characters from the bluetooth UART and copy to the receive queue.
-    uint8_t readData[BLUETOOTH_UART_FIFO_SIZE];
-    // How much room is in the receive queue?
-    uint16_t receiveQueueSpace = bluetooth_queueSize(&bluetooth_receiveQueue) -
-            bluetooth_queueElementCount(&bluetooth_receiveQueue);
-    // Requested number of bytes will be either all the chars in the UART FIFO, or the available space in the recieve queue.
-    uint16_t requestedReadCount = receiveQueueSpace > BLUETOOTH_UART_FIFO_SIZE ? BLUETOOTH_UART_FIFO_SIZE : receiveQueueSpace;
-    // Transfer whatever you read to the receive queue.
-    uint16_t bytesRead = bluetooth_uartRead(readData, requestedReadCount);
-//    if (bytesRead != 0)
-//        printf("received %d bytes.\n\r", bytesRead);
-    for (uint16_t i=0; i<bytesRead; i++)  {
-        bluetooth_queuePush(&bluetooth_receiveQueue, readData[i]);
-    }
-    // Read chars from the transmit queue and send them to the bluetooth UART.
-    // Transmit characters one at a time so you won't have to put anything back into the transmit queue.
-    bool transmitOk = true; // This will be set to false if unable to transmit a byte.
-    uint16_t bytesToTransmit = bluetooth_queueElementCount(&bluetooth_transmitQueue);
-    // Loop will write bytes to the bluetooth UART until the UART is full or all characters are transmitted.
-    for (uint16_t i=0; i<bytesToTransmit && transmitOk; i++) {
-        uint8_t transmitData[1];    // Only transmit one byte at a time.
-        transmitData[0] = bluetooth_queueReadElementAt(&bluetooth_transmitQueue, i);    // Read the byte to be transmitted.
-        uint8_t bytesWritten = bluetooth_uartWrite(transmitData, 1);    // Ask for it to be written.
-        if (bytesWritten == 1) {    // Successful if one byte was written.
-            transmitOk = true;
-            bluetooth_queuePop(&bluetooth_transmitQueue);   // Successfully written so pop the data off the queue.
-        } else {    // Not successful, so terminate.
-            transmitOk = false;
-        }
-    }
+    if (bluetooth_interruptDriven)
+        return;
+    bluetooth_serviceRx();
+    bluetooth_serviceTx();
 }
 
 // Starts an interactive loop that queries the user for input, transmits that input to the bluetooth UART
-// and then prints the result.
+// and prints whatever comes back as it arrives.
 // Useful for configuring the bluetooth modem when in command mode.
 // Terminates if the user types a single "." on a line of input.
 void bluetooth_interactiveLoop() {
+    printf("bluetooth: type a line to send to the modem, or \".\" to quit.\n\r");
+    char line[BLUETOOTH_LINE_SIZE];
+    uint16_t length = 0;
+    while (1) {
+        bluetooth_poll();   // Does nothing when the UART interrupt is connected.
+        // Print what the modem sent straight out of the receive queue.
+        const uint8_t* received;
+        uint32_t receivedCount;
+        while ((receivedCount = bluetooth_rxPeek(&received))) {
+            printf("%.*s", (int) receivedCount, (const char*) received);
+            bluetooth_rxConsume(receivedCount);
+        }
+        // Collect the user's line without blocking, so replies keep printing while they type.
+        if (!XUartPs_IsReceiveData(STDIN_BASEADDRESS))
+            continue;
+        char c = (char) XUartPs_ReadReg(STDIN_BASEADDRESS, XUARTPS_FIFO_OFFSET);
+        if (c != '\r' && c != '\n') {
+            if (length < BLUETOOTH_LINE_SIZE - 1) {
+                line[length++] = c;
+                printf("%c", c);    // Echo.
+            }
+            continue;
+        }
+        printf("\n\r");
+        if (length == 1 && line[0] == '.')
+            return;
+        line[length++] = '\r';  // The modem's commands end with a carriage return.
+        uint16_t sent = 0;
+        while (sent < length)   // Waits only if the transmit queue is full.
+            sent += bluetooth_transmitQueueWrite((uint8_t*) line + sent, length - sent);
+        length = 0;
+    }
 }
-
@@ -14,9 +14,53 @@
 #define BLUETOOTH_INIT_STATUS_FAIL 0
 #define BLUETOOTH_INIT_STATUS_OK 1
 
+// The bluetooth UART is serviced by its own interrupt: received characters go straight from the UART FIFO
+// into the receive queue and the transmit queue is drained into the UART FIFO each time it empties.
+// If the hardware does not route the UART interrupt to the GIC, bluetooth_poll() does the same work
+// and must be called periodically (e.g., from the timer ISR).
+// Both queues are power-of-two spscRings: the ISR is the only producer of one and the only consumer
+// of the other, so the user side only masks interrupts where the backpressure policy requires it.
+
+// What happens to received characters when the receive queue is full.
+typedef enum {
+    bluetooth_backpressure_dropNewest,      // Characters that do not fit are thrown away (the default).
+    bluetooth_backpressure_overwriteOldest, // The oldest characters in the queue are thrown away to make room.
+    bluetooth_backpressure_stall            // Characters wait in the 16-byte UART FIFO until the queue has room;
+                                            // past that the UART overruns.
+} bluetooth_backpressure_t;
+
 // Used to initialize any bluetooth data structures.
+// Call after interrupts_initAll() so the UART interrupt can be connected.
 int bluetooth_init();
 
+// True if the UART interrupt is connected; otherwise bluetooth_poll() must be called.
+bool bluetooth_isInterruptDriven();
+
+// Sets what happens to received characters when the receive queue is full.
+void bluetooth_setBackpressure(bluetooth_backpressure_t policy);
+
+// Received characters lost to backpressure: dropped (dropNewest) or overwritten (overwriteOldest).
+uint32_t bluetooth_getRxLostCount();
+
+// Times the UART receive FIFO overran, losing characters before they were read (mostly under stall).
+uint32_t bluetooth_getRxOverrunCount();
+
+// Zero-copy receive. Points *data at the oldest received characters and returns how many are contiguous
+// (0 if none). They stay queued until bluetooth_rxConsume(). Under overwriteOldest the ISR may overwrite
+// the start of the span while it is being read.
+uint32_t bluetooth_rxPeek(const uint8_t** data);
+
+// Removes count characters seen with bluetooth_rxPeek(). Characters the ISR already overwrote since the
+// peek are not counted twice. Returns the number removed.
+uint32_t bluetooth_rxConsume(uint32_t count);
+
+// Zero-copy transmit. Points *data at free space in the transmit queue and returns how many characters
+// fit there contiguously (0 if the queue is full). Nothing is sent until bluetooth_txCommit().
+uint32_t bluetooth_txReserve(uint8_t** data);
+
+// Queues the first count characters written at bluetooth_txReserve() and starts the UART if it is idle.
+void bluetooth_txCommit(uint32_t count);
+
 // Reads characters from the bluetooth buffer. Characters are placed in the
 // bluetooth_receiveQueue by reading the bluetooth UART and pushing them into the queue.
 // Will only read upto maxSize characters. Returns the number of characters read.
@@ -27,12 +71,13 @@ uint16_t bluetooth_receiveQueueRead(uint8_t* data, uint16_t maxSize);
 uint16_t bluetooth_transmitQueueWrite(uint8_t* data, uint16_t size);
 
 // Starts an interactive loop that queries the user for input, transmits that input to the bluetooth UART
-// and then prints the result.
+// and prints whatever the bluetooth UART sends back as it arrives, without waiting for a line to finish.
 // Useful for configuring the bluetooth modem when in command mode.
 // Terminates if the user types a single "." on a line of input.
+// Without the UART interrupt it polls the UART itself, so don't also call bluetooth_poll() from an ISR meanwhile.
 void bluetooth_interactiveLoop();
 
-// Polls the bluetooth for data.
+// Polls the bluetooth for data when the UART interrupt is not connected (does nothing otherwise).
 // Received data from the bluetooth UART are placed in the receive queue.
 // Data in the transmit queue are sent to the bluetooth UART.
 // bluetooth UART only operates at 9600 BAUD, so don't call this more than about every 5 ms or so.
@@ -53,7 +53,6 @@ uint32_t circularBuffer_size(circularBuffer_t* cb) {
 // to access data in range.
 uint32_t circularBuffer_readDataAt(circularBuffer_t* cb, uint32_t index) {
 	if (cb->wrapAroundFlag) {
-		printf("address->%ld\r\n", (cb->writeIndex + 1 + index) & CIRCULAR_BUFFER_INDEX_MASK);
 		return cb->data[(cb->writeIndex + 1 + index) & CIRCULAR_BUFFER_INDEX_MASK];
 	} else {
 		return cb->data[index & CIRCULAR_BUFFER_INDEX_MASK];
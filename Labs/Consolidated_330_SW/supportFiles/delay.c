@@ -0,0 +1,139 @@
+/*
+ * delay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "delay.h"
+#include "timebase.h"
+#include "interrupts.h"
+#include "xil_exception.h"
+#include <stdio.h>
+
+#define DELAY_WAKE_LEAD_TICKS (2 * TIMEBASE_TICKS_PER_US)  // Wake this early and busy-wait the rest, to hide IRQ latency.
+#define delay_waitForInterrupt() __asm__ __volatile__("wfi")
+
+// Self-test parameters.
+#define TEST_BUSY_TOLERANCE_US 5          // Lateness allowed for a busy-wait (timer reads, a stray interrupt).
+#define TEST_SLEEP_TOLERANCE_US 20        // Lateness allowed for a sleeping delay (wake-up, IRQ entry and exit).
+#define TEST_OLD_MS_LOOP_MULTIPLIER 55310 // The counted loop utils_msDelay() used for 1 ms.
+
+static bool timerStartedFlag = false;     // The global timer must run or no deadline ever expires.
+static uint32_t sleepCount = 0;
+
+// Starts the global timer the first time any delay is used, e.g. by the display drivers at boot.
+static void delay_init() {
+  if (!timerStartedFlag) {
+    timebase_init();
+    timerStartedFlag = true;
+  }
+}
+
+static void delay_busyWaitUntil(timebase_deadline_t deadline) {
+  while (!timebase_isExpired(deadline));
+}
+
+// Sleeps until wake, re-arming after wake-ups by other interrupts. IRQs are masked from the expiry check
+// through WFI so that the comparator cannot fire in between and leave WFI waiting for the next interrupt;
+// a pending IRQ still ends WFI and is taken when IRQs are enabled again.
+static void delay_sleepUntil(timebase_deadline_t wake) {
+  while (1) {
+    Xil_ExceptionDisable();
+    if (timebase_isExpired(wake)) {
+      globalTimer_disarmComparator();  // Still armed if another interrupt woke the last WFI.
+      Xil_ExceptionEnable();
+      return;
+    }
+    globalTimer_armComparator(wake);
+    sleepCount++;
+    delay_waitForInterrupt();
+    Xil_ExceptionEnable();
+  }
+}
+
+void delay_ticks(uint32_t ticks) {
+  delay_init();
+  delay_busyWaitUntil(timebase_nowTicks() + ticks);
+}
+
+void delay_us(uint32_t us) {
+  delay_init();
+  delay_busyWaitUntil(timebase_deadlineInUs(us));
+}
+
+void delay_ms(uint32_t ms) {
+  delay_init();
+  delay_busyWaitUntil(timebase_nowTicks() + (uint64_t) ms * TIMEBASE_TICKS_PER_MS);
+}
+
+void delay_sleepMs(uint32_t ms) {
+  delay_init();
+  timebase_deadline_t deadline = timebase_nowTicks() + (uint64_t) ms * TIMEBASE_TICKS_PER_MS;
+  if (ms > DELAY_SLEEP_MIN_MS && interrupts_isGlobalTimerWakeAvailable())
+    delay_sleepUntil(deadline - DELAY_WAKE_LEAD_TICKS);
+  delay_busyWaitUntil(deadline);
+}
+
+uint32_t delay_getSleepCount() {
+  return sleepCount;
+}
+
+// ******************************** self-test ************************************
+
+static uint32_t failureCount;
+
+// Times one call of delay(length) and checks that it ended no earlier than expectedUs and no later
+// than tolerance after it.
+static void delay_checkDelay(void (*delay)(uint32_t), const char* name, uint32_t length, uint32_t expectedUs,
+                             uint32_t toleranceUs) {
+  uint64_t start = timebase_nowTicks();
+  delay(length);
+  uint64_t elapsedTicks = timebase_nowTicks() - start;
+  uint64_t expectedTicks = timebase_usToTicks(expectedUs);
+  if (elapsedTicks < expectedTicks) {
+    printf("delay_runTest: FAILED %s(%ld) ended %ld ticks early\n\r", name, (long) length,
+           (long) (expectedTicks - elapsedTicks));
+    failureCount++;
+    return;
+  }
+  uint64_t lateUs = timebase_ticksToUs(elapsedTicks - expectedTicks);
+  printf("delay_runTest: %s(%ld): %ld us late\n\r", name, (long) length, (long) lateUs);
+  if (lateUs > toleranceUs) {
+    printf("delay_runTest: FAILED %s(%ld)\n\r", name, (long) length);
+    failureCount++;
+  }
+}
+
+// Times the counted loop that utils_msDelay() used for 1 ms.
+static void delay_reportOldLoop() {
+  uint64_t start = timebase_nowTicks();
+  for (volatile int32_t i = 0; i < TEST_OLD_MS_LOOP_MULTIPLIER; i++);
+  uint64_t elapsedUs = timebase_ticksToUs(timebase_nowTicks() - start);
+  printf("delay_runTest: the old 1 ms loop (%ld iterations) takes %ld us in this build.\n\r",
+         (long) TEST_OLD_MS_LOOP_MULTIPLIER, (long) elapsedUs);
+}
+
+bool delay_runTest() {
+  failureCount = 0;
+  delay_init();
+  static const uint32_t testUs[] = {1, 10, 100, 1000};
+  static const uint32_t testMs[] = {1, 10, 100};
+  for (uint32_t i = 0; i < sizeof(testUs) / sizeof(testUs[0]); i++)
+    delay_checkDelay(delay_us, "delay_us", testUs[i], testUs[i], TEST_BUSY_TOLERANCE_US);
+  delay_checkDelay(delay_ticks, "delay_ticks", TIMEBASE_TICKS_PER_US, 1, TEST_BUSY_TOLERANCE_US);
+  for (uint32_t i = 0; i < sizeof(testMs) / sizeof(testMs[0]); i++)
+    delay_checkDelay(delay_ms, "delay_ms", testMs[i], testMs[i] * 1000, TEST_BUSY_TOLERANCE_US);
+  bool sleepingFlag = interrupts_isGlobalTimerWakeAvailable();
+  printf("delay_runTest: delay_sleepMs() %s.\n\r", sleepingFlag ? "sleeps in WFI" : "busy-waits (interrupts are off)");
+  uint32_t sleepsBefore = delay_getSleepCount();
+  for (uint32_t i = 0; i < sizeof(testMs) / sizeof(testMs[0]); i++)
+    delay_checkDelay(delay_sleepMs, "delay_sleepMs", testMs[i], testMs[i] * 1000, TEST_SLEEP_TOLERANCE_US);
+  if (sleepingFlag && delay_getSleepCount() == sleepsBefore) {
+    printf("delay_runTest: FAILED delay_sleepMs never slept\n\r");
+    failureCount++;
+  }
+  delay_reportOldLoop();
+  printf("delay_runTest: %s\n\r", failureCount ? "FAILED" : "PASSED");
+  return failureCount == 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * delay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Delays timed by the global timer (see timebase.h) instead of counted loops, so their length does not
+// change with compiler flags, caches or the code around them. A delay never ends early; it ends late by
+// the time to read the global timer, plus whatever interrupts take while it waits.
+// utils_msDelay(), utils_microsecondDelay(), spi_delay() and the LCD_delay*() routines are built on these.
+//
+// delay_sleepMs() spends delays longer than DELAY_SLEEP_MIN_MS in WFI, woken by the global-timer
+// comparator, when interrupts_initAll() has run and ARM interrupts are enabled. Otherwise it busy-waits.
+// Interrupts are serviced during either kind of wait.
+
+#define DELAY_SLEEP_MIN_MS 1   // delay_sleepMs() busy-waits for delays up to this long.
+
+// Busy-waits for ticks global-timer ticks (TIMEBASE_TICKS_PER_US per microsecond).
+void delay_ticks(uint32_t ticks);
+
+// Busy-waits for us microseconds.
+void delay_us(uint32_t us);
+
+// Busy-waits for ms milliseconds.
+void delay_ms(uint32_t ms);
+
+// Waits for ms milliseconds, sleeping in WFI when it can (see above).
+void delay_sleepMs(uint32_t ms);
+
+// Number of times delay_sleepMs() has gone to sleep since boot (wake-ups from other interrupts included).
+uint32_t delay_getSleepCount();
+
+// Self-calibration test. Times each kind of delay at several lengths against the global timer and
+// prints the error, checks that none ends early or too late, and prints what the old counted loop in
+// utils_msDelay() actually delivers in this build. Call after interrupts_initAll() with ARM interrupts
+// enabled to check the sleeping path as well. Returns true if every check passed.
+bool delay_runTest();
+
+#endif /* DELAY_H_ */
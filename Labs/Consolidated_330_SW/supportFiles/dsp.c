@@ -0,0 +1,283 @@
+/*
+ * dsp.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "dsp.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DSP_NEON_AVAILABLE true
+#else
+#define DSP_NEON_AVAILABLE false
+#endif
+
+#define DSP_Q15_SHIFT 15                          // Fraction bits of a sample or FIR tap.
+#define DSP_Q15_ROUND (1 << (DSP_Q15_SHIFT - 1))  // Half an LSB, for rounding Q30 products back to Q15.
+#define DSP_Q14_SHIFT 14                          // Fraction bits of a Goertzel coefficient (2*cos(w) needs 2 integer bits).
+#define DSP_Q14_ONE (1 << DSP_Q14_SHIFT)
+#define DSP_ADC_TO_Q15_SCALE 16                   // 12-bit ADC steps to Q15 steps.
+#define DSP_FIR_TAP_GROUP 8                       // Taps per vector step (one int16x8_t).
+#define DSP_FIR_MAX_ABS_TAP_SUM 65535             // Sum of |taps| must stay below 2.0 in Q15.
+#define DSP_GOERTZEL_BIN_GROUP 4                  // Bins per vector step (one int32x4_t).
+#define DSP_PI 3.14159265358979323846
+#define DSP_COSINE_TERMS 8                        // Taylor terms; plenty for Q14 on [0, pi/2].
+
+static bool neonEnabled = DSP_NEON_AVAILABLE;
+
+bool dsp_setNeonEnabled(bool enable) {
+  neonEnabled = enable && DSP_NEON_AVAILABLE;
+  return neonEnabled;
+}
+
+bool dsp_isNeonEnabled() {
+  return neonEnabled;
+}
+
+// Saturates a 32-bit value to Q15.
+static int16_t dsp_saturate(int32_t value) {
+  if (value > INT16_MAX)
+    return INT16_MAX;
+  if (value < INT16_MIN)
+    return INT16_MIN;
+  return (int16_t) value;
+}
+
+// cos(w) for w in [0, pi]. Only used at init time, so it avoids pulling in libm.
+static double dsp_cosine(double w) {
+  bool negate = w > DSP_PI / 2;  // cos(w) = -cos(pi - w) folds w into [0, pi/2].
+  if (negate)
+    w = DSP_PI - w;
+  double term = 1.0, sum = 1.0;
+  for (uint32_t i = 1; i < DSP_COSINE_TERMS; i++) {
+    term *= -w * w / ((2 * i - 1) * (2 * i));
+    sum += term;
+  }
+  return negate ? -sum : sum;
+}
+
+// ******************************** sample conversion ****************************
+
+void dsp_convertAdcSamples(const uint16_t* adcSamples, int16_t* samples, uint32_t count) {
+  uint32_t i = 0;
+#if DSP_NEON_AVAILABLE
+  if (neonEnabled) {
+    int16x8_t midscale = vdupq_n_s16(DSP_ADC_MIDSCALE);
+    for (; i + 8 <= count; i += 8) {
+      int16x8_t value = vreinterpretq_s16_u16(vld1q_u16(adcSamples + i));
+      vst1q_s16(samples + i, vshlq_n_s16(vsubq_s16(value, midscale), 4));
+    }
+  }
+#endif
+  for (; i < count; i++)
+    samples[i] = (int16_t) (((int32_t) adcSamples[i] - DSP_ADC_MIDSCALE) * DSP_ADC_TO_Q15_SCALE);
+}
+
+// ******************************** FIR decimator ********************************
+
+// Dot product of count (a multiple of DSP_FIR_TAP_GROUP) taps and samples. Stays within 32 bits because
+// init limits the sum of |taps|; partial sums may wrap but the total does not.
+static int32_t dsp_firDot(const int16_t* taps, const int16_t* samples, uint32_t count) {
+#if DSP_NEON_AVAILABLE
+  if (neonEnabled) {
+    int32x4_t accumulator = vdupq_n_s32(0);
+    for (uint32_t i = 0; i < count; i += DSP_FIR_TAP_GROUP) {
+      int16x8_t t = vld1q_s16(taps + i);
+      int16x8_t s = vld1q_s16(samples + i);
+      accumulator = vmlal_s16(accumulator, vget_low_s16(t), vget_low_s16(s));
+      accumulator = vmlal_s16(accumulator, vget_high_s16(t), vget_high_s16(s));
+    }
+    int32x2_t sum = vadd_s32(vget_low_s32(accumulator), vget_high_s32(accumulator));
+    return vget_lane_s32(vpadd_s32(sum, sum), 0);
+  }
+#endif
+  uint32_t accumulator = 0;  // Unsigned so wrapping partial sums are well defined.
+  for (uint32_t i = 0; i < count; i++)
+    accumulator += (uint32_t) ((int32_t) taps[i] * samples[i]);
+  return (int32_t) accumulator;
+}
+
+int dsp_firDecimator_init(dsp_firDecimator_t* fir, const int16_t* taps, uint32_t tapCount, uint32_t factor) {
+  uint32_t absTapSum = 0;
+  for (uint32_t i = 0; taps && i < tapCount && i < DSP_FIR_MAX_TAPS; i++)
+    absTapSum += taps[i] < 0 ? -taps[i] : taps[i];
+  if (!taps || !tapCount || tapCount > DSP_FIR_MAX_TAPS || !factor || absTapSum > DSP_FIR_MAX_ABS_TAP_SUM) {
+    printf("dsp_firDecimator_init: bad parameters (%ld taps, factor %ld, |tap| sum %ld).\n\r", (long) tapCount,
+           (long) factor, (long) absTapSum);
+    return DSP_STATUS_FAIL;
+  }
+  fir->paddedTapCount = (tapCount + DSP_FIR_TAP_GROUP - 1) / DSP_FIR_TAP_GROUP * DSP_FIR_TAP_GROUP;
+  memset(fir->reversedTaps, 0, sizeof(fir->reversedTaps));
+  for (uint32_t i = 0; i < tapCount; i++)
+    fir->reversedTaps[fir->paddedTapCount - 1 - i] = taps[i];  // Oldest sample lines up with the last tap.
+  fir->factor = factor;
+  dsp_firDecimator_reset(fir);
+  return DSP_STATUS_OK;
+}
+
+void dsp_firDecimator_reset(dsp_firDecimator_t* fir) {
+  memset(fir->window, 0, sizeof(fir->window));
+  fir->phase = 0;
+}
+
+uint32_t dsp_firDecimator_process(dsp_firDecimator_t* fir, const int16_t* input, uint32_t count, int16_t* output) {
+  if (count > DSP_MAX_BLOCK_SIZE)
+    count = DSP_MAX_BLOCK_SIZE;
+  uint32_t historyCount = fir->paddedTapCount - 1;
+  memcpy(fir->window + historyCount, input, count * sizeof(int16_t));
+  uint32_t outputCount = 0;
+  uint32_t n = fir->phase;
+  // The paddedTapCount samples ending at input[n] start at window[n].
+  for (; n < count; n += fir->factor) {
+    int32_t accumulator = dsp_firDot(fir->reversedTaps, fir->window + n, fir->paddedTapCount);
+    output[outputCount++] = dsp_saturate((accumulator + DSP_Q15_ROUND) >> DSP_Q15_SHIFT);
+  }
+  fir->phase = n - count;
+  memmove(fir->window, fir->window + count, historyCount * sizeof(int16_t));  // Keep the newest samples.
+  return outputCount;
+}
+
+// ******************************** Goertzel bank ********************************
+
+int dsp_goertzelBank_init(dsp_goertzelBank_t* bank, const uint32_t* frequenciesHz, uint32_t binCount,
+                          uint32_t sampleRateHz, uint32_t length) {
+  if (!frequenciesHz || !binCount || binCount > DSP_GOERTZEL_MAX_BINS || !sampleRateHz || !length ||
+      length > DSP_GOERTZEL_MAX_LENGTH) {
+    printf("dsp_goertzelBank_init: bad parameters (%ld bins, length %ld).\n\r", (long) binCount, (long) length);
+    return DSP_STATUS_FAIL;
+  }
+  memset(bank, 0, sizeof(*bank));  // Unused vector lanes get a zero coefficient.
+  bank->binCount = binCount;
+  bank->length = length;
+  for (uint32_t i = 0; i < binCount; i++) {
+    uint32_t k = (uint32_t) (((uint64_t) frequenciesHz[i] * length + sampleRateHz / 2) / sampleRateHz);  // Nearest bin.
+    if (k > length / 2)
+      k = length / 2;
+    double coefficient = 2.0 * dsp_cosine(2.0 * DSP_PI * k / length) * DSP_Q14_ONE;
+    bank->coefficients[i] = (int32_t) (coefficient < 0 ? coefficient - 0.5 : coefficient + 0.5);
+  }
+  return DSP_STATUS_OK;
+}
+
+void dsp_goertzelBank_reset(dsp_goertzelBank_t* bank) {
+  memset(bank->s1, 0, sizeof(bank->s1));
+  memset(bank->s2, 0, sizeof(bank->s2));
+  bank->sampleCount = 0;
+}
+
+// Runs every bin's resonator over count samples: s0 = x + 2*cos(w)*s1 - s2.
+// The state is bounded by length^2/2 full-scale steps, which DSP_GOERTZEL_MAX_LENGTH keeps within 31 bits.
+static void dsp_goertzelIterate(dsp_goertzelBank_t* bank, const int16_t* samples, uint32_t count) {
+#if DSP_NEON_AVAILABLE
+  if (neonEnabled) {
+    for (uint32_t bin = 0; bin < bank->binCount; bin += DSP_GOERTZEL_BIN_GROUP) {
+      int32x4_t coefficient = vld1q_s32(bank->coefficients + bin);
+      int32x4_t s1 = vld1q_s32(bank->s1 + bin);
+      int32x4_t s2 = vld1q_s32(bank->s2 + bin);
+      for (uint32_t i = 0; i < count; i++) {
+        int64x2_t productLow = vmull_s32(vget_low_s32(coefficient), vget_low_s32(s1));
+        int64x2_t productHigh = vmull_s32(vget_high_s32(coefficient), vget_high_s32(s1));
+        int32x4_t feedback = vcombine_s32(vshrn_n_s64(productLow, DSP_Q14_SHIFT), vshrn_n_s64(productHigh, DSP_Q14_SHIFT));
+        int32x4_t s0 = vsubq_s32(vaddq_s32(vdupq_n_s32(samples[i]), feedback), s2);
+        s2 = s1;
+        s1 = s0;
+      }
+      vst1q_s32(bank->s1 + bin, s1);
+      vst1q_s32(bank->s2 + bin, s2);
+    }
+    return;
+  }
+#endif
+  for (uint32_t bin = 0; bin < bank->binCount; bin++) {
+    int32_t coefficient = bank->coefficients[bin];
+    int32_t s1 = bank->s1[bin], s2 = bank->s2[bin];
+    for (uint32_t i = 0; i < count; i++) {
+      int32_t s0 = samples[i] + (int32_t) (((int64_t) coefficient * s1) >> DSP_Q14_SHIFT) - s2;
+      s2 = s1;
+      s1 = s0;
+    }
+    bank->s1[bin] = s1;
+    bank->s2[bin] = s2;
+  }
+}
+
+// Turns the resonator state at the end of a measurement into amplitude squared and restarts.
+static void dsp_goertzelFinish(dsp_goertzelBank_t* bank) {
+  uint64_t lengthSquared = (uint64_t) bank->length * bank->length;
+  for (uint32_t bin = 0; bin < bank->binCount; bin++) {
+    int64_t s1 = bank->s1[bin], s2 = bank->s2[bin];
+    int64_t magnitudeSquared = s1 * s1 + s2 * s2 - ((bank->coefficients[bin] * s1) >> DSP_Q14_SHIFT) * s2;
+    if (magnitudeSquared < 0)  // Rounding of the coefficient, at most a few LSBs.
+      magnitudeSquared = 0;
+    uint64_t power = 4 * (uint64_t) magnitudeSquared / lengthSquared;  // |X|^2 = (A * length / 2)^2 for a sine.
+    bank->power[bin] = power > UINT32_MAX ? UINT32_MAX : (uint32_t) power;
+  }
+  dsp_goertzelBank_reset(bank);
+}
+
+uint32_t dsp_goertzelBank_process(dsp_goertzelBank_t* bank, const int16_t* samples, uint32_t count) {
+  uint32_t measurementCount = 0;
+  while (count) {
+    uint32_t chunk = bank->length - bank->sampleCount;  // Samples left in the current measurement.
+    if (chunk > count)
+      chunk = count;
+    dsp_goertzelIterate(bank, samples, chunk);
+    samples += chunk;
+    count -= chunk;
+    bank->sampleCount += chunk;
+    if (bank->sampleCount == bank->length) {
+      dsp_goertzelFinish(bank);
+      measurementCount++;
+    }
+  }
+  return measurementCount;
+}
+
+uint32_t dsp_goertzelBank_getPower(const dsp_goertzelBank_t* bank, uint32_t bin) {
+  return bin < bank->binCount ? bank->power[bin] : 0;
+}
+
+// ******************************** power ****************************************
+
+uint32_t dsp_blockPower(const int16_t* samples, uint32_t count) {
+  if (!count)
+    return 0;
+  uint64_t sum = 0;
+  uint32_t i = 0;
+#if DSP_NEON_AVAILABLE
+  if (neonEnabled) {
+    int64x2_t accumulator = vdupq_n_s64(0);
+    for (; i + 8 <= count; i += 8) {
+      int16x8_t s = vld1q_s16(samples + i);
+      accumulator = vpadalq_s32(accumulator, vmull_s16(vget_low_s16(s), vget_low_s16(s)));
+      accumulator = vpadalq_s32(accumulator, vmull_s16(vget_high_s16(s), vget_high_s16(s)));
+    }
+    sum = vgetq_lane_s64(accumulator, 0) + vgetq_lane_s64(accumulator, 1);
+  }
+#endif
+  for (; i < count; i++)
+    sum += (uint32_t) ((int32_t) samples[i] * samples[i]);
+  return (uint32_t) (sum / count);
+}
+
+void dsp_powerEstimator_init(dsp_powerEstimator_t* estimator, uint32_t smoothingShift) {
+  estimator->average = 0;
+  estimator->smoothingShift = smoothingShift;
+  estimator->primed = false;
+}
+
+uint32_t dsp_powerEstimator_update(dsp_powerEstimator_t* estimator, const int16_t* samples, uint32_t count) {
+  uint32_t power = dsp_blockPower(samples, count);
+  if (!estimator->primed) {
+    estimator->average = power;
+    estimator->primed = true;
+  } else {
+    int64_t step = ((int64_t) power - estimator->average) / (1 << estimator->smoothingShift);
+    estimator->average = (uint32_t) (estimator->average + step);
+  }
+  return estimator->average;
+}
@@ -0,0 +1,104 @@
+/*
+ * dsp.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef DSP_H_
+#define DSP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Fixed-point block processing for captured ADC samples (see adcCapture.h):
+// 1. dsp_convertAdcSamples() turns 12-bit unipolar ADC values into signed Q15 samples.
+// 2. A FIR decimator low-pass filters and keeps every factor-th output.
+// 3. A Goertzel bank measures the power at a handful of frequencies (tone detection).
+// 4. A power estimator tracks the smoothed mean square of the signal.
+// Samples are Q15 (int16_t, full scale +-1.0). Every function works on whole blocks and keeps its
+// state between calls, so blocks of any length can be fed in as they arrive.
+//
+// The inner loops use NEON when the compiler targets it (the board build passes -mfpu=neon -mfloat-abi=softfp)
+// and portable C otherwise, e.g., on the host. Both paths produce bit-identical results.
+
+#define DSP_MAX_BLOCK_SIZE 1024                   // Longest block any function accepts (one adcCapture block).
+#define DSP_FIR_MAX_TAPS 64                       // Longest FIR filter.
+#define DSP_GOERTZEL_MAX_BINS 8                   // Most frequencies one Goertzel bank watches.
+#define DSP_GOERTZEL_MAX_LENGTH 256               // Longest Goertzel block. Keeps the Q14 state within 32 bits.
+#define DSP_ADC_MIDSCALE 2048                     // 12-bit ADC value that maps to 0.0.
+#define DSP_STATUS_OK 1                           // Returned by the init functions on success.
+#define DSP_STATUS_FAIL 0                         // Returned by the init functions for bad parameters.
+
+// FIR decimator state. Fill it with dsp_firDecimator_init().
+typedef struct {
+  int16_t reversedTaps[DSP_FIR_MAX_TAPS];    // Coefficients, last first, zero-padded in front to paddedTapCount.
+  uint32_t paddedTapCount;                   // Tap count rounded up to a multiple of 8 for the vector loop.
+  uint32_t factor;                           // Keep every factor-th output.
+  uint32_t phase;                            // Inputs still to skip before the next output.
+  int16_t window[DSP_FIR_MAX_TAPS - 1 + DSP_MAX_BLOCK_SIZE];  // History followed by the current block.
+} dsp_firDecimator_t;
+
+// Goertzel bank state. Fill it with dsp_goertzelBank_init().
+typedef struct {
+  uint32_t binCount;                         // Frequencies watched.
+  uint32_t length;                           // Samples per measurement.
+  uint32_t sampleCount;                      // Samples into the current measurement.
+  int32_t coefficients[DSP_GOERTZEL_MAX_BINS];  // 2*cos(w) in Q14.
+  int32_t s1[DSP_GOERTZEL_MAX_BINS];         // Filter state, previous output.
+  int32_t s2[DSP_GOERTZEL_MAX_BINS];         // Filter state, output before that.
+  uint32_t power[DSP_GOERTZEL_MAX_BINS];     // Latest results, amplitude squared in Q30.
+} dsp_goertzelBank_t;
+
+// Running power estimate.
+typedef struct {
+  uint32_t average;                          // Smoothed mean square in Q30 (full-scale DC = 1 << 30).
+  uint32_t smoothingShift;                   // Each block moves the average 1/2^smoothingShift of the way.
+  bool primed;                               // False until the first block seeds the average.
+} dsp_powerEstimator_t;
+
+// Uses NEON if enable is true and NEON was compiled in. Returns whether NEON is now in use.
+bool dsp_setNeonEnabled(bool enable);
+
+// True if the NEON path is in use.
+bool dsp_isNeonEnabled();
+
+// Converts count 12-bit ADC values (as delivered by adcCapture) to Q15 around DSP_ADC_MIDSCALE.
+void dsp_convertAdcSamples(const uint16_t* adcSamples, int16_t* samples, uint32_t count);
+
+// Sets up a decimator with tapCount Q15 coefficients (copied). Fails if tapCount or factor is out of range,
+// or if the sum of the absolute coefficients is 2.0 or more (the 32-bit accumulator could overflow).
+int dsp_firDecimator_init(dsp_firDecimator_t* fir, const int16_t* taps, uint32_t tapCount, uint32_t factor);
+
+// Clears the filter history.
+void dsp_firDecimator_reset(dsp_firDecimator_t* fir);
+
+// Filters count samples (at most DSP_MAX_BLOCK_SIZE) and writes every factor-th output to output,
+// which must hold count / factor + 1 samples. Returns the number written.
+uint32_t dsp_firDecimator_process(dsp_firDecimator_t* fir, const int16_t* input, uint32_t count, int16_t* output);
+
+// Sets up a bank watching binCount frequencies (rounded to the nearest bin of sampleRateHz / length).
+// Fails if binCount or length is out of range.
+int dsp_goertzelBank_init(dsp_goertzelBank_t* bank, const uint32_t* frequenciesHz, uint32_t binCount,
+                          uint32_t sampleRateHz, uint32_t length);
+
+// Restarts the current measurement.
+void dsp_goertzelBank_reset(dsp_goertzelBank_t* bank);
+
+// Feeds count samples in. Returns the number of measurements completed (their results are in power[],
+// the last one wins).
+uint32_t dsp_goertzelBank_process(dsp_goertzelBank_t* bank, const int16_t* samples, uint32_t count);
+
+// Latest power at bin, as amplitude squared in Q30: a full-scale sine at the bin frequency reads about 1 << 30.
+uint32_t dsp_goertzelBank_getPower(const dsp_goertzelBank_t* bank, uint32_t bin);
+
+// Mean square of count samples in Q30.
+uint32_t dsp_blockPower(const int16_t* samples, uint32_t count);
+
+// Sets up a power estimator.
+void dsp_powerEstimator_init(dsp_powerEstimator_t* estimator, uint32_t smoothingShift);
+
+// Folds a block into the estimate and returns the new average.
+uint32_t dsp_powerEstimator_update(dsp_powerEstimator_t* estimator, const int16_t* samples, uint32_t count);
+
+#endif /* DSP_H_ */
@@ -0,0 +1,245 @@
+/*
+ * dspBench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "dspBench.h"
+#include "testSupport.h"
+#include "dsp.h"
+#include "adcCapture.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_TAP_COUNT 31                 // Hamming-windowed sinc, cutoff 0.1 of the sample rate, unity DC gain.
+#define TEST_DECIMATION 4                 // Passband fits under the decimated Nyquist frequency.
+#define TEST_SIGNAL_LENGTH 3000           // Samples pushed through the FIR check.
+#define TEST_SAMPLE_RATE_HZ 16000         // Goertzel check sample rate.
+#define TEST_GOERTZEL_LENGTH 256          // Samples per Goertzel measurement; every test tone lands on a bin.
+#define TEST_TONE_PERIOD 16               // The test tone is the sample rate / 16 (1 kHz).
+#define TEST_TONE_AMPLITUDE 16384         // 0.5 full scale.
+#define TEST_TONE_POWER (1u << 28)        // 0.5^2 in Q30.
+#define TEST_POWER_TOLERANCE 64           // Goertzel power must be within 1/64 of the expected value.
+#define TEST_LEAKAGE_DIVISOR 1000         // Other bins must read under 1/1000 of the tone.
+#define TEST_SMOOTHING_SHIFT 2            // Power estimator moves a quarter of the way per block.
+#define BENCH_BLOCK_COUNT 500             // adcCapture-sized blocks per timed run.
+#define BENCH_BIN_COUNT 4                 // Frequencies watched in the timed Goertzel run.
+#define PERCENT 100
+
+static const int16_t testTaps[TEST_TAP_COUNT] = {
+    0, 39, 91, 139, 129, 0, -271, -609, -832, -696, 0, 1297, 3011, 4755, 6059, 6542,
+    6059, 4755, 3011, 1297, 0, -696, -832, -609, -271, 0, 129, 139, 91, 39, 0};
+// One period of sin(2*pi*n/16) in Q15.
+static const int16_t sineTable[TEST_TONE_PERIOD] = {
+    0, 12540, 23170, 30274, 32767, 30274, 23170, 12540, 0, -12540, -23170, -30274, -32767, -30274, -23170, -12540};
+static const uint32_t testFrequencies[] = {1000, 2000, 4000, 7000};  // Tone bin first.
+static const uint32_t firBlockSizes[] = {1, 97, 256, 1000, 7, 1024, 615};  // Block sizes for the FIR check.
+
+static dsp_firDecimator_t fir;
+static dsp_goertzelBank_t bank;
+static uint16_t adcBlock[ADCCAPTURE_BLOCK_SIZE];
+static int16_t signal[TEST_SIGNAL_LENGTH];
+static int16_t filtered[TEST_SIGNAL_LENGTH / TEST_DECIMATION + 1];
+static int16_t reference[TEST_SIGNAL_LENGTH / TEST_DECIMATION + 1];
+static int16_t firstPathOutput[TEST_SIGNAL_LENGTH / TEST_DECIMATION + 1];  // Output of the first path tried.
+static int16_t block[ADCCAPTURE_BLOCK_SIZE];
+static int16_t decimated[ADCCAPTURE_BLOCK_SIZE / TEST_DECIMATION + 1];
+
+// Repeatable pseudo-random numbers for test signals.
+static uint32_t randomState = 1;
+static uint32_t nextRandom() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+// ******************************** checks ***************************************
+// ADC conversion at the ends and middle of the range, in a block long enough for the vector loop.
+static void checkConversion() {
+  for (uint32_t i = 0; i < ADCCAPTURE_BLOCK_SIZE; i++)
+    adcBlock[i] = i % 3 == 0 ? 0 : i % 3 == 1 ? DSP_ADC_MIDSCALE : 4095;
+  dsp_convertAdcSamples(adcBlock, block, ADCCAPTURE_BLOCK_SIZE - 1);  // Odd count exercises the scalar tail.
+  bool correct = true;
+  for (uint32_t i = 0; i < ADCCAPTURE_BLOCK_SIZE - 1; i++)
+    correct &= block[i] == (i % 3 == 0 ? -32768 : i % 3 == 1 ? 0 : 32752);
+  testSupport_check(correct, "ADC conversion");
+}
+
+// Filters a random signal in blocks of uneven size and compares with a direct convolution.
+static void checkFir() {
+  testSupport_check(dsp_firDecimator_init(&fir, testTaps, 0, 1) == DSP_STATUS_FAIL, "FIR init accepted 0 taps");
+  testSupport_check(dsp_firDecimator_init(&fir, testTaps, TEST_TAP_COUNT, 0) == DSP_STATUS_FAIL,
+                    "FIR init accepted factor 0");
+  int16_t loudTaps[3] = {INT16_MAX, INT16_MAX, 2};  // |tap| sum of exactly 2.0.
+  testSupport_check(dsp_firDecimator_init(&fir, loudTaps, 3, 1) == DSP_STATUS_FAIL,
+                    "FIR init accepted taps that can overflow");
+  testSupport_check(dsp_firDecimator_init(&fir, testTaps, TEST_TAP_COUNT, TEST_DECIMATION) == DSP_STATUS_OK,
+                    "FIR init failed");
+  randomState = 1;
+  for (uint32_t i = 0; i < TEST_SIGNAL_LENGTH; i++)
+    signal[i] = (int16_t) nextRandom();
+  uint32_t filteredCount = 0;
+  for (uint32_t start = 0, k = 0; start < TEST_SIGNAL_LENGTH; k++) {
+    uint32_t count = firBlockSizes[k % (sizeof(firBlockSizes) / sizeof(firBlockSizes[0]))];
+    if (count > TEST_SIGNAL_LENGTH - start)
+      count = TEST_SIGNAL_LENGTH - start;
+    filteredCount += dsp_firDecimator_process(&fir, signal + start, count, filtered + filteredCount);
+    start += count;
+  }
+  uint32_t referenceCount = 0;
+  for (uint32_t n = 0; n < TEST_SIGNAL_LENGTH; n += TEST_DECIMATION) {
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < TEST_TAP_COUNT && i <= n; i++)
+      sum += (int64_t) testTaps[i] * signal[n - i];
+    sum = (sum + (1 << 14)) >> 15;
+    reference[referenceCount++] = sum > INT16_MAX ? INT16_MAX : sum < INT16_MIN ? INT16_MIN : (int16_t) sum;
+  }
+  testSupport_check(filteredCount == referenceCount, "FIR output count");
+  testSupport_check(!memcmp(filtered, reference, referenceCount * sizeof(int16_t)),
+                    "FIR output differs from direct convolution");
+}
+
+// A tone on one bin shows up there at the right level and not in the others; silence reads zero.
+static void checkGoertzel() {
+  uint32_t binCount = sizeof(testFrequencies) / sizeof(testFrequencies[0]);
+  testSupport_check(dsp_goertzelBank_init(&bank, testFrequencies, 0, TEST_SAMPLE_RATE_HZ, TEST_GOERTZEL_LENGTH) ==
+                    DSP_STATUS_FAIL, "Goertzel init accepted 0 bins");
+  testSupport_check(dsp_goertzelBank_init(&bank, testFrequencies, binCount, TEST_SAMPLE_RATE_HZ,
+                                          DSP_GOERTZEL_MAX_LENGTH + 1) == DSP_STATUS_FAIL,
+                    "Goertzel init accepted an overlong measurement");
+  testSupport_check(dsp_goertzelBank_init(&bank, testFrequencies, binCount, TEST_SAMPLE_RATE_HZ, TEST_GOERTZEL_LENGTH) ==
+                    DSP_STATUS_OK, "Goertzel init failed");
+  for (uint32_t i = 0; i < TEST_GOERTZEL_LENGTH * 2; i++)
+    block[i] = sineTable[i % TEST_TONE_PERIOD] / 2;  // Half-scale tone on the first bin.
+  // Feed one and a half measurements in two uneven pieces, then the rest.
+  uint32_t measurements = dsp_goertzelBank_process(&bank, block, TEST_GOERTZEL_LENGTH / 3);
+  measurements += dsp_goertzelBank_process(&bank, block + TEST_GOERTZEL_LENGTH / 3, TEST_GOERTZEL_LENGTH * 3 / 2);
+  testSupport_check(measurements == 1, "Goertzel measurement count");
+  uint32_t tone = dsp_goertzelBank_getPower(&bank, 0);
+  testSupport_check(tone > TEST_TONE_POWER - TEST_TONE_POWER / TEST_POWER_TOLERANCE &&
+                    tone < TEST_TONE_POWER + TEST_TONE_POWER / TEST_POWER_TOLERANCE, "Goertzel tone power");
+  for (uint32_t bin = 1; bin < binCount; bin++)
+    testSupport_check(dsp_goertzelBank_getPower(&bank, bin) < tone / TEST_LEAKAGE_DIVISOR,
+                      "Goertzel leakage into another bin");
+  memset(block, 0, sizeof(block));
+  dsp_goertzelBank_reset(&bank);
+  dsp_goertzelBank_process(&bank, block, TEST_GOERTZEL_LENGTH);
+  testSupport_check(dsp_goertzelBank_getPower(&bank, 0) == 0, "Goertzel power of silence");
+  // Full-scale square wave at the Nyquist bin: the state must not overflow.
+  for (uint32_t i = 0; i < TEST_GOERTZEL_LENGTH; i++)
+    block[i] = i & 1 ? INT16_MIN : INT16_MAX;
+  uint32_t nyquist = TEST_SAMPLE_RATE_HZ / 2;
+  dsp_goertzelBank_init(&bank, &nyquist, 1, TEST_SAMPLE_RATE_HZ, TEST_GOERTZEL_LENGTH);
+  dsp_goertzelBank_process(&bank, block, TEST_GOERTZEL_LENGTH);
+  testSupport_check(dsp_goertzelBank_getPower(&bank, 0) > (1u << 31), "Goertzel full-scale Nyquist tone");
+}
+
+// Block power of a constant and of the tone, and the estimator's smoothing.
+static void checkPower() {
+  for (uint32_t i = 0; i < ADCCAPTURE_BLOCK_SIZE; i++)
+    block[i] = TEST_TONE_AMPLITUDE;
+  testSupport_check(dsp_blockPower(block, ADCCAPTURE_BLOCK_SIZE - 3) == TEST_TONE_POWER, "power of a constant");
+  for (uint32_t i = 0; i < ADCCAPTURE_BLOCK_SIZE; i++)
+    block[i] = sineTable[i % TEST_TONE_PERIOD] / 2;
+  uint32_t tonePower = dsp_blockPower(block, ADCCAPTURE_BLOCK_SIZE);
+  testSupport_check(tonePower > TEST_TONE_POWER / 2 - TEST_TONE_POWER / TEST_POWER_TOLERANCE &&
+                    tonePower < TEST_TONE_POWER / 2 + TEST_TONE_POWER / TEST_POWER_TOLERANCE, "power of a sine");
+  dsp_powerEstimator_t estimator;
+  dsp_powerEstimator_init(&estimator, TEST_SMOOTHING_SHIFT);
+  testSupport_check(dsp_powerEstimator_update(&estimator, block, ADCCAPTURE_BLOCK_SIZE) == tonePower,
+                    "estimator seeding");
+  memset(block, 0, sizeof(block));
+  uint32_t expected = tonePower - (tonePower >> TEST_SMOOTHING_SHIFT);
+  testSupport_check(dsp_powerEstimator_update(&estimator, block, ADCCAPTURE_BLOCK_SIZE) == expected,
+                    "estimator smoothing");
+}
+
+// Runs every check on the current path.
+static void runChecks() {
+  printf("dspBench: checking the %s path\n\r", dsp_isNeonEnabled() ? "NEON" : "portable");
+  checkConversion();
+  checkFir();
+  checkGoertzel();
+  checkPower();
+}
+
+// ******************************** benchmark ************************************
+// Fills adcBlock with noise around midscale, as a floating input would give.
+static void fillAdcBlock() {
+  for (uint32_t i = 0; i < ADCCAPTURE_BLOCK_SIZE; i++)
+    adcBlock[i] = DSP_ADC_MIDSCALE - 512 + nextRandom() % 1024;
+}
+
+// Prints samples/sec for one stage.
+static void printRate(const char* stage, double seconds) {
+  printf("dspBench: %-10s %s %7.2f M samples/s\n\r", stage, dsp_isNeonEnabled() ? "NEON    " : "portable",
+         (double) BENCH_BLOCK_COUNT * ADCCAPTURE_BLOCK_SIZE / seconds / 1.0E6);
+}
+
+// Times each stage over BENCH_BLOCK_COUNT adcCapture-sized blocks, then the whole chain.
+static void runBenchmark() {
+  dsp_powerEstimator_t estimator;
+  uint32_t checksum = 0;
+  fillAdcBlock();
+  dsp_convertAdcSamples(adcBlock, block, ADCCAPTURE_BLOCK_SIZE);
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_BLOCK_COUNT; i++)
+    dsp_convertAdcSamples(adcBlock, block, ADCCAPTURE_BLOCK_SIZE);
+  printRate("convert", testSupport_stopTimer());
+  dsp_firDecimator_init(&fir, testTaps, TEST_TAP_COUNT, TEST_DECIMATION);
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_BLOCK_COUNT; i++)
+    checksum += dsp_firDecimator_process(&fir, block, ADCCAPTURE_BLOCK_SIZE, decimated);
+  printRate("FIR /4", testSupport_stopTimer());
+  dsp_goertzelBank_init(&bank, testFrequencies, BENCH_BIN_COUNT, TEST_SAMPLE_RATE_HZ, TEST_GOERTZEL_LENGTH);
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_BLOCK_COUNT; i++)
+    checksum += dsp_goertzelBank_process(&bank, block, ADCCAPTURE_BLOCK_SIZE);
+  printRate("Goertzel 4", testSupport_stopTimer());
+  dsp_powerEstimator_init(&estimator, TEST_SMOOTHING_SHIFT);
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_BLOCK_COUNT; i++)
+    checksum += dsp_powerEstimator_update(&estimator, block, ADCCAPTURE_BLOCK_SIZE);
+  printRate("power", testSupport_stopTimer());
+  // The chain a detector would run per adcCapture block: convert, decimate, then measure the decimated signal.
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_BLOCK_COUNT; i++) {
+    dsp_convertAdcSamples(adcBlock, block, ADCCAPTURE_BLOCK_SIZE);
+    uint32_t count = dsp_firDecimator_process(&fir, block, ADCCAPTURE_BLOCK_SIZE, decimated);
+    checksum += dsp_goertzelBank_process(&bank, decimated, count);
+    checksum += dsp_powerEstimator_update(&estimator, decimated, count);
+  }
+  double seconds = testSupport_stopTimer();
+  printRate("chain", seconds);
+  testSupport_check(checksum != 0, "benchmark did no work");  // Also keeps the loops from being optimized away.
+  double samplesPerSecond = (double) BENCH_BLOCK_COUNT * ADCCAPTURE_BLOCK_SIZE / seconds;
+  printf("dspBench: chain at the %ld Hz capture rate takes %.1f%% of the CPU\n\r", (long) ADCCAPTURE_SAMPLE_RATE_HZ,
+         PERCENT * ADCCAPTURE_SAMPLE_RATE_HZ / samplesPerSecond);
+}
+
+// Runs the checks on every available path, checks that the paths agree, and times each.
+bool dspBench_run() {
+  testSupport_begin("dspBench");
+  bool neonAvailable = dsp_setNeonEnabled(true);
+  runChecks();
+  memcpy(firstPathOutput, filtered, sizeof(filtered));
+  runBenchmark();
+  if (neonAvailable) {
+    dsp_setNeonEnabled(false);
+    runChecks();
+    testSupport_check(!memcmp(firstPathOutput, filtered, sizeof(filtered)), "NEON and portable FIR outputs differ");
+    runBenchmark();
+    dsp_setNeonEnabled(true);
+  }
+  return testSupport_end();
+}
+
+#ifdef DSP_HOST
+// host entry point; the board build calls dspBench_run()
+int main() {
+  return dspBench_run() ? 0 : 1;
+}
+#endif
@@ -0,0 +1,19 @@
+/*
+ * dspBench.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef DSPBENCH_H_
+#define DSPBENCH_H_
+
+#include <stdbool.h>
+
+// Checks every dsp stage against reference computations, on the NEON and the portable path, and that the
+// two paths agree. Then prints samples/sec per stage and the share of CPU0 the chain takes at the adcCapture
+// rate. Returns true if every check passed. Host build:
+//   gcc -O2 -DDSP_HOST -DTESTSUPPORT_HOST dsp.c testSupport.c dspBench.c -o dspBench
+bool dspBench_run();
+
+#endif /* DSPBENCH_H_ */
@@ -0,0 +1,193 @@
+/*
+ * game.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "game.h"
+#include "display.h"
+#include "interrupts.h"
+#include "leds.h"
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum {
+  game_idle_e,                          // Not started, or closed.
+  game_running_e,
+  game_suspended_e
+} game_status_e;
+
+typedef enum {
+  game_noRequest_e,
+  game_launchRequest_e,
+  game_suspendRequest_e,
+  game_exitRequest_e
+} game_request_e;
+
+typedef struct {
+  const game_t* game;
+  scheduler_taskId_t taskIds[GAME_MAX_TASKS];
+  uint8_t taskCount;
+  game_status_e status;
+} game_entry_t;
+
+static game_entry_t games[GAME_MAX_GAMES];
+static uint8_t gameCount;
+static game_id_t currentGame = GAME_NONE;
+static game_id_t menuGame = GAME_NONE;
+static game_request_e request = game_noRequest_e;  // Switch to make in game_runOnce().
+static game_id_t requestedGame = GAME_NONE;        // Game to launch for game_launchRequest_e.
+
+void game_init() {
+  leds_init(true);              // LD4 is the heartbeat.
+  interrupts_initAll(true);     // Does not enable the interrupts at the devices.
+  display_init();               // Once, for every game.
+  display_fillScreen(DISPLAY_BLACK);
+  scheduler_init();
+  gameCount = 0;
+  currentGame = GAME_NONE;
+  menuGame = GAME_NONE;
+  request = game_noRequest_e;
+}
+
+game_id_t game_register(const game_t* game) {
+  if (gameCount >= GAME_MAX_GAMES) {
+    printf("game_register: no room for %s.\n\r", game->name);
+    return GAME_NONE;
+  }
+  game_entry_t* entry = &games[gameCount];
+  entry->game = game;
+  entry->taskCount = 0;
+  for (uint8_t i = 0; i < GAME_MAX_TASKS && game->tasks[i].name; i++) {
+    const game_task_t* task = &game->tasks[i];
+    scheduler_taskId_t id = scheduler_addTask(task->name, task->tick, task->periodMs, task->priority);
+    if (id == SCHEDULER_INVALID_TASK) {
+      printf("game_register: no room for %s of %s.\n\r", task->name, game->name);
+      return GAME_NONE;  // The ticks already added stay disabled for good.
+    }
+    scheduler_setTaskEnabled(id, false);  // Only ticks while the game runs.
+    entry->taskIds[entry->taskCount++] = id;
+  }
+  entry->status = game_idle_e;
+  return gameCount++;
+}
+
+void game_setMenu(game_id_t menu) {
+  menuGame = menu;
+}
+
+// Turns the ticks of a game on or off.
+static void game_enableTasks(game_id_t id, bool enable) {
+  for (uint8_t i = 0; i < games[id].taskCount; i++)
+    scheduler_setTaskEnabled(games[id].taskIds[i], enable);
+}
+
+// Stops the running game, keeping its state.
+static void game_suspend(game_id_t id) {
+  game_enableTasks(id, false);
+  if (games[id].game->suspend)
+    games[id].game->suspend();
+  games[id].status = game_suspended_e;
+  currentGame = GAME_NONE;
+}
+
+// Stops the running game for good.
+static void game_close(game_id_t id) {
+  game_enableTasks(id, false);
+  if (games[id].game->exit)
+    games[id].game->exit();
+  games[id].status = game_idle_e;
+  currentGame = GAME_NONE;
+}
+
+// Runs a game that is not running: resumes it if suspended, starts it from the beginning otherwise.
+static void game_run(game_id_t id) {
+  const game_t* game = games[id].game;
+  currentGame = id;
+  display_clearOldTouchData();  // The touch that launched it is not the game's.
+  if (games[id].status == game_suspended_e) {
+    game->draw();
+    if (game->resume)
+      game->resume();
+  } else {
+    game->init();
+    game->draw();
+  }
+  games[id].status = game_running_e;
+  game_enableTasks(id, true);
+}
+
+// Makes the switch requested since the last call.
+static void game_applyRequest() {
+  game_request_e pending = request;
+  request = game_noRequest_e;
+  switch (pending) {
+  case game_launchRequest_e:
+    if (requestedGame == currentGame)
+      break;
+    if (currentGame != GAME_NONE)
+      game_suspend(currentGame);
+    game_run(requestedGame);
+    break;
+  case game_suspendRequest_e:
+  case game_exitRequest_e:
+    if (currentGame == GAME_NONE || currentGame == menuGame || menuGame == GAME_NONE)
+      break;  // Nowhere to go back to.
+    if (pending == game_suspendRequest_e)
+      game_suspend(currentGame);
+    else
+      game_close(currentGame);
+    game_run(menuGame);
+    break;
+  case game_noRequest_e:
+    break;
+  }
+}
+
+bool game_start() {
+  if (scheduler_start() != SCHEDULER_STATUS_OK)
+    return false;
+  interrupts_enableArmInts();
+  if (menuGame != GAME_NONE) {
+    game_launch(menuGame);
+    game_applyRequest();
+  }
+  return true;
+}
+
+void game_runOnce() {
+  scheduler_runOnce();
+  game_applyRequest();
+}
+
+void game_launch(game_id_t game) {
+  if (game < 0 || game >= gameCount)
+    return;
+  requestedGame = game;
+  request = game_launchRequest_e;
+}
+
+void game_suspendCurrent() {
+  request = game_suspendRequest_e;
+}
+
+void game_exitCurrent() {
+  request = game_exitRequest_e;
+}
+
+game_id_t game_getCurrent() {
+  return currentGame;
+}
+
+uint8_t game_getCount() {
+  return gameCount;
+}
+
+const char* game_getName(game_id_t game) {
+  return games[game].game->name;
+}
+
+bool game_isSuspended(game_id_t game) {
+  return games[game].status == game_suspended_e;
+}
@@ -0,0 +1,91 @@
+/*
+ * game.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef GAME_H_
+#define GAME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+// Hosts several games in one image. Each game describes itself with a game_t: its tick functions and
+// hooks to start, draw, suspend, resume and close it. Games keep their state in their own statics, so a
+// suspended game keeps it too.
+// - game_init() brings up the shared services (LEDs, interrupts, display, scheduler) once. Games never
+//   call display_init() or interrupts_initAll() themselves.
+// - Every game's ticks are registered with the scheduler up front, disabled. Switching games only
+//   disables one set and enables another, so it is instant.
+// - A game is idle, running or suspended. Launching an idle game starts it with init() then draw().
+//   Launching a suspended game calls draw() then resume(), and it carries on where it stopped. Only
+//   one game runs at a time; launching another suspends the running one.
+// - One game can be set as the menu: suspending or closing the running game returns to it.
+// Switches requested from a tick take effect in game_runOnce(), between ticks.
+
+#define GAME_MAX_GAMES 8                // Games that can be registered.
+#define GAME_MAX_TASKS 4                // Tick functions per game.
+#define GAME_NONE (-1)                  // Returned by game_register() on failure; no game running.
+
+typedef int8_t game_id_t;
+
+// One tick function of a game, as handed to scheduler_addTask().
+typedef struct {
+  const char* name;                     // Used in the scheduler report; NULL ends the list.
+  scheduler_tickFunction_t tick;
+  uint32_t periodMs;
+  uint8_t priority;
+} game_task_t;
+
+typedef struct {
+  const char* name;                     // Shown by the launcher.
+  game_task_t tasks[GAME_MAX_TASKS];    // Ticks that run while the game runs, ended by a NULL name.
+  void (*init)();                       // Resets the game to its start. Must not draw.
+  void (*draw)();                       // Draws the whole screen for the game's current state.
+  void (*suspend)();                    // Optional: the game is about to stop ticking and lose the screen.
+  void (*resume)();                     // Optional: called after draw() when a suspended game runs again.
+  void (*exit)();                       // Optional: the game is being closed.
+} game_t;
+
+// Brings up the services shared by every game: LEDs, interrupts, the display and the scheduler.
+void game_init();
+
+// Registers a game and its ticks (disabled). Call after game_init() and before game_start().
+// Returns the game's id, or GAME_NONE if there is no room for it or its ticks.
+game_id_t game_register(const game_t* game);
+
+// Sets the game that game_suspendCurrent() and game_exitCurrent() return to.
+void game_setMenu(game_id_t menu);
+
+// Starts the scheduler and interrupts, and launches the menu if one is set. Returns false if the
+// scheduler could not start.
+bool game_start();
+
+// Runs the ready ticks of the running game, sleeps until the next interrupt, then makes any switch
+// requested meanwhile. Call it in a loop from main().
+void game_runOnce();
+
+// Asks to run game: resumed if it is suspended, started afresh otherwise.
+void game_launch(game_id_t game);
+
+// Asks to suspend the running game and return to the menu.
+void game_suspendCurrent();
+
+// Asks to close the running game and return to the menu.
+void game_exitCurrent();
+
+// Game that is running, GAME_NONE before the first launch.
+game_id_t game_getCurrent();
+
+// Number of games registered.
+uint8_t game_getCount();
+
+// Name of a registered game.
+const char* game_getName(game_id_t game);
+
+// True if game is suspended, so launching it resumes it.
+bool game_isSuspended(game_id_t game);
+
+#endif /* GAME_H_ */
@@ -25,8 +25,9 @@
 
 #define GLOBAL_TIMER_TIMER_ENABLE_BIT_POSITION 0
 #define GLOBAL_TIMER_COMPARATOR_ENABLE_BIT_POSITION 1
-#define GLOBAL_TIMER_IRQ_ENABLE_BIT_POSITION 3
-#define GLOBAL_TIMER_AUTO_INCREMENT_BIT_POSITION 4
+#define GLOBAL_TIMER_IRQ_ENABLE_BIT_POSITION 2
+#define GLOBAL_TIMER_AUTO_INCREMENT_BIT_POSITION 3
+#define GLOBAL_TIMER_EVENT_FLAG_MASK 0x1  // Interrupt status register: set when the counter reaches the comparator.
 
 //u32 globalTimer_readRegister(u32 registerOffset) {
 //  u32 registerValue;
@@ -96,6 +97,25 @@ void globalTimer_stopTimer(bool printStatusFlag) {
   globalTimer_clearControlRegisterBit(GLOBAL_TIMER_TIMER_ENABLE_BIT_POSITION);
 }
 
+// The comparator is disabled while it is rewritten so that a half-written value cannot match (TRM 4.4.3).
+void globalTimer_armComparator(u64 compareValue) {
+  globalTimer_clearControlRegisterBit(GLOBAL_TIMER_COMPARATOR_ENABLE_BIT_POSITION);
+  globalTimer_writeRegister(GLOBAL_TIMER_INTERRUPT_STATUS_REGISTER, GLOBAL_TIMER_EVENT_FLAG_MASK);
+  globalTimer_writeRegister(GLOBAL_TIMER_COMPARATOR_LOWER_REGISTER, (u32) compareValue);
+  globalTimer_writeRegister(GLOBAL_TIMER_COMPARATOR_UPPER_REGISTER, (u32) (compareValue >> 32));
+  u32 timerControlRegister = globalTimer_readRegister(GLOBAL_TIMER_CONTROL_REGISTER);
+  timerControlRegister &= ~(0x1 << GLOBAL_TIMER_AUTO_INCREMENT_BIT_POSITION);
+  timerControlRegister |= (0x1 << GLOBAL_TIMER_COMPARATOR_ENABLE_BIT_POSITION) | (0x1 << GLOBAL_TIMER_IRQ_ENABLE_BIT_POSITION);
+  globalTimer_writeRegister(GLOBAL_TIMER_CONTROL_REGISTER, timerControlRegister);
+}
+
+void globalTimer_disarmComparator() {
+  u32 timerControlRegister = globalTimer_readRegister(GLOBAL_TIMER_CONTROL_REGISTER);
+  timerControlRegister &= ~((0x1 << GLOBAL_TIMER_COMPARATOR_ENABLE_BIT_POSITION) | (0x1 << GLOBAL_TIMER_IRQ_ENABLE_BIT_POSITION));
+  globalTimer_writeRegister(GLOBAL_TIMER_CONTROL_REGISTER, timerControlRegister);
+  globalTimer_writeRegister(GLOBAL_TIMER_INTERRUPT_STATUS_REGISTER, GLOBAL_TIMER_EVENT_FLAG_MASK);
+}
+
 // Returns 0 if no problem.
 u32 globalTimer_test(bool printStatusFlag) {
   u32 error=0;  // Bee optimistic.
@@ -34,6 +34,14 @@ void globalTimer_startTimer(bool printStatusFlag);
 // Stops the timer counter.
 void globalTimer_stopTimer(bool printStatusFlag);
 
+// Arms the comparator: the global timer interrupt (XPAR_GLOBAL_TMR_INTR) fires once the counter reaches
+// compareValue. The comparator is banked per CPU. interrupts_initAll() connects the interrupt to a handler
+// that disarms it again; delay_sleepMs() uses it to wake from WFI.
+void globalTimer_armComparator(u64 compareValue);
+
+// Disables the comparator and its interrupt and clears a pending event.
+void globalTimer_disarmComparator();
+
 // Simple test so that user can verify that the global timer is working properly.
 u32 globalTimer_test(bool printStatusFlag);
 
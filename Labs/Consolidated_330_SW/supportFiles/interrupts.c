@@ -8,29 +8,43 @@
 #include "xsysmon.h"                  // Includes for the system monitor (contains the XADC).
 #include "leds.h"        // Easy LED access functions can be found here.
 #include "globalTimer.h" // global timer routines aid in measuring time.
+#include "spscRing.h"    // ISR-to-main queue for ADC samples.
+#include "perf.h"        // PC sampler.
 
 #ifdef ENABLE_INTERVAL_TIMER_0_IN_TIMER_ISR
 #include "intervalTimer.h"
 #endif
 
-//static queue_t debugAdcQueue;
-//#define ADC_QUEUE_SIZE 100000
-//
-//void initAdcQueue() {
-//  queue_init(&debugAdcQueue, ADC_QUEUE_SIZE);
-//}
-//
-//queue_data_t interrupts_popAdcQueueData() {
-//	return queue_pop(&debugAdcQueue);
-//}
-//
-//bool interrupts_adcQueueEmpty() {
-//	return queue_empty(&debugAdcQueue);
-//}
-//
-//queue_size_t interrupts_adcQueueElementCount() {
-//	return queue_elementCount(&debugAdcQueue);
-//}
+#define ADC_QUEUE_SIZE 1024  // Must be a power of two.
+static spscRing_t adcQueue;   // Timer ISR pushes, main pops.
+static uint32_t adcQueueStorage[ADC_QUEUE_SIZE];
+static uint32_t adcQueueOverflowCount = 0;
+
+static void initAdcQueue() {
+  spscRing_init(&adcQueue, adcQueueStorage, sizeof(uint32_t), ADC_QUEUE_SIZE);
+}
+
+uint32_t interrupts_popAdcQueueData() {
+  uint32_t adcData = 0;
+  spscRing_pop(&adcQueue, &adcData);
+  return adcData;
+}
+
+uint32_t interrupts_popAdcQueueDataBulk(uint32_t* data, uint32_t maxCount) {
+  return spscRing_popBulk(&adcQueue, data, maxCount);
+}
+
+bool interrupts_adcQueueEmpty() {
+  return spscRing_isEmpty(&adcQueue);
+}
+
+uint32_t interrupts_adcQueueElementCount() {
+  return spscRing_count(&adcQueue);
+}
+
+uint32_t interrupts_getAdcQueueOverflowCount() {
+  return adcQueueOverflowCount;
+}
 
 
 // The sysmon runs off the bus-clock when accessed via the AXI_XADC IP.
@@ -52,7 +66,8 @@
 
 #define INTERRUPTS_ENABLE_HEARTBEAT_LED     // Comment out to disable the LED heart beat.
 #define HEARTBEAT_TOGGLES_PER_SECOND 8     // How many times the LED LD4 heartbeat toggle off and on per second.
-#define INTERRUPTS_ENABLE_ADC_DATA_CAPTURE  // Comment out to disable ADC sample capture to queue.
+//#define INTERRUPTS_ENABLE_ADC_DATA_CAPTURE  // Uncomment to capture one ADC sample per tick to the queue (adcCapture.h is the full-rate path).
+#define INTERRUPTS_ENABLE_PERF_SAMPLER      // Comment out to remove the perf PC-sampler hook (a flag test while it is stopped).
 
 // ****************** end of #define enable/disable section **********************************************
 
@@ -84,7 +99,8 @@ u32 privateTimerLoadValue = PRIVATE_TIMER_LOAD_VALUE_DEFAULT;     // Keep track
 // For convenience, compute the number of ticks per second based upon the above values.
 u32 privateTimerTicksPerSecond = ZYBO_BUS_CLOCK /((privateTimerPrescaler+1) * (privateTimerLoadValue+1));
 // Compute the number of ticks per heart-beat toggle.
-u32 privateTimerTicksPerHeartbeat = ZYBO_BUS_CLOCK /((privateTimerPrescaler+1) * (privateTimerLoadValue+1));
+u32 privateTimerTicksPerHeartbeat =
+    ZYBO_BUS_CLOCK /((privateTimerPrescaler+1) * (privateTimerLoadValue+1)) / HEARTBEAT_TOGGLES_PER_SECOND;
 
 // User can set the load value on the private timer.
 // Also updates ticks per heart beat so that the LD4 heart-beat toggle rate remains constant.
@@ -98,12 +114,51 @@ void interrupts_setPrivateTimerLoadValue(u32 loadValue) {
 // User can set the prescaler on the private timer.
 // Also updates ticks per heart beat so that the LD4 heart-beat toggle rate remains constant.
 void interrupts_setPrivateTimerPrescalerValue(u32 prescalerValue) {
-  XScuTimer_LoadTimer(&TimerInstance, prescalerValue);
+  XScuTimer_SetPrescaler(&TimerInstance, prescalerValue);
   privateTimerPrescaler = prescalerValue;
   // Formula derived from the ARM documentation on the private timer (4.1.1)
   privateTimerTicksPerHeartbeat = (ZYBO_BUS_CLOCK /((privateTimerPrescaler+1) * (privateTimerLoadValue+1))) / HEARTBEAT_TOGGLES_PER_SECOND;
 }
 
+// In tickless mode the private timer runs one-shot and is re-armed by the scheduler before each WFI,
+// so interrupts no longer mark equal slices of time. The heartbeat then follows the global timer
+// (which runs at the same clock as the private timer) instead of counting interrupts.
+#define HEARTBEAT_GLOBAL_TIMER_TICKS_PER_TOGGLE (ZYBO_BUS_CLOCK / HEARTBEAT_TOGGLES_PER_SECOND)
+static bool ticklessFlag = false;          // True while the private timer is one-shot.
+static u64 nextHeartbeatToggleTime = 0;    // Global-timer value at which the tickless heartbeat toggles next.
+
+// Switches the private timer between periodic (auto-reload) and one-shot operation.
+void interrupts_setPrivateTimerTickless(bool enable) {
+  ticklessFlag = enable;
+  if (enable) {
+    XScuTimer_DisableAutoReload(&TimerInstance);
+    nextHeartbeatToggleTime = globalTimer_getTimerValue() + HEARTBEAT_GLOBAL_TIMER_TICKS_PER_TOGGLE;
+  } else {
+    XScuTimer_EnableAutoReload(&TimerInstance);
+  }
+}
+
+// Restarts the private timer so that it interrupts once, ticks from now.
+void interrupts_armPrivateTimerOneShot(u32 ticks) {
+  XScuTimer_Stop(&TimerInstance);
+  if (privateTimerPrescaler)  // ticks are counted at the global-timer rate.
+    interrupts_setPrivateTimerPrescalerValue(0);
+  XScuTimer_LoadTimer(&TimerInstance, ticks);  // Writing the load register also reloads the counter.
+  XScuTimer_Start(&TimerInstance);
+}
+
+// Global-timer ticks until the tickless heartbeat is due to toggle.
+u32 interrupts_getTicksToNextHeartbeat() {
+#ifdef INTERRUPTS_ENABLE_HEARTBEAT_LED
+  u64 now = globalTimer_getTimerValue();
+  if (!ticklessFlag)
+    return INTERRUPTS_NO_HEARTBEAT_DEADLINE;
+  return nextHeartbeatToggleTime > now ? (u32) (nextHeartbeatToggleTime - now) : 0;
+#else
+  return INTERRUPTS_NO_HEARTBEAT_DEADLINE;
+#endif
+}
+
 u32 interrupts_isrInvocationCount() {return isrInvocationCount;}  // Functional accessor for isrInvocationCount.
 // Accessor to retrieve the number of times the ISR was invoked (same as count of timer ticks).
 u32 interrupts_getPrivateTimerTicksPerSecond() {return ZYBO_BUS_CLOCK /((privateTimerPrescaler+1) * (privateTimerLoadValue+1));}
@@ -172,6 +227,18 @@ void updateHeartBeatLed() {
   }
 }
 
+// Tickless version of the heartbeat: toggles LD4 by elapsed time rather than by interrupt count.
+static void updateHeartBeatLedByTime() {
+  u64 now = globalTimer_getTimerValue();
+  if (now < nextHeartbeatToggleTime)
+    return;
+  nextHeartbeatToggleTime += HEARTBEAT_GLOBAL_TIMER_TICKS_PER_TOGGLE;
+  if (nextHeartbeatToggleTime <= now)  // Fell behind (e.g., IRQs were masked a long time): resynchronize.
+    nextHeartbeatToggleTime = now + HEARTBEAT_GLOBAL_TIMER_TICKS_PER_TOGGLE;
+  ledValue = ledValue == 0 ? 1 : 0;
+  leds_writeLd4(ledValue);
+}
+
 // Default xSysMon ISR just clears the interrupt.
 // Watch out, the code currently indiscriminately clears out all interrupts from the XADC.
 void sysMonIsr(void *CallBackRef) {
@@ -193,10 +260,20 @@ void timerIsr(void* callBackRef){
 #endif
 
 #ifdef INTERRUPTS_ENABLE_HEARTBEAT_LED
+  if (ticklessFlag)
+    updateHeartBeatLedByTime();
+  else
 	updateHeartBeatLed();
 #endif
-//	queue_data_t adcData = (queue_data_t) interrupts_getAdcData();
-//	queue_overwritePush(&debugAdcQueue, adcData);
+#ifdef INTERRUPTS_ENABLE_ADC_DATA_CAPTURE
+  uint32_t adcData = interrupts_getAdcData();
+  if (!spscRing_push(&adcQueue, &adcData))  // Never blocks: main owns the other end.
+    adcQueueOverflowCount++;
+#endif
+
+#ifdef INTERRUPTS_ENABLE_PERF_SAMPLER
+  perf_sampleInterruptedPc();
+#endif
 
   // Put the code that you want executed on a timer interrupt between this line
 	isr_function();	// This function is defined in isr.c
@@ -214,6 +291,28 @@ void timerIsr(void* callBackRef){
 // ****************************** End Timer ISR *************************************
 // *********************************************************************************
 
+// Global-timer comparator ISR. It only wakes the CPU (see delay_sleepMs()): disarming the comparator
+// keeps it from firing again.
+void globalTimerWakeIsr(void* callBackRef) {
+  globalTimer_disarmComparator();
+}
+
+// Connects the global-timer comparator interrupt. The comparator stays disarmed until
+// globalTimer_armComparator() is called.
+int initGlobalTimerWakeInterrupts() {
+  globalTimer_disarmComparator();
+  int status = XScuGic_Connect(&InterruptController,
+                               XPAR_GLOBAL_TMR_INTR,
+                               (Xil_ExceptionHandler) globalTimerWakeIsr,
+                               NULL);
+  if (status != XST_SUCCESS) {
+    print("XScuGic_Connect failed (global timer).\n\r");
+    return status;
+  }
+  XScuGic_Enable(&InterruptController, XPAR_GLOBAL_TMR_INTR);
+  return XST_SUCCESS;
+}
+
 // Xilinx calls the Axi XADC module the SysMon (System Monitor).
 // This sets up the XADC to continuously sample on aux. channel 14 in single channel mode, unipolar.
 int initSysMonInterrupts() {
@@ -319,7 +418,7 @@ int initTimerInterrupts() {
 // 4. Pretty much does everything but it does not enable the ARM interrupts or any of the device global interrupts.
 // if printFailedStatusFlag is true, it prints out diagnostic messages if something goes awry.
 int interrupts_initAll(bool printFailedStatusFlag) {
-//	initAdcQueue();
+  initAdcQueue();
   int status;  // General Xilinx status.
   // Lookup the GIC device and get its handle.
   GicConfig = XScuGic_LookupConfig(XPAR_SCUGIC_SINGLE_DEVICE_ID);
@@ -370,6 +469,8 @@ int interrupts_initAll(bool printFailedStatusFlag) {
 
   // init the timer interrupts.
   initTimerInterrupts();
+  // Connect the global-timer comparator so that delays can sleep.
+  initGlobalTimerWakeInterrupts();
   // Init the SysMon interrupts (XADC).
   initSysMonInterrupts();
   initGicFlag = true;
@@ -407,6 +508,11 @@ int interrupts_disableArmInts() {
   }
 }
 
+// The comparator interrupt is connected by interrupts_initAll() and IRQs must be unmasked to take it.
+bool interrupts_isGlobalTimerWakeAvailable() {
+  return initGicFlag && !(mfcpsr() & XREG_CPSR_IRQ_ENABLE);  // The CPSR bit masks IRQs when set.
+}
+
 int interrupts_enableTimerGlobalInts() {
   XScuTimer_EnableInterrupt(&TimerInstance);
   return 0;
@@ -444,6 +550,38 @@ int interrupts_disableSysMonGlobalInterrupts(){
   return 0;
 }
 
+// Connects handler to GIC interrupt id and enables it there. caller names the public function for the error message.
+static int interrupts_connect(u32 id, void (*handler)(void*), void* callBackRef, const char* caller) {
+  if (!initGicFlag) {
+    printf("Error: Must call interrupts_initAll before %s()\n\r.", caller);
+    return XST_FAILURE;
+  }
+  int status = XScuGic_Connect(&InterruptController, id, (Xil_InterruptHandler) handler, callBackRef);
+  if (status != XST_SUCCESS) {
+    printf("XScuGic_Connect failed (%s, id %lu).\n\r", caller, (unsigned long) id);
+    return status;
+  }
+  XScuGic_Enable(&InterruptController, id);
+  return XST_SUCCESS;
+}
+
+// Connects handler to software-generated interrupt sgiId (0-15) and enables it at the GIC.
+// SGIs are raised by writing the distributor's SGI trigger register, e.g., from CPU1 (see amp.c).
+int interrupts_connectSoftwareInterrupt(u32 sgiId, void (*handler)(void*), void* callBackRef) {
+  return interrupts_connect(sgiId, handler, callBackRef, "interrupts_connectSoftwareInterrupt");
+}
+
+// Connects a fabric device interrupt to the GIC. The GIC leaves fabric interrupts level-sensitive, which misses
+// devices that only pulse their line, so the trigger type is set (keeping the priority) before it is enabled.
+int interrupts_connectDeviceInterrupt(u32 intrId, u8 trigger, void (*handler)(void*), void* callBackRef) {
+  if (initGicFlag) {
+    u8 priority, oldTrigger;
+    XScuGic_GetPriorityTriggerType(&InterruptController, intrId, &priority, &oldTrigger);
+    XScuGic_SetPriorityTriggerType(&InterruptController, intrId, priority, trigger);
+  }
+  return interrupts_connect(intrId, handler, callBackRef, "interrupts_connectDeviceInterrupt");
+}
+
 // These functions do nothing for now.
 //uint32_t interrupts_initBluetoothInterrupts() {printf("NYI!!!\n\r"); return 0;}
 void bluetoothIsr() {
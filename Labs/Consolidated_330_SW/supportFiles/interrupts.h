@@ -21,9 +21,17 @@
 // Uses interval timer 0 to measure time spent in ISR.
 //#define ENABLE_INTERVAL_TIMER_0_IN_TIMER_ISR 1
 
-//queue_data_t interrupts_popAdcQueueData();
-//bool interrupts_adcQueueEmpty();
-//queue_size_t interrupts_adcQueueElementCount();
+// ADC samples captured by the timer ISR (when INTERRUPTS_ENABLE_ADC_DATA_CAPTURE is defined) are queued
+// in an spscRing, so main can read them without disabling interrupts. Samples that find the queue full are dropped.
+// This is off by default and only samples once per timer tick; use adcCapture.h for block capture at the full rate.
+// Pops the oldest sample, or returns 0 if the queue is empty.
+uint32_t interrupts_popAdcQueueData();
+// Pops up to maxCount samples into data. Returns the number popped.
+uint32_t interrupts_popAdcQueueDataBulk(uint32_t* data, uint32_t maxCount);
+bool interrupts_adcQueueEmpty();
+uint32_t interrupts_adcQueueElementCount();
+// Number of samples dropped because the queue was full.
+uint32_t interrupts_getAdcQueueOverflowCount();
 
 
 // Inits all interrupts, which means:
@@ -49,6 +57,20 @@ u32 interrupts_getPrivateTimerCounterValue(void);
 void interrupts_setPrivateTimerLoadValue(u32 loadValue);
 void interrupts_setPrivateTimerPrescalerValue(u32 prescalerValue);
 
+// Tickless operation (used by the scheduler's tickless idle). With enable true the private timer stops
+// auto-reloading and only interrupts when armed with interrupts_armPrivateTimerOneShot(); the LD4 heartbeat
+// then keeps time with the global timer, and interrupts_isrInvocationCount() no longer measures time.
+#define INTERRUPTS_NO_HEARTBEAT_DEADLINE 0xFFFFFFFF  // Returned when the heartbeat needs no wake-ups.
+void interrupts_setPrivateTimerTickless(bool enable);
+// Arms the private timer to interrupt once, ticks global-timer ticks from now (clears any prescaler).
+void interrupts_armPrivateTimerOneShot(u32 ticks);
+// Global-timer ticks until the tickless heartbeat next needs a timer interrupt to toggle LD4.
+u32 interrupts_getTicksToNextHeartbeat();
+
+// True when a WFI can be woken by the global-timer comparator (globalTimer_armComparator()): interrupts_initAll()
+// has connected its interrupt and ARM interrupts are enabled.
+bool interrupts_isGlobalTimerWakeAvailable();
+
 // Globally enable/disable SysMon interrupts.
 int interrupts_enableSysMonGlobalInts();
 int interrupts_disableSysMonGlobalInts();
@@ -76,6 +98,19 @@ void interrupts_enableBluetoothInterrupts();
 void interrupts_disableBluetoothInterrupts();
 void interrupts_ackBluetoothInterrupts();
 
+// Connects handler to software-generated interrupt sgiId (0-15) and enables it at the GIC.
+// Used by amp.c so that CPU1 can interrupt CPU0. Call after interrupts_initAll().
+int interrupts_connectSoftwareInterrupt(u32 sgiId, void (*handler)(void*), void* callBackRef);
+
+// GIC trigger types for interrupts_connectDeviceInterrupt().
+#define INTERRUPTS_TRIGGER_LEVEL_HIGH 0x1    // The device holds its interrupt line high until serviced.
+#define INTERRUPTS_TRIGGER_RISING_EDGE 0x3   // The device pulses its interrupt line (e.g., AXI UART Lite).
+
+// Connects handler to the interrupt of a device in the fabric (its XPAR_FABRIC_..._INTR id), sets its trigger
+// type (INTERRUPTS_TRIGGER_...) and enables it at the GIC. The device's own interrupt enable is left to its driver.
+// Call after interrupts_initAll().
+int interrupts_connectDeviceInterrupt(u32 intrId, u8 trigger, void (*handler)(void*), void* callBackRef);
+
 extern volatile int interrupts_isrFlagGlobal;
 
 #endif /* INTERRUPTS_H_ */
@@ -8,6 +8,10 @@
 #include "lcd.h"
 #include "arduinoTypes.h"
 #include "mio.h"
+#include "delay.h"
+#include "timebase.h"
+
+#define LCD_10_NANOSECOND_TICKS_TIMES_100 TIMEBASE_TICKS_PER_US  // 100 times the global-timer ticks in 10 ns (100 x 10 ns = 1 us).
 
 static XGpio gpioTftControl;  // Provides the RD, WR and CD pins for the LCD controller.
 static XGpio gpioTftDataBus;  // Provides an 8-bit data bus for the LCD controller.
@@ -75,29 +79,22 @@ void LCD_negateWr() {
 
 // These are utility functions
 
-// Most of these delay functions are disabled as they were not found to be necessary
-// during testing. They are kept around to act as place-holders in the original source
-// code from the Adafruit site.
+// The delays are timed by the global timer (see delay.h). The TFT init tables rely on the millisecond
+// delay for reset and sleep-out timing.
 
 // millisecond delay
 void LCD_delay(uint16_t delay){
-//  volatile uint32_t count;
-//  count = delay * LCD_MILLISECOND_DELAY_COUNT;
-//  while (count--);
+  delay_ms(delay);
 }
 
 // microsecond delay
 void LCD_delayMicroseconds(uint16_t delay){
-//  volatile uint32_t count;
-//  count = delay * LCD_MICROSECOND_DELAY_COUNT;
-//  while (count--);
+  delay_us(delay);
 }
 
-// 10 nanosecond delay
+// 10 nanosecond delay, rounded up to whole global-timer ticks.
 void LCD_delay10Nanoseconds(uint16_t delay){
-//  volatile uint32_t count;
-//  count = delay * LCD_10_NANOSECOND_DELAY_COUNT;
-//  while (count--);
+  delay_ticks(((uint32_t) delay * LCD_10_NANOSECOND_TICKS_TIMES_100 + 99) / 100);
 }
 
 // Set the GPIO pins on the LCD data bus for read operations.
@@ -14,11 +14,6 @@
 
 // Provides an API to read/write the LCD controller.
 
-// Processor clock is 650 MHz. Clock period = 1.54 ns.
-#define LCD_10_NANOSECOND_DELAY_COUNT    1       // Should be approximately 10 ns.
-#define LCD_MICROSECOND_DELAY_COUNT    649       // Should be approximately 1 microsecond.
-#define LCD_MILLISECOND_DELAY_COUNT 649000       // Should be approximately 1 millisecond.
-
 #define LCD_CONTROL_DEVICE_ID XPAR_AXI_GPIO_TFT_CONTROL_DEVICE_ID
 #define LCD_DATA_BUS_DEVICE_ID XPAR_AXI_GPIO_TFT_DATA_BUS_DEVICE_ID
 #define LCD_BIT_WIDTH 2
@@ -38,7 +33,7 @@ void LCD_negateWr();
 // Utility functions for the TFT LCD Controller.
 void LCD_delay(uint16_t delay);              // millisecond delay
 void LCD_delayMicroseconds(uint16_t delay);  // microsecond delay
-void LCD_delay10Nanoseconds(uint16_t delay);  // delay in 15 ns chunks
+void LCD_delay10Nanoseconds(uint16_t delay);  // delay in 10 ns chunks
 
 // These calls are related to the data bus pins (GPIO) that are connected to the LCD controller.
 void LCD_write8(uint8_t value);              // Writes 8 bits to the TFT controller.
@@ -0,0 +1,95 @@
+/*
+ * numericField.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "numericField.h"
+#include "display.h"
+
+#define NUMERICFIELD_BASE 10
+#define NUMERICFIELD_BLANK ' '
+#define NUMERICFIELD_UNKNOWN 0          // shown[] entry for a cell whose contents are not known.
+
+void numericField_init(numericField_t* field, int16_t x, int16_t y, uint8_t digits, uint8_t textSize,
+                       uint16_t color, uint16_t background, numericField_format_e format) {
+  field->x = x;
+  field->y = y;
+  field->digits = digits > NUMERICFIELD_MAX_DIGITS ? NUMERICFIELD_MAX_DIGITS : digits;
+  field->textSize = textSize;
+  field->color = color;
+  field->background = background;
+  field->format = format;
+  for (uint8_t i = 0; i < NUMERICFIELD_MAX_DIGITS; i++)
+    field->shown[i] = NUMERICFIELD_UNKNOWN;
+}
+
+void numericField_format(const numericField_t* field, uint32_t value, char* text) {
+  uint8_t digits = field->digits;
+  if (!digits)
+    return;
+  if (digits < NUMERICFIELD_MAX_DIGITS) {  // Any uint32_t fits in NUMERICFIELD_MAX_DIGITS.
+    uint32_t largest = 0;  // All 9s: the largest value the field can show.
+    for (uint8_t i = 0; i < digits; i++)
+      largest = largest * NUMERICFIELD_BASE + (NUMERICFIELD_BASE - 1);
+    if (value > largest)
+      value = largest;
+  }
+  // Fill from the right: digits, then padding.
+  uint8_t used = 0;
+  int8_t i = digits - 1;
+  do {
+    text[i--] = '0' + value % NUMERICFIELD_BASE;
+    value /= NUMERICFIELD_BASE;
+    used++;
+  } while (value && i >= 0);
+  char pad = field->format == numericField_zeroPad_e ? '0' : NUMERICFIELD_BLANK;
+  while (i >= 0)
+    text[i--] = pad;
+  if (field->format == numericField_alignLeft_e) {  // Move the digits to the left.
+    for (uint8_t j = 0; j < digits; j++)
+      text[j] = j < used ? text[digits - used + j] : NUMERICFIELD_BLANK;
+  }
+}
+
+// Paints one cell.
+static void numericField_drawCell(const numericField_t* field, uint8_t cell, char c) {
+  int16_t x = field->x + cell * DISPLAY_CHAR_WIDTH * field->textSize;
+  if (c == NUMERICFIELD_BLANK)
+    display_fillRect(x, field->y, DISPLAY_CHAR_WIDTH * field->textSize, DISPLAY_CHAR_HEIGHT * field->textSize,
+                     field->background);
+  else
+    display_drawChar(x, field->y, c, field->color, field->background, field->textSize);
+}
+
+uint8_t numericField_update(numericField_t* field, uint32_t value) {
+  char text[NUMERICFIELD_MAX_DIGITS];
+  numericField_format(field, value, text);
+  uint8_t repainted = 0;
+  for (uint8_t i = 0; i < field->digits; i++) {
+    if (text[i] != field->shown[i]) {
+      numericField_drawCell(field, i, text[i]);
+      field->shown[i] = text[i];
+      repainted++;
+    }
+  }
+  return repainted;
+}
+
+void numericField_draw(numericField_t* field, uint32_t value) {
+  for (uint8_t i = 0; i < field->digits; i++)
+    field->shown[i] = NUMERICFIELD_UNKNOWN;
+  numericField_update(field, value);
+}
+
+void numericField_erase(numericField_t* field) {
+  display_fillRect(field->x, field->y, numericField_getWidth(field), DISPLAY_CHAR_HEIGHT * field->textSize,
+                   field->background);
+  for (uint8_t i = 0; i < field->digits; i++)
+    field->shown[i] = NUMERICFIELD_BLANK;
+}
+
+int16_t numericField_getWidth(const numericField_t* field) {
+  return field->digits * DISPLAY_CHAR_WIDTH * field->textSize;
+}
@@ -0,0 +1,58 @@
+/*
+ * numericField.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef NUMERICFIELD_H_
+#define NUMERICFIELD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A fixed-width number on the LCD, e.g., a score or the hours of a clock.
+// - Every digit has its own character cell, drawn with its background in one pass (no erasing by
+//   printing the old number in the background color first).
+// - The field remembers what it shows, so an update only repaints the cells whose character changed:
+//   going from 19 to 20 repaints two cells, from 20 to 21 one. Blank cells are a single fillRect.
+// - Digits are produced by division, not sprintf. Values too large for the field show as all 9s.
+
+#define NUMERICFIELD_MAX_DIGITS 10      // Enough for any uint32_t.
+
+typedef enum {
+  numericField_alignLeft_e,             // "7  ": digits start at the left, blanks after.
+  numericField_alignRight_e,            // "  7": blanks first, digits end at the right.
+  numericField_zeroPad_e                // "007": leading zeros, as on a clock.
+} numericField_format_e;
+
+typedef struct {
+  int16_t x, y;                         // Top-left corner of the first cell.
+  uint8_t digits;                       // Cells in the field.
+  uint8_t textSize;                     // Font scale; a cell is 6 x 8 pixels times this.
+  uint16_t color;
+  uint16_t background;
+  numericField_format_e format;
+  char shown[NUMERICFIELD_MAX_DIGITS];  // Character in each cell on the screen, 0 if not known.
+} numericField_t;
+
+// Sets up a field of digits cells (at most NUMERICFIELD_MAX_DIGITS) at (x, y). Nothing is drawn.
+void numericField_init(numericField_t* field, int16_t x, int16_t y, uint8_t digits, uint8_t textSize,
+                       uint16_t color, uint16_t background, numericField_format_e format);
+
+// Draws every cell of the field showing value, e.g., after the screen was cleared.
+void numericField_draw(numericField_t* field, uint32_t value);
+
+// Shows value, repainting only the cells that change. Returns the number of cells repainted.
+uint8_t numericField_update(numericField_t* field, uint32_t value);
+
+// Paints the whole field in its background color.
+void numericField_erase(numericField_t* field);
+
+// Width of the field in pixels.
+int16_t numericField_getWidth(const numericField_t* field);
+
+// Writes the cells for value into text (field->digits characters, not terminated).
+void numericField_format(const numericField_t* field, uint32_t value, char* text);
+
+#endif /* NUMERICFIELD_H_ */
@@ -0,0 +1,108 @@
+/*
+ * numericFieldTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "numericFieldTest.h"
+#include "testSupport.h"
+#include "numericField.h"
+#include "display.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_X 10                       // Where the test field is drawn.
+#define TEST_Y 10
+#define TEST_TEXT_SIZE 2
+#define TEST_DIGITS 3
+#define TEST_COUNT_TO 120               // The board build counts the field up to this.
+
+typedef struct {
+  numericField_format_e format;
+  uint32_t value;
+  const char* expected;
+} numericFieldTest_case_t;
+
+static const numericFieldTest_case_t formatCases[] = {
+  {numericField_alignLeft_e, 7, "7  "},
+  {numericField_alignRight_e, 7, "  7"},
+  {numericField_zeroPad_e, 7, "007"},
+  {numericField_alignLeft_e, 0, "0  "},
+  {numericField_alignRight_e, 205, "205"},
+  {numericField_zeroPad_e, 1000, "999"},       // Too large: all 9s.
+  {numericField_alignLeft_e, 4000000000u, "999"},
+};
+
+#ifdef NUMERICFIELD_HOST
+// ******************************** host display *********************************
+static uint32_t cellsDrawn;             // Characters and blank cells painted.
+
+void display_drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+  cellsDrawn++;
+}
+
+void display_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  cellsDrawn += w / (DISPLAY_CHAR_WIDTH * TEST_TEXT_SIZE);
+}
+#endif
+
+static void numericFieldTest_runFormatChecks() {
+  numericField_t field;
+  char text[NUMERICFIELD_MAX_DIGITS];
+  for (uint16_t i = 0; i < sizeof(formatCases) / sizeof(formatCases[0]); i++) {
+    numericField_init(&field, TEST_X, TEST_Y, TEST_DIGITS, TEST_TEXT_SIZE, DISPLAY_WHITE, DISPLAY_BLACK,
+                      formatCases[i].format);
+    numericField_format(&field, formatCases[i].value, text);
+    if (memcmp(text, formatCases[i].expected, TEST_DIGITS)) {
+      printf("numericFieldTest: %lu formatted as '%.3s', expected '%s'\n\r", (unsigned long) formatCases[i].value,
+             text, formatCases[i].expected);
+      testSupport_check(false, "format");
+    }
+  }
+  numericField_init(&field, TEST_X, TEST_Y, NUMERICFIELD_MAX_DIGITS + 5, TEST_TEXT_SIZE, DISPLAY_WHITE,
+                    DISPLAY_BLACK, numericField_zeroPad_e);
+  testSupport_check(field.digits == NUMERICFIELD_MAX_DIGITS, "digits not clamped");
+  numericField_format(&field, UINT32_MAX, text);
+  testSupport_check(memcmp(text, "4294967295", NUMERICFIELD_MAX_DIGITS) == 0, "largest uint32_t");
+}
+
+static void numericFieldTest_runUpdateChecks() {
+  numericField_t field;
+  numericField_init(&field, TEST_X, TEST_Y, TEST_DIGITS, TEST_TEXT_SIZE, DISPLAY_WHITE, DISPLAY_BLACK,
+                    numericField_alignLeft_e);
+  numericField_draw(&field, 19);
+  testSupport_check(numericField_update(&field, 19) == 0, "same value repainted");
+  testSupport_check(numericField_update(&field, 20) == 2, "19 -> 20 repaint count");
+  testSupport_check(numericField_update(&field, 21) == 1, "20 -> 21 repaint count");
+  // "21 " to "121": every cell moves.
+  testSupport_check(numericField_update(&field, 121) == 3, "21 -> 121 repaint count");
+  testSupport_check(numericField_update(&field, 9) == 3, "121 -> 9 repaint count");
+  numericField_erase(&field);
+  testSupport_check(numericField_update(&field, 0) == 1, "update after erase");
+  testSupport_check(numericField_getWidth(&field) == TEST_DIGITS * DISPLAY_CHAR_WIDTH * TEST_TEXT_SIZE, "width");
+#ifdef NUMERICFIELD_HOST
+  cellsDrawn = 0;
+  numericField_draw(&field, 5);
+  testSupport_check(cellsDrawn == TEST_DIGITS, "draw does not paint every cell once");
+#else
+  // Count up on the screen; each step only repaints the digits that change.
+  for (uint32_t value = 0; value <= TEST_COUNT_TO; value++)
+    numericField_update(&field, value);
+#endif
+}
+
+bool numericFieldTest_run() {
+  testSupport_begin("numericFieldTest");
+  numericFieldTest_runFormatChecks();
+  numericFieldTest_runUpdateChecks();
+  return testSupport_end();
+}
+
+#ifdef NUMERICFIELD_HOST
+// host entry point; the board build calls numericFieldTest_run()
+int main() {
+  return numericFieldTest_run() ? 0 : 1;
+}
+#endif
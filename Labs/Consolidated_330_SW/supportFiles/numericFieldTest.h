@@ -0,0 +1,18 @@
+/*
+ * numericFieldTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef NUMERICFIELDTEST_H_
+#define NUMERICFIELDTEST_H_
+
+#include <stdbool.h>
+
+// Checks numericField formats, oversized values and how many cells each update repaints. On the board it
+// draws a counting field on the LCD. Returns true if every check passed. Host build:
+//   g++ -x c++ -O2 -DNUMERICFIELD_HOST -DTESTSUPPORT_HOST numericField.c testSupport.c numericFieldTest.c -o numericFieldTest
+bool numericFieldTest_run();
+
+#endif /* NUMERICFIELDTEST_H_ */
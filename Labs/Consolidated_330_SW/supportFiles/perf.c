@@ -0,0 +1,332 @@
+/*
+ * perf.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#if defined(PERF_HOST) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE        // REG_RIP in ucontext_t.
+#endif
+#include "perf.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef PERF_HOST
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#else
+#include "xpm_counter.h"   // PMU event numbers.
+#include "xpseudo_asm.h"   // mtcp()/mfcp() and the CP15 register names.
+#endif
+
+#define PERF_SAMPLE_MAX_PROBES 32          // Slots tried before a sample is dropped.
+#define PERF_HASH_MULTIPLIER 2654435761u   // Knuth's multiplicative hash.
+#define PERF_PC_ALIGNMENT_BITS 2           // ARM instructions are word aligned.
+#define PERF_EMPTY_SLOT 0                  // No code lives at address 0.
+#define PERF_DECIMAL_SPLIT 1000000000u     // Prints 64-bit counts in two 32-bit halves.
+
+#if (PERF_SAMPLE_TABLE_SIZE & (PERF_SAMPLE_TABLE_SIZE - 1)) != 0
+#error "PERF_SAMPLE_TABLE_SIZE must be a power of two."
+#endif
+
+static const char* eventNames[PERF_EVENT_COUNT] = {"icache_miss", "dcache_miss", "branch_miss", "instructions"};
+
+static bool initFlag = false;
+static perf_scope_t* scopes[PERF_MAX_SCOPES];
+static uint32_t scopeCount = 0;
+static uint32_t droppedScopeCount = 0;
+
+static volatile bool samplingFlag = false;
+static uintptr_t samplePcs[PERF_SAMPLE_TABLE_SIZE];
+static uint32_t sampleHits[PERF_SAMPLE_TABLE_SIZE];
+static uint32_t sampleCount = 0;
+static uint32_t droppedSampleCount = 0;
+
+// ******************************** counters *************************************
+#ifdef PERF_HOST
+// Linux counters through perf_event_open(), one descriptor per counter in a group led by cycles.
+#define PERF_HOST_NO_FD -1
+#define PERF_NS_PER_SECOND 1000000000ULL
+#define PERF_HOST_CACHE_MISS(cache) \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static int cyclesFd = PERF_HOST_NO_FD;
+static int eventFds[PERF_EVENT_COUNT];
+
+static int perf_openCounter(uint32_t type, uint64_t config, int groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int) syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+static void perf_initCounters() {
+  cyclesFd = perf_openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, PERF_HOST_NO_FD);
+  eventFds[perf_event_icacheMiss] = perf_openCounter(PERF_TYPE_HW_CACHE, PERF_HOST_CACHE_MISS(PERF_COUNT_HW_CACHE_L1I), cyclesFd);
+  eventFds[perf_event_dcacheMiss] = perf_openCounter(PERF_TYPE_HW_CACHE, PERF_HOST_CACHE_MISS(PERF_COUNT_HW_CACHE_L1D), cyclesFd);
+  eventFds[perf_event_branchMispredict] = perf_openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, cyclesFd);
+  eventFds[perf_event_instructions] = perf_openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, cyclesFd);
+  if (cyclesFd == PERF_HOST_NO_FD)
+    printf("perf: perf_event_open() is not available; cycles are nanoseconds from clock_gettime() and events read 0.\n\r");
+}
+
+// Reads one descriptor, 0 if it could not be opened.
+static uint32_t perf_readFd(int fd) {
+  uint64_t value = 0;
+  if (fd == PERF_HOST_NO_FD || read(fd, &value, sizeof(value)) != sizeof(value))
+    return 0;
+  return (uint32_t) value;
+}
+
+void perf_read(perf_counters_t* counters) {
+  if (cyclesFd == PERF_HOST_NO_FD) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    counters->cycles = (uint32_t) (now.tv_sec * PERF_NS_PER_SECOND + now.tv_nsec);
+  } else {
+    counters->cycles = perf_readFd(cyclesFd);
+  }
+  for (uint32_t i = 0; i < PERF_EVENT_COUNT; i++)
+    counters->events[i] = perf_readFd(eventFds[i]);
+}
+#else
+// Cortex-A9 TRM 11.4: PMCR enable and reset bits, and the cycle counter's bit in the enable registers.
+#define PERF_PMCR_ENABLE 0x1
+#define PERF_PMCR_RESET_EVENTS 0x2
+#define PERF_PMCR_RESET_CYCLES 0x4
+#define PERF_CYCLE_COUNTER_BIT 0x80000000
+
+static const uint32_t eventTypes[PERF_EVENT_COUNT] = {
+  XPM_EVENT_INSRFETCH_CACHEREFILL, XPM_EVENT_DATA_CACHEREFILL, XPM_EVENT_BRANCHMISS, XPM_EVENT_INSTRRENAME};
+
+static void perf_initCounters() {
+  mtcp(XREG_CP15_PERF_MONITOR_CTRL, PERF_PMCR_ENABLE | PERF_PMCR_RESET_EVENTS | PERF_PMCR_RESET_CYCLES);
+  for (uint32_t i = 0; i < PERF_EVENT_COUNT; i++) {
+    mtcp(XREG_CP15_EVENT_CNTR_SEL, i);
+    isb();
+    mtcp(XREG_CP15_EVENT_TYPE_SEL, eventTypes[i]);
+  }
+  mtcp(XREG_CP15_COUNT_ENABLE_SET, PERF_CYCLE_COUNTER_BIT | ((1 << PERF_EVENT_COUNT) - 1));
+}
+
+void perf_read(perf_counters_t* counters) {
+  counters->cycles = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+  for (uint32_t i = 0; i < PERF_EVENT_COUNT; i++) {
+    mtcp(XREG_CP15_EVENT_CNTR_SEL, i);
+    isb();  // The selection must take effect before the counter is read.
+    counters->events[i] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+  }
+}
+#endif
+
+void perf_init() {
+  perf_initCounters();
+  initFlag = true;
+}
+
+// ******************************** scopes ***************************************
+
+perf_scopeGuard_t perf_scopeEnter(perf_scope_t* scope) {
+  perf_scopeGuard_t guard;
+  if (!initFlag)
+    perf_init();
+  if (!scope->registeredFlag) {
+    scope->registeredFlag = true;
+    if (scopeCount < PERF_MAX_SCOPES)
+      scopes[scopeCount++] = scope;
+    else
+      droppedScopeCount++;
+  }
+  guard.scope = scope;
+  scope->calls++;
+  if (scope->depth++ == 0)  // Only the outermost entry of a recursive scope is timed.
+    perf_read(&guard.start);
+  return guard;
+}
+
+void perf_scopeExit(perf_scopeGuard_t* guard) {
+  perf_scope_t* scope = guard->scope;
+  if (--scope->depth)
+    return;
+  perf_counters_t end;
+  perf_read(&end);
+  uint32_t cycles = end.cycles - guard->start.cycles;  // Modulo 2^32.
+  scope->cycles += cycles;
+  if (cycles > scope->maxCycles)
+    scope->maxCycles = cycles;
+  for (uint32_t i = 0; i < PERF_EVENT_COUNT; i++)
+    scope->events[i] += end.events[i] - guard->start.events[i];
+}
+
+const perf_scope_t* perf_findScope(const char* name) {
+  for (uint32_t i = 0; i < scopeCount; i++)
+    if (!strcmp(scopes[i]->name, name))
+      return scopes[i];
+  return NULL;
+}
+
+void perf_resetScopes() {
+  for (uint32_t i = 0; i < scopeCount; i++) {
+    perf_scope_t* scope = scopes[i];
+    scope->calls = 0;
+    scope->cycles = 0;
+    scope->maxCycles = 0;
+    for (uint32_t e = 0; e < PERF_EVENT_COUNT; e++)
+      scope->events[e] = 0;
+  }
+}
+
+// ******************************** sampler **************************************
+
+#ifdef PERF_HOST
+static void perf_sigprofHandler(int signal, siginfo_t* info, void* context);
+#endif
+
+void perf_startSampler() {
+  samplingFlag = false;
+  for (uint32_t i = 0; i < PERF_SAMPLE_TABLE_SIZE; i++) {
+    samplePcs[i] = PERF_EMPTY_SLOT;
+    sampleHits[i] = 0;
+  }
+  sampleCount = 0;
+  droppedSampleCount = 0;
+  samplingFlag = true;
+#ifdef PERF_HOST
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = perf_sigprofHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigaction(SIGPROF, &action, NULL);
+  struct itimerval period = {{0, PERF_HOST_SAMPLE_PERIOD_US}, {0, PERF_HOST_SAMPLE_PERIOD_US}};
+  setitimer(ITIMER_PROF, &period, NULL);
+#endif
+}
+
+void perf_stopSampler() {
+  samplingFlag = false;
+#ifdef PERF_HOST
+  struct itimerval off = {{0, 0}, {0, 0}};
+  setitimer(ITIMER_PROF, &off, NULL);
+#endif
+}
+
+// Slot that holds pc, or the empty slot where it belongs; PERF_SAMPLE_TABLE_SIZE if the probes run out.
+static uint32_t perf_findSlot(uintptr_t pc) {
+  uint32_t slot = ((uint32_t) (pc >> PERF_PC_ALIGNMENT_BITS) * PERF_HASH_MULTIPLIER) & (PERF_SAMPLE_TABLE_SIZE - 1);
+  for (uint32_t probe = 0; probe < PERF_SAMPLE_MAX_PROBES; probe++) {
+    if (samplePcs[slot] == pc || samplePcs[slot] == PERF_EMPTY_SLOT)
+      return slot;
+    slot = (slot + 1) & (PERF_SAMPLE_TABLE_SIZE - 1);
+  }
+  return PERF_SAMPLE_TABLE_SIZE;
+}
+
+void perf_recordSample(uintptr_t pc) {
+  uint32_t slot = perf_findSlot(pc);
+  if (pc == PERF_EMPTY_SLOT || slot == PERF_SAMPLE_TABLE_SIZE) {
+    droppedSampleCount++;
+    return;
+  }
+  samplePcs[slot] = pc;
+  sampleHits[slot]++;
+  sampleCount++;
+}
+
+#ifdef PERF_HOST
+// SIGPROF handler: the interrupted PC is in the signal context.
+static void perf_sigprofHandler(int signal, siginfo_t* info, void* context) {
+  ucontext_t* userContext = (ucontext_t*) context;
+  if (!samplingFlag)
+    return;
+#if defined(__x86_64__)
+  perf_recordSample((uintptr_t) userContext->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+  perf_recordSample((uintptr_t) userContext->uc_mcontext.pc);
+#else
+  droppedSampleCount++;  // No PC for this architecture.
+#endif
+}
+
+// The host samples from SIGPROF instead (see perf_startSampler()).
+void perf_sampleInterruptedPc() {
+}
+#else
+// IRQHandler (asm_vectors.S) starts with stmdb sp!, {r0-r3, r12, lr}, so the interrupted mode's lr_irq is the
+// last word below the top of the IRQ stack. IRQs do not nest, so the IRQ stack starts empty in every ISR.
+extern uint32_t __irq_stack;               // Top of the IRQ stack (lscript.ld).
+#define PERF_IRQ_SAVED_LR_INDEX 1          // Words below __irq_stack.
+#define PERF_IRQ_LR_OFFSET 4               // lr_irq is 4 bytes past the interrupted instruction.
+
+void perf_sampleInterruptedPc() {
+  if (samplingFlag)
+    perf_recordSample((&__irq_stack)[-PERF_IRQ_SAVED_LR_INDEX] - PERF_IRQ_LR_OFFSET);
+}
+#endif
+
+uint32_t perf_getSampleCount() {
+  return sampleCount;
+}
+
+uint32_t perf_getDroppedSampleCount() {
+  return droppedSampleCount;
+}
+
+uint32_t perf_getSampleCountAt(uintptr_t pc) {
+  uint32_t slot = perf_findSlot(pc);
+  return slot == PERF_SAMPLE_TABLE_SIZE || samplePcs[slot] != pc ? 0 : sampleHits[slot];
+}
+
+// ******************************** reports **************************************
+
+// Prints a 64-bit count without relying on printf support for long long.
+static void perf_printCount(uint64_t count) {
+  if (count >= PERF_DECIMAL_SPLIT)
+    printf("%lu%09lu", (unsigned long) (count / PERF_DECIMAL_SPLIT), (unsigned long) (count % PERF_DECIMAL_SPLIT));
+  else
+    printf("%lu", (unsigned long) count);
+}
+
+// perf-scope <name> calls <n> cycles <total> max <cycles> <event> <total> ...
+void perf_printScopes() {
+  for (uint32_t i = 0; i < scopeCount; i++) {
+    const perf_scope_t* scope = scopes[i];
+    printf("perf-scope %s calls %lu cycles ", scope->name, (unsigned long) scope->calls);
+    perf_printCount(scope->cycles);
+    printf(" max %lu", (unsigned long) scope->maxCycles);
+    for (uint32_t e = 0; e < PERF_EVENT_COUNT; e++) {
+      printf(" %s ", eventNames[e]);
+      perf_printCount(scope->events[e]);
+    }
+    printf("\n\r");
+  }
+  if (droppedScopeCount)
+    printf("perf: %lu scopes did not fit in PERF_MAX_SCOPES.\n\r", (unsigned long) droppedScopeCount);
+}
+
+// perf-samples <total> dropped <n>, then perf-sample 0x<pc> <hits> per PC and perf-end.
+void perf_printProfile() {
+  printf("perf-samples %lu dropped %lu\n\r", (unsigned long) sampleCount, (unsigned long) droppedSampleCount);
+#ifdef PERF_HOST
+  extern char __executable_start;  // Load address of a position-independent host build.
+  printf("perf-base %p\n\r", (void*) &__executable_start);
+#endif
+  for (uint32_t i = 0; i < PERF_SAMPLE_TABLE_SIZE; i++)
+    if (samplePcs[i] != PERF_EMPTY_SLOT)
+      printf("perf-sample 0x%lx %lu\n\r", (unsigned long) samplePcs[i], (unsigned long) sampleHits[i]);
+  printf("perf-end\n\r");
+}
+
+void perf_printReport() {
+  perf_printScopes();
+  perf_printProfile();
+}
@@ -0,0 +1,120 @@
+/*
+ * perf.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef PERF_H_
+#define PERF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Cortex-A9 performance monitor (PMU) access, scoped counters and a PC-sampling profiler.
+// - Counters: the PMU cycle counter plus PERF_EVENT_COUNT event counters, programmed for instruction-cache
+//   misses, data-cache misses, branch mispredicts and instructions (see perf_event_t).
+// - PERF_SCOPE("name") at the top of a block counts its calls and accumulates its cycles (total and max)
+//   and events. Recursive entries count as calls but only the outermost one is timed. Scopes are off unless
+//   PERF_ENABLE_SCOPES is defined. Only use them in code that runs on CPU0: they write shared statics and the
+//   PMU, which an amp.c job on CPU1 (D-cache off) must not touch.
+// - The sampler records the PC that each private-timer interrupt lands on (interrupts.c calls
+//   perf_sampleInterruptedPc()) into a table of PCs and hit counts: a flat profile at the timer rate.
+//   With the scheduler's tickless idle, an idle system is sampled only when it wakes, so run the profile
+//   with periodic ticks if idle time matters.
+// - perf_printReport() dumps both over the UART. Scope lines start with "perf-scope" and sample lines
+//   with "perf-sample"; perfSymbolize.py maps the sampled PCs to functions in the ELF.
+//
+// Host build (-DPERF_HOST): counters come from perf_event_open(), or from clock_gettime() (cycles in ns,
+// no events) where that is not allowed; the sampler uses SIGPROF every PERF_HOST_SAMPLE_PERIOD_US of CPU time.
+
+//#define PERF_ENABLE_SCOPES               // Uncomment (or build with -DPERF_ENABLE_SCOPES) to count PERF_SCOPE() blocks.
+#define PERF_MAX_SCOPES 16                 // Scopes that can be reported; later ones are counted as dropped.
+#define PERF_SAMPLE_TABLE_SIZE 1024        // Distinct sampled PCs (power of two).
+#define PERF_HOST_SAMPLE_PERIOD_US 1000    // Host sampler period.
+
+// Events counted next to cycles.
+typedef enum {
+  perf_event_icacheMiss,                   // Instruction-cache refills.
+  perf_event_dcacheMiss,                   // Data-cache refills.
+  perf_event_branchMispredict,             // Mispredicted or unpredicted branches.
+  perf_event_instructions,                 // Instructions (the A9 counts them at register renaming).
+  PERF_EVENT_COUNT
+} perf_event_t;
+
+// A snapshot of the counters. The PMU counters are 32 bits; differences are taken modulo 2^32, so a
+// measured stretch must be shorter than 2^32 cycles (6.6 s at 650 MHz).
+typedef struct {
+  uint32_t cycles;
+  uint32_t events[PERF_EVENT_COUNT];
+} perf_counters_t;
+
+// Accumulated counts for one PERF_SCOPE() site.
+typedef struct {
+  const char* name;
+  bool registeredFlag;                     // Added to the report table on first entry.
+  uint32_t depth;                          // Current recursion depth.
+  uint32_t calls;
+  uint64_t cycles;
+  uint32_t maxCycles;
+  uint64_t events[PERF_EVENT_COUNT];
+} perf_scope_t;
+
+// Live state of one entry into a scope.
+typedef struct {
+  perf_scope_t* scope;
+  perf_counters_t start;
+} perf_scopeGuard_t;
+
+#ifdef PERF_ENABLE_SCOPES
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+// Counts the rest of the enclosing block against name. The guard's cleanup runs on every exit from the block.
+#define PERF_SCOPE(name) \
+  static perf_scope_t PERF_CONCAT(perf_scope_, __LINE__) = {name}; \
+  perf_scopeGuard_t PERF_CONCAT(perf_guard_, __LINE__) __attribute__((cleanup(perf_scopeExit))) = \
+      perf_scopeEnter(&PERF_CONCAT(perf_scope_, __LINE__))
+#else
+#define PERF_SCOPE(name)
+#endif
+
+// Enables the PMU, resets its counters and programs the events. Called by the first PERF_SCOPE() if needed.
+void perf_init();
+
+// Reads all counters.
+void perf_read(perf_counters_t* counters);
+
+// Used by PERF_SCOPE().
+perf_scopeGuard_t perf_scopeEnter(perf_scope_t* scope);
+void perf_scopeExit(perf_scopeGuard_t* guard);
+
+// The reported scope with this name, NULL if none has been entered.
+const perf_scope_t* perf_findScope(const char* name);
+
+// Clears the counts of every scope.
+void perf_resetScopes();
+
+// Clears the sample table and starts (stops) recording samples.
+void perf_startSampler();
+void perf_stopSampler();
+
+// Adds one sample at pc. Samples that find the table full are counted as dropped.
+void perf_recordSample(uintptr_t pc);
+
+// Call from the timer ISR: records the PC that the interrupt was taken at, while the sampler runs.
+// Does nothing on the host, where SIGPROF drives the sampler.
+void perf_sampleInterruptedPc();
+
+// Samples recorded and dropped since perf_startSampler().
+uint32_t perf_getSampleCount();
+uint32_t perf_getDroppedSampleCount();
+
+// Hits recorded for exactly pc.
+uint32_t perf_getSampleCountAt(uintptr_t pc);
+
+// Prints one line per scope, then one line per sampled PC (see above).
+void perf_printScopes();
+void perf_printProfile();
+void perf_printReport();
+
+#endif /* PERF_H_ */
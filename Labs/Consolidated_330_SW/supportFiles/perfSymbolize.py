@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#
+# perfSymbolize.py
+#
+#  Created on: Oct 19, 2026
+#      Author: cdmoo
+#
+# Turns the sample lines printed by perf_printProfile() (perf.h) into a flat profile by function.
+# Save the UART output to a file, then:
+#   python3 perfSymbolize.py Debug/Consolidated_330_SW.elf uart.log
+# Function addresses come from nm; --nm selects the tool (arm-xilinx-eabi-nm by default, plain nm for
+# a host build). A "perf-base" line (host builds) is subtracted from every PC first.
+
+import argparse
+import bisect
+import subprocess
+import sys
+
+FUNCTION_TYPES = set("TtWw")  # nm types of code symbols.
+
+
+def readSymbols(nm, elf):
+    output = subprocess.run([nm, "-n", "-C", "--defined-only", elf], check=True, capture_output=True,
+                            text=True).stdout
+    addresses, names = [], []
+    for line in output.splitlines():
+        fields = line.split(None, 2)
+        if len(fields) == 3 and fields[1] in FUNCTION_TYPES:
+            addresses.append(int(fields[0], 16))
+            names.append(fields[2])
+    return addresses, names
+
+
+def readSamples(log):
+    base, samples, dropped = 0, [], 0
+    for line in log:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "perf-base":
+            base = int(fields[1], 16)
+        elif fields[0] == "perf-samples":
+            dropped = int(fields[3])
+        elif fields[0] == "perf-sample":
+            samples.append((int(fields[1], 16), int(fields[2])))
+    return base, samples, dropped
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flat profile by function from perf-sample lines.")
+    parser.add_argument("elf")
+    parser.add_argument("log", nargs="?", help="UART output (default: stdin)")
+    parser.add_argument("--nm", default="arm-xilinx-eabi-nm")
+    args = parser.parse_args()
+    addresses, names = readSymbols(args.nm, args.elf)
+    with (open(args.log) if args.log else sys.stdin) as log:
+        base, samples, dropped = readSamples(log)
+    hits = {}
+    for pc, count in samples:
+        index = bisect.bisect_right(addresses, pc - base) - 1
+        name = names[index] if index >= 0 else "<unknown 0x%x>" % pc
+        hits[name] = hits.get(name, 0) + count
+    total = sum(hits.values())
+    if not total:
+        print("no samples")
+        return
+    print("%7s %8s  %s" % ("percent", "samples", "function"))
+    for name, count in sorted(hits.items(), key=lambda item: -item[1]):
+        print("%6.1f%% %8d  %s" % (100.0 * count / total, count, name))
+    if dropped:
+        print("(%d samples dropped: the table was full)" % dropped)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,160 @@
+/*
+ * perfTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#define PERF_ENABLE_SCOPES  // The checks need scopes even where the rest of the build leaves them off.
+#include "perfTest.h"
+#include "testSupport.h"
+#include "perf.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef PERF_HOST
+#include <time.h>
+#else
+#include "globalTimer.h"
+#endif
+
+#define TEST_CALLS 10                   // Calls of the simple scope.
+#define TEST_RECURSION_DEPTH 5          // Entries per call of the recursive scope.
+#define TEST_WORK_ITERATIONS 1000       // Loop length of one unit of work.
+#define TEST_PC_A 0x00100100            // PCs recorded by hand in the sample-table checks.
+#define TEST_PC_B 0x00100104
+#define TEST_PC_A_HITS 3
+#define TEST_FILL_PC_BASE 0x00200000    // Base of the distinct PCs that overfill the table.
+#define TEST_FILL_PC_COUNT (2 * PERF_SAMPLE_TABLE_SIZE)
+#define TEST_SPIN_MS 300                // Length of the live-sampling spin.
+#define MS_PER_SECOND 1000
+#define NS_PER_MS 1000000
+
+static volatile uint32_t workSink;      // Keeps the work loops from being optimized away.
+
+// Milliseconds on a free-running clock.
+static uint32_t perfTest_nowMs() {
+#ifdef PERF_HOST
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t) (now.tv_sec * MS_PER_SECOND + now.tv_nsec / NS_PER_MS);
+#else
+  return (uint32_t) (globalTimer_getTimerValue() / (GLOBAL_TIMER_TICKS_PER_SECOND / MS_PER_SECOND));
+#endif
+}
+
+static void perfTest_work(uint32_t units) {
+  for (uint32_t i = 0; i < units * TEST_WORK_ITERATIONS; i++)
+    workSink += i;
+}
+
+// ******************************** scopes ***************************************
+
+static void perfTest_simple() {
+  PERF_SCOPE("test-simple");
+  perfTest_work(1);
+}
+
+static void perfTest_recursive(uint32_t depth) {
+  PERF_SCOPE("test-recursive");
+  perfTest_work(1);
+  if (depth > 1)
+    perfTest_recursive(depth - 1);
+}
+
+static void perfTest_nested() {
+  PERF_SCOPE("test-outer");
+  perfTest_work(1);
+  {
+    PERF_SCOPE("test-inner");
+    perfTest_work(2);
+  }
+}
+
+static void perfTest_runScopeChecks() {
+  for (uint32_t i = 0; i < TEST_CALLS; i++)
+    perfTest_simple();
+  perfTest_recursive(TEST_RECURSION_DEPTH);
+  perfTest_nested();
+  const perf_scope_t* simpleScope = perf_findScope("test-simple");
+  const perf_scope_t* recursiveScope = perf_findScope("test-recursive");
+  const perf_scope_t* outerScope = perf_findScope("test-outer");
+  const perf_scope_t* innerScope = perf_findScope("test-inner");
+  testSupport_check(simpleScope && recursiveScope && outerScope && innerScope, "scopes not registered");
+  if (!simpleScope || !recursiveScope || !outerScope || !innerScope)
+    return;
+  testSupport_check(simpleScope->calls == TEST_CALLS, "scope call count");
+  testSupport_check(simpleScope->cycles > 0 && simpleScope->maxCycles > 0, "scope counted no cycles");
+  testSupport_check(simpleScope->maxCycles <= simpleScope->cycles, "scope max exceeds total");
+  testSupport_check(recursiveScope->calls == TEST_RECURSION_DEPTH, "recursive scope call count");
+  testSupport_check(recursiveScope->depth == 0, "recursive scope depth not unwound");
+  testSupport_check(recursiveScope->maxCycles == recursiveScope->cycles, "recursive scope timed more than once");
+  testSupport_check(outerScope->cycles >= innerScope->cycles, "outer scope cheaper than the scope inside it");
+  perf_resetScopes();
+  testSupport_check(simpleScope->calls == 0 && simpleScope->cycles == 0 && innerScope->cycles == 0, "perf_resetScopes");
+}
+
+// ******************************** sample table *********************************
+
+static void perfTest_runSampleTableChecks() {
+  perf_startSampler();
+  perf_stopSampler();  // Only the hand-recorded samples below.
+  for (uint32_t i = 0; i < TEST_PC_A_HITS; i++)
+    perf_recordSample(TEST_PC_A);
+  perf_recordSample(TEST_PC_B);
+  testSupport_check(perf_getSampleCountAt(TEST_PC_A) == TEST_PC_A_HITS && perf_getSampleCountAt(TEST_PC_B) == 1,
+                    "sample hit counts");
+  testSupport_check(perf_getSampleCount() == TEST_PC_A_HITS + 1, "sample total");
+  perf_recordSample(0);
+  testSupport_check(perf_getDroppedSampleCount() == 1 && perf_getSampleCount() == TEST_PC_A_HITS + 1,
+                    "PC 0 not rejected");
+  for (uint32_t i = 0; i < TEST_FILL_PC_COUNT; i++)
+    perf_recordSample(TEST_FILL_PC_BASE + i * sizeof(uint32_t));
+  testSupport_check(perf_getDroppedSampleCount() > 1, "full table dropped nothing");
+  testSupport_check(perf_getSampleCount() + perf_getDroppedSampleCount() == TEST_PC_A_HITS + 2 + TEST_FILL_PC_COUNT,
+                    "samples lost from the counts");
+  testSupport_check(perf_getSampleCountAt(TEST_PC_A) == TEST_PC_A_HITS, "filling the table disturbed an entry");
+}
+
+// ******************************** live sampling ********************************
+
+// The hot spot the live profile should find.
+static void perfTest_spin(uint32_t ms) {
+  uint32_t start = perfTest_nowMs();
+  while (perfTest_nowMs() - start < ms)
+    perfTest_work(1);
+}
+
+static void perfTest_runLiveSampling() {
+  perf_startSampler();
+  {
+    PERF_SCOPE("test-spin");
+    perfTest_spin(TEST_SPIN_MS);
+  }
+  perf_stopSampler();
+  if (!perf_getSampleCount()) {
+#ifdef PERF_HOST
+    testSupport_check(false, "SIGPROF recorded no samples");
+#else
+    printf("perfTest: no timer interrupts while spinning; live sampling skipped.\n\r");
+#endif
+    return;
+  }
+  perf_printReport();
+}
+
+bool perfTest_run() {
+  testSupport_begin("perfTest");
+  perf_init();
+  perfTest_runScopeChecks();
+  perfTest_runSampleTableChecks();
+  perfTest_runLiveSampling();
+  return testSupport_end();
+}
+
+#ifdef PERF_HOST
+// host entry point; the board build calls perfTest_run()
+int main() {
+  return perfTest_run() ? 0 : 1;
+}
+#endif
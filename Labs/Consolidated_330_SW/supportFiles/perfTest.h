@@ -0,0 +1,20 @@
+/*
+ * perfTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef PERFTEST_H_
+#define PERFTEST_H_
+
+#include <stdbool.h>
+
+// Checks perf scopes (counts, recursion, nesting, reset) and the sample table, then samples a busy loop and
+// prints the profile. The board needs the private-timer interrupt running for that last part, or it is skipped.
+// Returns true if every check passed. Host build:
+//   gcc -O1 -DPERF_HOST -DTESTSUPPORT_HOST perf.c testSupport.c perfTest.c -o perfTest
+//   ./perfTest > perf.log && python3 perfSymbolize.py perfTest perf.log --nm nm
+bool perfTest_run();
+
+#endif /* PERFTEST_H_ */
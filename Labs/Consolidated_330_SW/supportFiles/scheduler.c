@@ -0,0 +1,367 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "scheduler.h"
+#include "interrupts.h"
+#include "timebase.h"
+#include "tickProfiler.h"
+#include "xil_exception.h"
+#include <stdio.h>
+
+#define SCHEDULER_US_PER_MS 1000
+#define SCHEDULER_MAX_PENDING_RELEASES 4        // Catch-up runs at most this many ticks back to back.
+#define SCHEDULER_MAX_DEGRADE_SHIFT 3           // Degrade stretches a period by at most 2^3.
+#define SCHEDULER_DEGRADE_RECOVERY_RUNS 20      // On-time runs before a degraded period is halved again.
+#define SCHEDULER_TICKLESS_MAX_SLEEP_MS 1000    // Longest one-shot. Keeps the sleep well inside 32-bit tick counts.
+#define SCHEDULER_TICKLESS_MIN_SLEEP_TICKS 100  // Shortest one-shot, for a release that is already due.
+#define SCHEDULER_PERCENT 100
+
+#define scheduler_waitForInterrupt() __asm__ __volatile__("wfi")
+
+typedef struct {
+  const char* name;                 // Used in reports.
+  scheduler_tickFunction_t tick;    // Called once per release.
+  uint32_t periodMs;                // Time between releases.
+  uint8_t priority;                 // Lower numbers win deadline ties.
+  bool enabledFlag;                 // Disabled tasks keep their schedule but are not released.
+  scheduler_policy_t policy;        // What to do with releases that arrive while the task is behind.
+  uint8_t periodShift;              // Degrade policy: the period is currently periodMs << periodShift.
+  uint8_t onTimeRunCount;           // Degrade policy: on-time runs since the last change of periodShift.
+  uint32_t nextReleaseMs;           // scheduler time of the next release.
+  uint32_t deadlineMs;              // The oldest pending release must finish before this time.
+  uint32_t pendingCount;            // Releases not yet run.
+  volatile bool readyFlag;          // True while the task is on the ready list or running.
+  scheduler_taskId_t next;          // Next task on the ready list.
+  tickProfiler_entry_t profile;     // Execution-time statistics for the tick.
+  uint32_t releaseCount;            // Times the period came around.
+  uint32_t runCount;                // Times the tick was called.
+  uint32_t overrunCount;            // Releases that found the task still behind.
+  uint32_t lostTickCount;           // Releases that were dropped and never run.
+  uint32_t deadlineMissCount;       // Ticks that finished at or after their deadline.
+} scheduler_task_t;
+
+static scheduler_task_t tasks[SCHEDULER_MAX_TASKS];
+static uint32_t taskCount = 0;
+static volatile scheduler_taskId_t readyHead = SCHEDULER_INVALID_TASK;  // Earliest deadline first.
+static volatile uint32_t nowMs = 0;     // Advanced by the timer interrupt.
+static uint32_t basePeriodMs = 0;       // Private-timer period chosen by scheduler_start().
+static uint32_t basePeriodTicks = 0;    // The same period in global-timer ticks.
+static uint32_t lastIsrTicks = 0;       // Global-timer value (low 32 bits) of the last period accounted for.
+static uint32_t missedInterruptCount = 0;  // Timer periods that passed without an interrupt.
+static bool runningFlag = false;        // Set by scheduler_start(); the ISR does nothing until then.
+static bool ticklessFlag = false;       // Set by scheduler_setTickless().
+static u64 startTime = 0;               // Global-timer value at scheduler_start(), for the load figure.
+static u64 idleTicks = 0;               // Global-timer ticks spent in WFI.
+static uint32_t wakeCount = 0;          // Times the idle loop came out of WFI.
+
+// Greatest common divisor, used to pick a timer period that lands on every task period.
+static uint32_t scheduler_gcd(uint32_t a, uint32_t b) {
+  while (b) {
+    uint32_t remainder = a % b;
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+
+// Current period of a task, including any stretching by the degrade policy.
+static uint32_t scheduler_effectivePeriodMs(const scheduler_task_t* task) {
+  return task->periodMs << task->periodShift;
+}
+
+// Inserts a task into the ready list in deadline order. Equal deadlines go by priority.
+// Called from the ISR, or from main with IRQs disabled.
+static void scheduler_insertReady(scheduler_taskId_t id) {
+  scheduler_task_t* task = &tasks[id];
+  volatile scheduler_taskId_t* link = &readyHead;
+  while (*link != SCHEDULER_INVALID_TASK) {
+    scheduler_task_t* other = &tasks[*link];
+    int32_t deadlineDifference = (int32_t) (task->deadlineMs - other->deadlineMs);  // Wrap-safe compare.
+    if (deadlineDifference < 0 || (deadlineDifference == 0 && task->priority < other->priority))
+      break;
+    link = &other->next;
+  }
+  task->next = *link;
+  *link = id;
+}
+
+// Handles one release of a task according to its policy. Called from the ISR.
+static void scheduler_release(scheduler_taskId_t id) {
+  scheduler_task_t* task = &tasks[id];
+  uint32_t releaseMs = task->nextReleaseMs;
+  task->releaseCount++;
+  if (task->pendingCount)
+    task->overrunCount++;
+  switch (task->policy) {
+  case scheduler_policy_catchUp:
+    if (task->pendingCount < SCHEDULER_MAX_PENDING_RELEASES)
+      task->pendingCount++;
+    else
+      task->lostTickCount++;
+    break;
+  case scheduler_policy_skip:
+    if (!task->pendingCount)
+      task->pendingCount = 1;
+    else
+      task->lostTickCount++;
+    break;
+  case scheduler_policy_degrade:
+    if (!task->pendingCount) {
+      task->pendingCount = 1;
+    } else {
+      task->lostTickCount++;
+      if (task->periodShift < SCHEDULER_MAX_DEGRADE_SHIFT)
+        task->periodShift++;
+      task->onTimeRunCount = 0;
+    }
+    break;
+  }
+  task->nextReleaseMs += scheduler_effectivePeriodMs(task);
+  if (!task->readyFlag) {
+    task->readyFlag = true;
+    task->deadlineMs = releaseMs + scheduler_effectivePeriodMs(task);
+    scheduler_insertReady(id);
+  }
+}
+
+// Removes all tasks and clears the statistics.
+void scheduler_init() {
+  taskCount = 0;
+  readyHead = SCHEDULER_INVALID_TASK;
+  nowMs = 0;
+  basePeriodMs = 0;
+  missedInterruptCount = 0;
+  runningFlag = false;
+  ticklessFlag = false;
+  idleTicks = 0;
+  wakeCount = 0;
+  tickProfiler_init();
+}
+
+// Registers a task.
+scheduler_taskId_t scheduler_addTask(const char* name, scheduler_tickFunction_t tick, uint32_t periodMs, uint8_t priority) {
+  if (taskCount >= SCHEDULER_MAX_TASKS || !periodMs || !tick) {
+    printf("scheduler_addTask: cannot add %s.\n\r", name);
+    return SCHEDULER_INVALID_TASK;
+  }
+  scheduler_task_t* task = &tasks[taskCount];
+  task->name = name;
+  task->tick = tick;
+  task->periodMs = periodMs;
+  task->priority = priority;
+  task->enabledFlag = true;
+  task->policy = scheduler_policy_catchUp;
+  task->periodShift = 0;
+  task->onTimeRunCount = 0;
+  task->nextReleaseMs = periodMs;
+  task->deadlineMs = 0;
+  task->pendingCount = 0;
+  task->readyFlag = false;
+  task->next = SCHEDULER_INVALID_TASK;
+  task->profile = tickProfiler_addEntry(name, periodMs * SCHEDULER_US_PER_MS);  // A tick longer than its period is an overrun.
+  task->releaseCount = task->runCount = task->overrunCount = task->lostTickCount = task->deadlineMissCount = 0;
+  return taskCount++;
+}
+
+// Selects what happens to releases that arrive while the task is behind.
+void scheduler_setPolicy(scheduler_taskId_t task, scheduler_policy_t policy) {
+  tasks[task].policy = policy;
+  tasks[task].periodShift = 0;
+}
+
+// Stops or resumes releases of a task.
+void scheduler_setTaskEnabled(scheduler_taskId_t task, bool enable) {
+  tasks[task].enabledFlag = enable;
+}
+
+// Selects tickless idle.
+void scheduler_setTickless(bool enable) {
+  ticklessFlag = enable;
+}
+
+// Tickless idle: arms the one-shot private timer for the earliest task release, or for the heartbeat
+// if that comes first. Called with IRQs disabled, just before WFI.
+static void scheduler_armNextWake() {
+  uint32_t sleepMs = SCHEDULER_TICKLESS_MAX_SLEEP_MS;
+  for (uint32_t i = 0; i < taskCount; i++) {
+    uint32_t untilReleaseMs = tasks[i].nextReleaseMs - nowMs;  // Always at least one base period.
+    if (untilReleaseMs < sleepMs)
+      sleepMs = untilReleaseMs;
+  }
+  // Releases fall on base-period boundaries counted from lastIsrTicks, the last boundary accounted for.
+  uint32_t wakeTicks = lastIsrTicks + sleepMs / basePeriodMs * basePeriodTicks;
+  int32_t sleepTicks = (int32_t) (wakeTicks - (uint32_t) timebase_nowTicks());
+  uint32_t heartbeatTicks = interrupts_getTicksToNextHeartbeat();
+  if (sleepTicks > 0 && (uint32_t) sleepTicks > heartbeatTicks)
+    sleepTicks = (int32_t) heartbeatTicks;
+  if (sleepTicks < SCHEDULER_TICKLESS_MIN_SLEEP_TICKS)
+    sleepTicks = SCHEDULER_TICKLESS_MIN_SLEEP_TICKS;
+  interrupts_armPrivateTimerOneShot((u32) sleepTicks - 1);
+}
+
+// Programs the private timer at the gcd of the task periods and starts it.
+int scheduler_start() {
+  if (!taskCount) {
+    printf("scheduler_start: no tasks.\n\r");
+    return SCHEDULER_STATUS_FAIL;
+  }
+  basePeriodMs = tasks[0].periodMs;
+  for (uint32_t i = 1; i < taskCount; i++)
+    basePeriodMs = scheduler_gcd(basePeriodMs, tasks[i].periodMs);
+  basePeriodTicks = basePeriodMs * TIMEBASE_TICKS_PER_MS;
+  if (timebase_setPeriodUs(basePeriodMs * SCHEDULER_US_PER_MS) != TIMEBASE_STATUS_OK)
+    return SCHEDULER_STATUS_FAIL;
+  interrupts_setPrivateTimerTickless(ticklessFlag);  // The first period runs like a periodic one either way.
+  interrupts_enableTimerGlobalInts();
+  runningFlag = true;
+  startTime = timebase_nowTicks();
+  lastIsrTicks = (uint32_t) startTime;
+  interrupts_startArmPrivateTimer();
+  return SCHEDULER_STATUS_OK;
+}
+
+// Releases tasks whose period has come around. Call from isr_function().
+void scheduler_isrTick() {
+  if (!runningFlag)
+    return;
+  // Timer interrupts that arrive while IRQs are masked collapse into one. The global timer tells how
+  // many periods really passed, so scheduler time and releases stay correct. Rounding absorbs IRQ latency.
+  uint32_t elapsedTicks = (uint32_t) timebase_nowTicks() - lastIsrTicks;
+  uint32_t periods;
+  if (ticklessFlag) {
+    // Skipping periods is the point here, and a heartbeat wake can land mid-period, so only whole
+    // periods count.
+    periods = elapsedTicks / basePeriodTicks;
+  } else {
+    periods = (elapsedTicks + basePeriodTicks / 2) / basePeriodTicks;
+    if (!periods)
+      periods = 1;
+    missedInterruptCount += periods - 1;
+  }
+  lastIsrTicks += periods * basePeriodTicks;
+  nowMs += periods * basePeriodMs;
+  for (scheduler_taskId_t id = 0; id < (scheduler_taskId_t) taskCount; id++)
+    while ((int32_t) (nowMs - tasks[id].nextReleaseMs) >= 0) {
+      if (tasks[id].enabledFlag)
+        scheduler_release(id);
+      else
+        tasks[id].nextReleaseMs += scheduler_effectivePeriodMs(&tasks[id]);
+    }
+}
+
+// Runs every ready task in deadline order, then sleeps until the next interrupt.
+void scheduler_runOnce() {
+  while (1) {
+    Xil_ExceptionDisable();
+    scheduler_taskId_t id = readyHead;
+    if (id == SCHEDULER_INVALID_TASK) {
+      // WFI wakes on a pending interrupt even with IRQs masked, so a release that lands between
+      // the check above and the WFI is not lost. The interrupt is taken once IRQs are unmasked.
+      if (ticklessFlag)
+        scheduler_armNextWake();
+      u64 sleepStart = timebase_nowTicks();
+      scheduler_waitForInterrupt();
+      idleTicks += timebase_nowTicks() - sleepStart;
+      wakeCount++;
+      Xil_ExceptionEnable();
+      tickProfiler_pollReportRequest();  // One register read unless a report was requested.
+      return;
+    }
+    readyHead = tasks[id].next;
+    scheduler_task_t* task = &tasks[id];
+    if (!task->enabledFlag) {  // Disabled since it was released: drop what it had pending.
+      task->pendingCount = 0;
+      task->readyFlag = false;
+      Xil_ExceptionEnable();
+      continue;
+    }
+    Xil_ExceptionEnable();
+    tickProfiler_run(task->profile, task->tick);
+    task->runCount++;
+    bool lateFlag = (int32_t) (nowMs - task->deadlineMs) >= 0;
+    if (lateFlag)
+      task->deadlineMissCount++;
+    Xil_ExceptionDisable();
+    if (task->policy == scheduler_policy_degrade) {  // Give back the full rate after a run of on-time ticks.
+      task->onTimeRunCount = lateFlag ? 0 : task->onTimeRunCount + 1;
+      if (task->periodShift && task->onTimeRunCount >= SCHEDULER_DEGRADE_RECOVERY_RUNS) {
+        task->periodShift--;
+        task->onTimeRunCount = 0;
+      }
+    }
+    task->pendingCount--;
+    if (task->pendingCount) {  // Catch-up: run the next pending release against its own deadline.
+      task->deadlineMs += scheduler_effectivePeriodMs(task);
+      scheduler_insertReady(id);
+    } else {
+      task->readyFlag = false;
+    }
+    Xil_ExceptionEnable();
+  }
+}
+
+uint32_t scheduler_getMs() {
+  return nowMs;
+}
+
+uint32_t scheduler_getBasePeriodMs() {
+  return basePeriodMs;
+}
+
+uint32_t scheduler_getTaskPeriodMs(scheduler_taskId_t task) {
+  return scheduler_effectivePeriodMs(&tasks[task]);
+}
+
+uint32_t scheduler_getOverrunCount(scheduler_taskId_t task) {
+  return tasks[task].overrunCount;
+}
+
+uint32_t scheduler_getLostTickCount(scheduler_taskId_t task) {
+  return tasks[task].lostTickCount;
+}
+
+uint32_t scheduler_getDeadlineMissCount(scheduler_taskId_t task) {
+  return tasks[task].deadlineMissCount;
+}
+
+uint32_t scheduler_getMissedInterruptCount() {
+  return missedInterruptCount;
+}
+
+// Restarts the CPU-load measurement.
+void scheduler_resetCpuLoad() {
+  startTime = timebase_nowTicks();
+  idleTicks = 0;
+  wakeCount = 0;
+}
+
+// Percentage of the time since the measurement started spent outside WFI.
+uint32_t scheduler_getCpuLoadPercent() {
+  u64 elapsed = timebase_nowTicks() - startTime;
+  if (!runningFlag || !elapsed)
+    return 0;
+  return (uint32_t) (SCHEDULER_PERCENT - idleTicks * SCHEDULER_PERCENT / elapsed);
+}
+
+uint32_t scheduler_getWakeCount() {
+  return wakeCount;
+}
+
+// Prints CPU load, then releases, runs, overruns, lost ticks and deadline misses for every task, then the tick profile.
+void scheduler_printReport() {
+  printf("scheduler: %ld ms elapsed, timer period %ld ms%s, %ld missed timer interrupts\n\r", (long) nowMs,
+         (long) basePeriodMs, ticklessFlag ? " (tickless)" : "", (long) missedInterruptCount);
+  printf("scheduler: CPU load %ld%%, %ld wake-ups from idle\n\r", (long) scheduler_getCpuLoadPercent(),
+         (long) wakeCount);
+  for (uint32_t i = 0; i < taskCount; i++) {
+    scheduler_task_t* task = &tasks[i];
+    printf("  %-24s period %4ld ms  releases %6ld  runs %6ld  overruns %4ld  lost %4ld  deadline misses %4ld\n\r",
+           task->name, (long) scheduler_effectivePeriodMs(task), (long) task->releaseCount, (long) task->runCount,
+           (long) task->overrunCount, (long) task->lostTickCount, (long) task->deadlineMissCount);
+  }
+  tickProfiler_printReport();
+}
@@ -0,0 +1,111 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Cooperative tick scheduler. Games register their tick functions with a period (ms) and a priority
+// instead of polling interrupts_isrFlagGlobal and calling a fixed list of ticks at one rate.
+// - The private timer runs at the greatest common divisor of the task periods.
+// - scheduler_isrTick() (call it from isr_function()) releases each task when its period comes
+//   around and inserts it into a ready list ordered by deadline (end of its period), ties going to priority.
+// - scheduler_runOnce() (call it from main) runs everything on the ready list and then sleeps in WFI
+//   until the next interrupt instead of spinning.
+// A release that finds the task still behind counts as an overrun, and the task's policy decides what
+// happens to it (see scheduler_policy_t). Releases that are dropped count as lost ticks, and a tick that
+// finishes after its deadline counts as a deadline miss.
+// The ISR checks the global timer, so timer interrupts that collapse into one while IRQs are masked
+// still advance scheduler time and release every period they covered (reported as missed interrupts).
+// Tickless idle (scheduler_setTickless()): instead of interrupting every base period, the private timer is
+// re-armed one-shot before each WFI for the earliest release (or the LD4 heartbeat, if sooner), so an idle
+// system wakes only when there is work. CPU load (time outside WFI) is measured either way.
+// Every tick is also timed by tickProfiler with its period as the budget; type TICKPROFILER_REPORT_KEY
+// on the UART while the scheduler idles to print the execution-time profile.
+
+#define SCHEDULER_MAX_TASKS 12        // Tasks that can be registered; the launcher registers every game's.
+#define SCHEDULER_INVALID_TASK -1     // Returned by scheduler_addTask() on failure.
+#define SCHEDULER_STATUS_OK 1         // Returned by scheduler_start() when the timer is running.
+#define SCHEDULER_STATUS_FAIL 0       // Returned by scheduler_start() if there is nothing to schedule.
+
+typedef void (*scheduler_tickFunction_t)();
+typedef int8_t scheduler_taskId_t;
+
+// What to do with a release that arrives before the task has run its previous one.
+typedef enum {
+  scheduler_policy_catchUp,   // Queue it and run the ticks back to back so tick-counted timing stays right (default).
+  scheduler_policy_skip,      // Drop it and count a lost tick. Timing that counts ticks runs slow.
+  scheduler_policy_degrade    // Drop it and double the task's period; halve it again after a run of on-time ticks.
+                              // For ticks that scale their work by scheduler_getTaskPeriodMs(), e.g. redraws.
+} scheduler_policy_t;
+
+// Registers a task. tick is called every periodMs. Lower priority numbers win deadline ties.
+// name is used in reports. Returns the task id, or SCHEDULER_INVALID_TASK if the table is full
+// or periodMs is 0. Register all tasks before scheduler_start().
+scheduler_taskId_t scheduler_addTask(const char* name, scheduler_tickFunction_t tick, uint32_t periodMs, uint8_t priority);
+
+// Removes all tasks and clears the statistics.
+void scheduler_init();
+
+// Selects the policy for releases that arrive while the task is behind.
+void scheduler_setPolicy(scheduler_taskId_t task, scheduler_policy_t policy);
+
+// Stops (enable false) or resumes releases of a task. A disabled task keeps its place in time, and
+// tickless idle still wakes when its period comes around, so main can poll for input there.
+// Releases still waiting to run when a task is disabled are dropped, so no tick runs after this returns.
+void scheduler_setTaskEnabled(scheduler_taskId_t task, bool enable);
+
+// Selects tickless idle. Call before scheduler_start().
+void scheduler_setTickless(bool enable);
+
+// Programs the private timer for the task periods and enables its interrupt. Assumes interrupts_initAll()
+// has been called. ARM interrupts are left to the caller (interrupts_enableArmInts()).
+int scheduler_start();
+
+// Runs every ready task in deadline order, then sleeps until the next interrupt.
+void scheduler_runOnce();
+
+// Call this from isr_function(). Releases tasks whose period has come around.
+void scheduler_isrTick();
+
+// Milliseconds since scheduler_start(), counted by the timer interrupt.
+uint32_t scheduler_getMs();
+
+// Period of the private timer chosen by scheduler_start().
+uint32_t scheduler_getBasePeriodMs();
+
+// Current period of the task. Longer than the registered period while the degrade policy is stretching it.
+uint32_t scheduler_getTaskPeriodMs(scheduler_taskId_t task);
+
+// Number of releases that found the task still behind.
+uint32_t scheduler_getOverrunCount(scheduler_taskId_t task);
+
+// Number of releases that were dropped by the task's policy and never run.
+uint32_t scheduler_getLostTickCount(scheduler_taskId_t task);
+
+// Number of timer periods that passed without their own interrupt. Always 0 with tickless idle.
+uint32_t scheduler_getMissedInterruptCount();
+
+// Percentage of the time since scheduler_start() (or scheduler_resetCpuLoad()) spent running rather
+// than sleeping in WFI.
+uint32_t scheduler_getCpuLoadPercent();
+
+// Restarts the CPU-load and wake-up counts, e.g. to measure one screen of a game.
+void scheduler_resetCpuLoad();
+
+// Number of times the idle loop woke from WFI.
+uint32_t scheduler_getWakeCount();
+
+// Number of ticks that finished at or after their deadline (when the next release came due).
+uint32_t scheduler_getDeadlineMissCount(scheduler_taskId_t task);
+
+// Prints CPU load, then releases, runs, overruns, lost ticks and deadline misses for every task, then the tick profile.
+void scheduler_printReport();
+
+#endif /* SCHEDULER_H_ */
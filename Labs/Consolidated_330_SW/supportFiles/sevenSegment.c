@@ -0,0 +1,131 @@
+/*
+ * sevenSegment.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "sevenSegment.h"
+#include "display.h"
+
+#define SEVENSEGMENT_BASE 10
+#define SEVENSEGMENT_BLANK 0x00         // No segments lit.
+#define SEVENSEGMENT_UNKNOWN 0xFF       // shown[] entry for a digit whose segments are not known.
+#define SEVENSEGMENT_ALL_SEGMENTS 0x7F
+
+// Segments lit for 0..9.
+static const uint8_t digitMasks[SEVENSEGMENT_BASE] = {
+  0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+void sevenSegment_init(sevenSegment_t* field, int16_t x, int16_t y, uint8_t digits, int16_t digitWidth,
+                       int16_t digitHeight, int16_t thickness, uint16_t color, uint16_t background, bool zeroPad) {
+  field->x = x;
+  field->y = y;
+  field->digits = digits > SEVENSEGMENT_MAX_DIGITS ? SEVENSEGMENT_MAX_DIGITS : digits;
+  field->digitWidth = digitWidth;
+  field->digitHeight = digitHeight;
+  field->thickness = thickness;
+  field->color = color;
+  field->background = background;
+  field->zeroPad = zeroPad;
+  for (uint8_t i = 0; i < SEVENSEGMENT_MAX_DIGITS; i++)
+    field->shown[i] = SEVENSEGMENT_UNKNOWN;
+}
+
+uint8_t sevenSegment_getMask(uint8_t digit) {
+  return digit < SEVENSEGMENT_BASE ? digitMasks[digit] : SEVENSEGMENT_BLANK;
+}
+
+// Writes the mask of every digit for value into masks, leftmost first.
+static void sevenSegment_format(const sevenSegment_t* field, uint32_t value, uint8_t* masks) {
+  uint8_t digits = field->digits;
+  if (!digits)
+    return;
+  if (digits < SEVENSEGMENT_MAX_DIGITS) {  // Any uint32_t fits in SEVENSEGMENT_MAX_DIGITS.
+    uint32_t largest = 0;  // All 9s: the largest value the field can show.
+    for (uint8_t i = 0; i < digits; i++)
+      largest = largest * SEVENSEGMENT_BASE + (SEVENSEGMENT_BASE - 1);
+    if (value > largest)
+      value = largest;
+  }
+  int8_t i = digits - 1;
+  do {
+    masks[i--] = digitMasks[value % SEVENSEGMENT_BASE];
+    value /= SEVENSEGMENT_BASE;
+  } while (value && i >= 0);
+  uint8_t pad = field->zeroPad ? digitMasks[0] : SEVENSEGMENT_BLANK;
+  while (i >= 0)
+    masks[i--] = pad;
+}
+
+// Fills one segment of a digit in color. The vertical segments fit between the horizontal ones, so
+// no two segments overlap.
+static void sevenSegment_fillSegment(const sevenSegment_t* field, uint8_t digit, uint8_t segment, uint16_t color) {
+  int16_t t = field->thickness;
+  int16_t w = field->digitWidth;
+  int16_t h = field->digitHeight;
+  int16_t middle = (h - t) / 2;         // Top of segment g.
+  int16_t left = field->x + digit * (w + t);
+  int16_t top = field->y;
+  switch (segment) {
+    case 0:  // a
+      display_fillRect(left + t, top, w - 2 * t, t, color);
+      break;
+    case 1:  // b
+      display_fillRect(left + w - t, top + t, t, middle - t, color);
+      break;
+    case 2:  // c
+      display_fillRect(left + w - t, top + middle + t, t, h - middle - 2 * t, color);
+      break;
+    case 3:  // d
+      display_fillRect(left + t, top + h - t, w - 2 * t, t, color);
+      break;
+    case 4:  // e
+      display_fillRect(left, top + middle + t, t, h - middle - 2 * t, color);
+      break;
+    case 5:  // f
+      display_fillRect(left, top + t, t, middle - t, color);
+      break;
+    default:  // g
+      display_fillRect(left + t, top + middle, w - 2 * t, t, color);
+      break;
+  }
+}
+
+uint8_t sevenSegment_update(sevenSegment_t* field, uint32_t value) {
+  uint8_t masks[SEVENSEGMENT_MAX_DIGITS];
+  sevenSegment_format(field, value, masks);
+  uint8_t filled = 0;
+  for (uint8_t i = 0; i < field->digits; i++) {
+    uint8_t shown = field->shown[i];
+    // Segments that differ; every segment if what is on the screen is not known.
+    uint8_t changed = shown == SEVENSEGMENT_UNKNOWN ? SEVENSEGMENT_ALL_SEGMENTS : (shown ^ masks[i]);
+    for (uint8_t segment = 0; changed; segment++, changed >>= 1) {
+      if (changed & 1) {
+        sevenSegment_fillSegment(field, i, segment, (masks[i] >> segment) & 1 ? field->color : field->background);
+        filled++;
+      }
+    }
+    field->shown[i] = masks[i];
+  }
+  return filled;
+}
+
+void sevenSegment_draw(sevenSegment_t* field, uint32_t value) {
+  for (uint8_t i = 0; i < field->digits; i++)
+    field->shown[i] = SEVENSEGMENT_UNKNOWN;
+  sevenSegment_update(field, value);
+}
+
+void sevenSegment_erase(sevenSegment_t* field) {
+  display_fillRect(field->x, field->y, sevenSegment_getWidth(field), field->digitHeight, field->background);
+  for (uint8_t i = 0; i < field->digits; i++)
+    field->shown[i] = SEVENSEGMENT_BLANK;
+}
+
+int16_t sevenSegment_getWidth(const sevenSegment_t* field) {
+  if (!field->digits)
+    return 0;
+  return field->digits * (field->digitWidth + field->thickness) - field->thickness;
+}
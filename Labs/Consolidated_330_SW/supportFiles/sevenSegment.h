@@ -0,0 +1,63 @@
+/*
+ * sevenSegment.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SEVENSEGMENT_H_
+#define SEVENSEGMENT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Large numbers drawn as seven-segment digits, e.g., the time on the clock.
+// - Each segment is one fillRect, so a digit of any size is at most seven rectangles, where a scaled font
+//   character is dozens.
+// - The field remembers the segments each digit shows. Changing a digit fills only the segments in the
+//   XOR of the old and new masks: those turning on in the color, those turning off in the background.
+//   8 -> 9 is one rectangle, 9 -> 0 two.
+// - Digits are produced by division, not sprintf. Values too large for the field show as all 9s.
+//
+//      aaa
+//     f   b        Segment bits: a = bit 0 ... g = bit 6.
+//     f   b
+//      ggg
+//     e   c
+//     e   c
+//      ddd
+
+#define SEVENSEGMENT_MAX_DIGITS 10      // Enough for any uint32_t.
+#define SEVENSEGMENT_SEGMENTS 7
+
+typedef struct {
+  int16_t x, y;                         // Top-left corner of the first digit.
+  uint8_t digits;                       // Digits in the field.
+  int16_t digitWidth, digitHeight;      // Size of one digit.
+  int16_t thickness;                    // Width of a segment; also the gap between digits.
+  uint16_t color;
+  uint16_t background;
+  bool zeroPad;                         // Leading zeros if set, leading blanks if not.
+  uint8_t shown[SEVENSEGMENT_MAX_DIGITS];  // Segment mask of each digit on the screen, or unknown.
+} sevenSegment_t;
+
+// Sets up a field of digits digits (at most SEVENSEGMENT_MAX_DIGITS) at (x, y). Nothing is drawn.
+void sevenSegment_init(sevenSegment_t* field, int16_t x, int16_t y, uint8_t digits, int16_t digitWidth,
+                       int16_t digitHeight, int16_t thickness, uint16_t color, uint16_t background, bool zeroPad);
+
+// Draws every segment of the field showing value, e.g., after the screen was cleared.
+void sevenSegment_draw(sevenSegment_t* field, uint32_t value);
+
+// Shows value, filling only the segments that change. Returns the number of rectangles filled.
+uint8_t sevenSegment_update(sevenSegment_t* field, uint32_t value);
+
+// Paints the whole field in its background color.
+void sevenSegment_erase(sevenSegment_t* field);
+
+// Width of the field in pixels.
+int16_t sevenSegment_getWidth(const sevenSegment_t* field);
+
+// Segment mask of a decimal digit (0..9).
+uint8_t sevenSegment_getMask(uint8_t digit);
+
+#endif /* SEVENSEGMENT_H_ */
@@ -0,0 +1,160 @@
+/*
+ * sevenSegmentTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "sevenSegmentTest.h"
+#include "testSupport.h"
+#include "sevenSegment.h"
+#include "display.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_X 10                       // Where the test field is drawn.
+#define TEST_Y 10
+#define TEST_DIGITS 3
+#define TEST_DIGIT_WIDTH 30             // The size of the clock digits.
+#define TEST_DIGIT_HEIGHT 48
+#define TEST_THICKNESS 6
+#define TEST_LARGEST 999                // Largest value TEST_DIGITS digits show.
+#define TEST_COUNT_TO 1000              // Counts past the largest value the field shows.
+
+typedef struct {
+  uint8_t from, to;
+  uint8_t rectangles;                   // Segments that differ.
+} sevenSegmentTest_step_t;
+
+static const sevenSegmentTest_step_t digitSteps[] = {
+  {8, 9, 1}, {9, 0, 2}, {1, 7, 1}, {0, 8, 1}, {5, 6, 1}, {1, 2, 5}, {3, 3, 0},
+};
+
+#ifdef SEVENSEGMENT_HOST
+// ******************************** host display *********************************
+#define HOST_WIDTH (TEST_X + TEST_DIGITS * (TEST_DIGIT_WIDTH + TEST_THICKNESS))
+#define HOST_HEIGHT (TEST_Y + TEST_DIGIT_HEIGHT)
+#define HOST_UNPAINTED 0x1234           // Color of a pixel nothing has been drawn on.
+
+static uint16_t frameBuffer[HOST_HEIGHT][HOST_WIDTH];
+static bool outOfBounds;                // Set if anything is drawn outside the frame buffer.
+
+void display_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > HOST_WIDTH || y + h > HOST_HEIGHT) {
+    outOfBounds = true;
+    return;
+  }
+  for (int16_t row = y; row < y + h; row++)
+    for (int16_t column = x; column < x + w; column++)
+      frameBuffer[row][column] = color;
+}
+
+// Fills the frame buffer with HOST_UNPAINTED.
+static void sevenSegmentTest_clearFrameBuffer() {
+  for (int16_t row = 0; row < HOST_HEIGHT; row++)
+    for (int16_t column = 0; column < HOST_WIDTH; column++)
+      frameBuffer[row][column] = HOST_UNPAINTED;
+}
+#endif
+
+#ifdef SEVENSEGMENT_HOST
+// True if every segment of every digit on the screen is lit exactly when the value says it should be,
+// judged by the pixel in the middle of the segment.
+static bool sevenSegmentTest_showsValue(const sevenSegment_t* field, uint32_t value) {
+  int16_t t = TEST_THICKNESS;
+  int16_t w = TEST_DIGIT_WIDTH;
+  int16_t h = TEST_DIGIT_HEIGHT;
+  int16_t middle = (h - t) / 2;
+  // Middle of segments a..g, relative to the top-left corner of a digit.
+  const int segmentX[SEVENSEGMENT_SEGMENTS] = {w / 2, w - t / 2, w - t / 2, w / 2, t / 2, t / 2, w / 2};
+  const int segmentY[SEVENSEGMENT_SEGMENTS] = {t / 2, (t + middle) / 2, (middle + h) / 2, h - t / 2,
+                                               (middle + h) / 2, (t + middle) / 2, middle + t / 2};
+  if (value > TEST_LARGEST)
+    value = TEST_LARGEST;
+  for (int8_t i = field->digits - 1; i >= 0; i--) {
+    uint8_t mask = value || i == field->digits - 1 || field->zeroPad ? sevenSegment_getMask(value % 10) : 0;
+    value /= 10;
+    for (uint8_t segment = 0; segment < SEVENSEGMENT_SEGMENTS; segment++) {
+      uint16_t pixel = frameBuffer[field->y + segmentY[segment]][field->x + i * (w + t) + segmentX[segment]];
+      if (pixel != ((mask >> segment) & 1 ? field->color : field->background))
+        return false;
+    }
+  }
+  return true;
+}
+#endif
+
+static void sevenSegmentTest_runMaskChecks() {
+  sevenSegment_t field;
+  sevenSegment_init(&field, TEST_X, TEST_Y, 1, TEST_DIGIT_WIDTH, TEST_DIGIT_HEIGHT, TEST_THICKNESS, DISPLAY_RED,
+                    DISPLAY_BLACK, true);
+  testSupport_check(sevenSegment_getMask(8) == 0x7F, "8 lights every segment");
+  testSupport_check(sevenSegment_getMask(1) == 0x06, "1 is segments b and c");
+  testSupport_check(sevenSegment_getMask(10) == 0, "not a digit is blank");
+  for (uint16_t i = 0; i < sizeof(digitSteps) / sizeof(digitSteps[0]); i++) {
+    sevenSegment_draw(&field, digitSteps[i].from);
+    uint8_t filled = sevenSegment_update(&field, digitSteps[i].to);
+    if (filled != digitSteps[i].rectangles) {
+      printf("sevenSegmentTest: %d -> %d filled %d, expected %d\n\r", digitSteps[i].from, digitSteps[i].to, filled,
+             digitSteps[i].rectangles);
+      testSupport_check(false, "digit change");
+    }
+  }
+}
+
+static void sevenSegmentTest_runUpdateChecks() {
+  sevenSegment_t field;
+  sevenSegment_init(&field, TEST_X, TEST_Y, TEST_DIGITS, TEST_DIGIT_WIDTH, TEST_DIGIT_HEIGHT, TEST_THICKNESS,
+                    DISPLAY_RED, DISPLAY_BLACK, false);
+  testSupport_check(sevenSegment_update(&field, 7) == TEST_DIGITS * SEVENSEGMENT_SEGMENTS,
+                    "first update fills every segment");
+  testSupport_check(sevenSegment_update(&field, 7) == 0, "same value filled");
+  testSupport_check(sevenSegment_update(&field, 17) == 2, "blank -> 1 fills b and c");
+  testSupport_check(sevenSegment_update(&field, 1000) == 6 + 4 + 3, "too large shows 999");  // Blank, 1 and 7 -> 9.
+  sevenSegment_erase(&field);
+  testSupport_check(sevenSegment_update(&field, 0) == 6, "update after erase");
+  testSupport_check(sevenSegment_getWidth(&field) == TEST_DIGITS * (TEST_DIGIT_WIDTH + TEST_THICKNESS) - TEST_THICKNESS,
+                    "width");
+  sevenSegment_init(&field, TEST_X, TEST_Y, TEST_DIGITS, TEST_DIGIT_WIDTH, TEST_DIGIT_HEIGHT, TEST_THICKNESS,
+                    DISPLAY_RED, DISPLAY_BLACK, true);
+  sevenSegment_draw(&field, 0);
+  testSupport_check(sevenSegment_update(&field, 5) == 3, "zero padded 000 -> 005");
+#ifdef SEVENSEGMENT_HOST
+  // Count up; after every step the screen must be what a fresh draw of the value gives.
+  static uint16_t expected[HOST_HEIGHT][HOST_WIDTH];
+  sevenSegment_t fresh = field;
+  bool matches = true;
+  sevenSegmentTest_clearFrameBuffer();
+  sevenSegment_draw(&field, 0);
+  for (uint32_t value = 0; value <= TEST_COUNT_TO && matches; value++) {
+    sevenSegment_update(&field, value);
+    memcpy(expected, frameBuffer, sizeof(frameBuffer));
+    sevenSegmentTest_clearFrameBuffer();
+    sevenSegment_draw(&fresh, value);
+    matches = memcmp(expected, frameBuffer, sizeof(frameBuffer)) == 0 && sevenSegmentTest_showsValue(&fresh, value);
+    memcpy(frameBuffer, expected, sizeof(frameBuffer));
+  }
+  testSupport_check(matches, "updated screen differs from a fresh draw");
+  testSupport_check(!outOfBounds, "drawn outside the field");
+#else
+  // Count up on the screen; each step only fills the segments that change.
+  sevenSegment_draw(&field, 0);
+  for (uint32_t value = 0; value <= TEST_COUNT_TO; value++)
+    sevenSegment_update(&field, value);
+#endif
+}
+
+bool sevenSegmentTest_run() {
+  testSupport_begin("sevenSegmentTest");
+  sevenSegmentTest_runMaskChecks();
+  sevenSegmentTest_runUpdateChecks();
+  return testSupport_end();
+}
+
+#ifdef SEVENSEGMENT_HOST
+// host entry point; the board build calls sevenSegmentTest_run()
+int main() {
+  return sevenSegmentTest_run() ? 0 : 1;
+}
+#endif
@@ -0,0 +1,19 @@
+/*
+ * sevenSegmentTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SEVENSEGMENTTEST_H_
+#define SEVENSEGMENTTEST_H_
+
+#include <stdbool.h>
+
+// Checks the sevenSegment digit masks, how many rectangles each update fills, padding and oversized values;
+// on the host each update is also compared pixel by pixel with a fresh draw. On the board it draws on the LCD.
+// Returns true if every check passed. Host build:
+//   g++ -x c++ -O2 -DSEVENSEGMENT_HOST -DTESTSUPPORT_HOST sevenSegment.c testSupport.c sevenSegmentTest.c -o sevenSegmentTest
+bool sevenSegmentTest_run();
+
+#endif /* SEVENSEGMENTTEST_H_ */
@@ -10,6 +10,7 @@
 #include "arduinoTypes.h"
 #include "xil_io.h"
 #include "utils.h"
+#include "delay.h"
 
 void spi_begin(void) {
   spi_softwareReset();  // Just reset the SPI hardware in the ZYNQ fabric.
@@ -155,12 +156,10 @@ void spi_clearAllSlaveSelects() {
   spi_writeRegister(SPI_SLAVE_SELECT_REG_OFFSET, 0xFFFFFFFF);
 }
 
-// Uses for-loop for delay. Delay will be delay * milliseconds, approximately.
+// Delays for delay milliseconds, timed by the global timer (see delay.h).
 // These delays are generally used by the adafruit code.
 void spi_delay(uint32_t delay) {
-  volatile uint32_t count;
-  count = delay * SPI_DELAY_FUDGE_FACTOR;
-  while (count--);
+  delay_ms(delay);
 }
 
 // Software reset of the SPI controller. Needs to be invoked prior to programming the SPI controller
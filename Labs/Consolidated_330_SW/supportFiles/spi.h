@@ -56,8 +56,6 @@
 #define SPI_TRANSMIT_FIFO_OCC_REG_OFFSET 0x74
 #define SPI_RECEIVE_FIFO_OCC_REG_OFFSET 0x78
 
-#define SPI_DELAY_FUDGE_FACTOR 10000  // This is the multiplier to get the delay value of 1 to be 1 millisecond.
-
 #define SPI_TFT_SLAVE_SELECT_MASK 0x00000001  // TFT SPI slave select is bit 0 (only used if LCD is accessed via SPI - deprecated).
 #define SPI_TOUCH_SCREEN_CONTROLLER_SLAVE_SELECT_MASK 0x00000002 // Touch-screen controller slave select is bit 1.
 #define SPI_BLUETOOTH_RADIO_SLAVE_SELECT_MASK 0x00000004 // Bluetooth-radio slave-select is bit 3.
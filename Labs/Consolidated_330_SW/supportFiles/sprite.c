@@ -0,0 +1,226 @@
+/*
+ * sprite.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "sprite.h"
+#include "display.h"
+#include <string.h>
+
+#define SPRITE_SKIP_SHIFT 8             // Position of the skip in the first word of a run.
+#define SPRITE_LENGTH_MASK 0xFF         // The length in the first word of a run.
+
+// One decoded run of a row.
+typedef struct {
+  int16_t start;
+  int16_t length;
+  uint16_t color;
+} sprite_run_t;
+
+static uint32_t pixelCount;             // Pixels sent since the last reset.
+
+// Sends a run of pixels to the display.
+static void sprite_fillRun(int16_t x, int16_t y, int16_t length, uint16_t color) {
+  display_drawFastHLine(x, y, length, color);
+  pixelCount += length;
+}
+
+// Decodes row of frame into runs, skipping empty ones. Returns the number of runs, or
+// SPRITE_MAX_RUNS_PER_ROW + 1 if the row has more than fit.
+static uint16_t sprite_decodeRow(const sprite_frame_t* frame, uint16_t row, sprite_run_t* runs) {
+  uint16_t count = 0;
+  int16_t position = 0;
+  for (uint16_t i = frame->rowOffsets[row]; i < frame->rowOffsets[row + 1]; i += SPRITE_RUN_WORDS) {
+    uint16_t length = frame->runs[i] & SPRITE_LENGTH_MASK;
+    position += frame->runs[i] >> SPRITE_SKIP_SHIFT;
+    if (length) {
+      if (count == SPRITE_MAX_RUNS_PER_ROW)
+        return SPRITE_MAX_RUNS_PER_ROW + 1;
+      runs[count].start = position;
+      runs[count].length = length;
+      runs[count].color = frame->runs[i + 1];
+      count++;
+    }
+    position += length;
+  }
+  return count;
+}
+
+// Draws row of frame at (x, y) in its own colors, or all in one color if useColor is set.
+static void sprite_drawRow(const sprite_frame_t* frame, uint16_t row, int16_t x, int16_t y, bool useColor,
+                           uint16_t color) {
+  int16_t position = 0;
+  for (uint16_t i = frame->rowOffsets[row]; i < frame->rowOffsets[row + 1]; i += SPRITE_RUN_WORDS) {
+    uint16_t length = frame->runs[i] & SPRITE_LENGTH_MASK;
+    position += frame->runs[i] >> SPRITE_SKIP_SHIFT;
+    if (length)
+      sprite_fillRun(x + position, y, length, useColor ? color : frame->runs[i + 1]);
+    position += length;
+  }
+}
+
+// True if row encodes the same in both frames.
+static bool sprite_rowsMatch(const sprite_frame_t* a, const sprite_frame_t* b, uint16_t row) {
+  uint16_t words = a->rowOffsets[row + 1] - a->rowOffsets[row];
+  return words == b->rowOffsets[row + 1] - b->rowOffsets[row] &&
+         memcmp(&a->runs[a->rowOffsets[row]], &b->runs[b->rowOffsets[row]], words * sizeof(uint16_t)) == 0;
+}
+
+// Redraws one row that differs between from and to: the runs of to that from does not already show,
+// then background over the pixels of from that no run of to covers.
+static void sprite_drawRowDelta(const sprite_frame_t* from, const sprite_frame_t* to, uint16_t row, int16_t x,
+                                int16_t y, uint16_t background) {
+  sprite_run_t fromRuns[SPRITE_MAX_RUNS_PER_ROW];
+  sprite_run_t toRuns[SPRITE_MAX_RUNS_PER_ROW];
+  uint16_t fromCount = sprite_decodeRow(from, row, fromRuns);
+  uint16_t toCount = sprite_decodeRow(to, row, toRuns);
+  if (fromCount > SPRITE_MAX_RUNS_PER_ROW || toCount > SPRITE_MAX_RUNS_PER_ROW) {
+    sprite_drawRow(from, row, x, y, true, background);  // Too busy to compare: erase and redraw.
+    sprite_drawRow(to, row, x, y, false, 0);
+    return;
+  }
+  for (uint16_t t = 0; t < toCount; t++) {
+    bool shown = false;
+    for (uint16_t f = 0; f < fromCount && !shown; f++)
+      shown = fromRuns[f].start == toRuns[t].start && fromRuns[f].length == toRuns[t].length &&
+              fromRuns[f].color == toRuns[t].color;
+    if (!shown)
+      sprite_fillRun(x + toRuns[t].start, y, toRuns[t].length, toRuns[t].color);
+  }
+  // Runs are in order along the row, so each from run is clipped by the to runs from left to right.
+  for (uint16_t f = 0; f < fromCount; f++) {
+    int16_t position = fromRuns[f].start;
+    int16_t end = fromRuns[f].start + fromRuns[f].length;
+    for (uint16_t t = 0; t < toCount && position < end; t++) {
+      int16_t toEnd = toRuns[t].start + toRuns[t].length;
+      if (toEnd <= position)
+        continue;
+      if (toRuns[t].start > position)
+        sprite_fillRun(x + position, y, (toRuns[t].start < end ? toRuns[t].start : end) - position, background);
+      position = toEnd;
+    }
+    if (position < end)
+      sprite_fillRun(x + position, y, end - position, background);
+  }
+}
+
+// Appends one run to the words being encoded. Returns false if there is no room.
+static bool sprite_appendRun(uint16_t* runs, uint32_t runCapacity, uint32_t* used, uint16_t skip, uint16_t length,
+                             uint16_t color) {
+  if (*used + SPRITE_RUN_WORDS > runCapacity)
+    return false;
+  runs[(*used)++] = (skip << SPRITE_SKIP_SHIFT) | length;
+  runs[(*used)++] = color;
+  return true;
+}
+
+uint32_t sprite_encode(sprite_frame_t* frame, uint16_t* rowOffsets, uint16_t* runs, uint32_t runCapacity,
+                       uint16_t width, uint16_t height, sprite_pixelFunction_t pixel, void* context) {
+  uint32_t used = 0;
+  for (uint16_t y = 0; y < height; y++) {
+    rowOffsets[y] = used;
+    uint16_t skip = 0;
+    uint16_t x = 0;
+    while (x < width) {
+      uint32_t color = pixel(x, y, context);
+      if (color == SPRITE_TRANSPARENT) {
+        x++;
+        if (++skip == SPRITE_MAX_RUN) {  // Too long a gap for one run: emit it as an empty run.
+          if (!sprite_appendRun(runs, runCapacity, &used, skip, 0, 0))
+            return 0;
+          skip = 0;
+        }
+        continue;
+      }
+      uint16_t length = 0;
+      while (x < width && length < SPRITE_MAX_RUN && pixel(x, y, context) == color) {
+        x++;
+        length++;
+      }
+      if (!sprite_appendRun(runs, runCapacity, &used, skip, length, (uint16_t) color))
+        return 0;
+      skip = 0;
+    }
+  }
+  rowOffsets[height] = used;
+  frame->width = width;
+  frame->height = height;
+  frame->rowOffsets = rowOffsets;
+  frame->runs = runs;
+  return used;
+}
+
+void sprite_draw(const sprite_frame_t* frame, int16_t x, int16_t y) {
+  for (uint16_t row = 0; row < frame->height; row++)
+    sprite_drawRow(frame, row, x, y + row, false, 0);
+}
+
+void sprite_drawDelta(const sprite_frame_t* from, const sprite_frame_t* to, int16_t x, int16_t y, uint16_t background) {
+  if (from == to)
+    return;
+  if (!from || !to || from->width != to->width || from->height != to->height) {
+    if (from) {  // Nothing in common: erase all of from, then draw all of to.
+      for (uint16_t row = 0; row < from->height; row++)
+        sprite_drawRow(from, row, x, y + row, true, background);
+    }
+    if (to)
+      sprite_draw(to, x, y);
+    return;
+  }
+  for (uint16_t row = 0; row < to->height; row++) {
+    if (!sprite_rowsMatch(from, to, row))
+      sprite_drawRowDelta(from, to, row, x, y + row, background);
+  }
+}
+
+void sprite_initPlayer(sprite_player_t* player, int16_t x, int16_t y, const sprite_frame_t* shown, uint16_t background) {
+  player->animation = NULL;
+  player->shown = shown;
+  player->x = x;
+  player->y = y;
+  player->background = background;
+  player->frame = 0;
+  player->ticksLeft = 0;
+}
+
+void sprite_play(sprite_player_t* player, const sprite_animation_t* animation) {
+  const sprite_frame_t* first = animation->frames[0];
+  sprite_drawDelta(player->shown, first, player->x, player->y, player->background);
+  player->animation = animation;
+  player->shown = first;
+  player->frame = 0;
+  player->ticksLeft = animation->ticksPerFrame;
+}
+
+bool sprite_tick(sprite_player_t* player) {
+  if (!player->animation)
+    return false;
+  if (player->ticksLeft > 1) {
+    player->ticksLeft--;
+    return true;
+  }
+  if (player->frame + 1 >= player->animation->frameCount) {
+    player->animation = NULL;  // Done; the last frame stays up.
+    return false;
+  }
+  player->frame++;
+  const sprite_frame_t* next = player->animation->frames[player->frame];
+  sprite_drawDelta(player->shown, next, player->x, player->y, player->background);
+  player->shown = next;
+  player->ticksLeft = player->animation->ticksPerFrame;
+  return true;
+}
+
+bool sprite_isPlaying(const sprite_player_t* player) {
+  return player->animation != NULL;
+}
+
+uint32_t sprite_getPixelCount() {
+  return pixelCount;
+}
+
+void sprite_resetPixelCount() {
+  pixelCount = 0;
+}
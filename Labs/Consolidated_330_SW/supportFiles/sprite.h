@@ -0,0 +1,86 @@
+/*
+ * sprite.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SPRITE_H_
+#define SPRITE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Run-length encoded RGB565 sprites with transparency, and a player for multi-frame animations.
+// - A frame is a list of runs per row. Each run is two words: (skip << 8) | length, then the color:
+//   skip transparent pixels (counted from the end of the previous run), then length pixels of color.
+//   Solid shapes like discs take a handful of runs per row no matter how wide they are.
+// - rowOffsets[r] .. rowOffsets[r + 1] are the words of row r, so a row can be found and compared
+//   without decoding the rows above it.
+// - Frames can be const tables in flash (see spriteEncode.py) or built at run time with sprite_encode().
+// - sprite_drawDelta() draws a frame over the previous one and only sends what changed: rows that
+//   encode the same are skipped, and in a changed row only the runs that differ are drawn.
+//   Pixels that turn transparent are painted with a background color.
+// - Animations step through frames on calls to sprite_tick(), e.g., from a state machine tick.
+
+#define SPRITE_TRANSPARENT 0x10000UL    // Returned by a sprite_pixelFunction_t for a transparent pixel.
+#define SPRITE_MAX_RUN 255              // Longest skip or run in one run; longer ones are split.
+#define SPRITE_RUN_WORDS 2              // Words per run.
+#define SPRITE_MAX_RUNS_PER_ROW 32      // Rows with more runs than this are drawn in full by sprite_drawDelta().
+
+typedef struct {
+  uint16_t width;
+  uint16_t height;
+  const uint16_t* rowOffsets;           // height + 1 entries, in words into runs.
+  const uint16_t* runs;
+} sprite_frame_t;
+
+typedef struct {
+  const sprite_frame_t* const* frames;
+  uint8_t frameCount;
+  uint8_t ticksPerFrame;                // Calls to sprite_tick() each frame stays up.
+} sprite_animation_t;
+
+typedef struct {
+  const sprite_animation_t* animation;  // Playing animation, NULL when stopped.
+  const sprite_frame_t* shown;          // Frame on the screen, NULL if none.
+  int16_t x, y;                         // Top-left corner of the frames.
+  uint16_t background;                  // Color behind transparent pixels.
+  uint8_t frame;                        // Index of the shown frame in animation.
+  uint8_t ticksLeft;                    // Ticks until the next frame.
+} sprite_player_t;
+
+// Color of pixel (x, y) of a sprite being encoded, or SPRITE_TRANSPARENT.
+typedef uint32_t (*sprite_pixelFunction_t)(int16_t x, int16_t y, void* context);
+
+// Encodes a width x height sprite whose pixels come from pixel() into frame, using rowOffsets
+// (height + 1 words) and up to runCapacity words of runs. Returns the words of runs used, 0 if they
+// did not fit.
+uint32_t sprite_encode(sprite_frame_t* frame, uint16_t* rowOffsets, uint16_t* runs, uint32_t runCapacity,
+                       uint16_t width, uint16_t height, sprite_pixelFunction_t pixel, void* context);
+
+// Draws frame with its top-left corner at (x, y). Transparent pixels are left alone.
+void sprite_draw(const sprite_frame_t* frame, int16_t x, int16_t y);
+
+// Changes the screen at (x, y) from showing from to showing to, drawing only what differs.
+// Either frame may be NULL (nothing shown). Pixels of from that are transparent in to get background.
+void sprite_drawDelta(const sprite_frame_t* from, const sprite_frame_t* to, int16_t x, int16_t y, uint16_t background);
+
+// Sets up player at (x, y) showing shown (already on the screen, or NULL), with nothing playing.
+void sprite_initPlayer(sprite_player_t* player, int16_t x, int16_t y, const sprite_frame_t* shown, uint16_t background);
+
+// Starts animation from the frame on the screen: its first frame is drawn now.
+void sprite_play(sprite_player_t* player, const sprite_animation_t* animation);
+
+// Advances player by a tick, drawing the next frame when it is due. The last frame stays on the screen.
+// Returns true while the animation is still playing.
+bool sprite_tick(sprite_player_t* player);
+
+// True while player has an animation playing.
+bool sprite_isPlaying(const sprite_player_t* player);
+
+// Pixels sent to the display by the functions above since the last reset; a measure of bus traffic.
+uint32_t sprite_getPixelCount();
+void sprite_resetPixelCount();
+
+#endif /* SPRITE_H_ */
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#
+# spriteEncode.py
+#
+#  Created on: Oct 19, 2026
+#      Author: cdmoo
+#
+# Converts a binary PPM image (P6, 8 bits per channel) into a const sprite_frame_t (sprite.h), so the
+# sprite sits in flash instead of being built at run time. Pixels of the --transparent color become
+# transparent. Export from any paint program as .ppm, then:
+#   python3 spriteEncode.py mole.ppm moleSprite --transparent 00ff00 > moleSprite.h
+
+import argparse
+import sys
+
+MAX_RUN = 255      # SPRITE_MAX_RUN
+SKIP_SHIFT = 8     # runs are (skip << 8) | length, then the color
+
+
+def readPpm(path):
+    with open(path, "rb") as image:
+        data = image.read()
+    fields, position = [], 0
+    while len(fields) < 4:  # magic, width, height, maximum value; '#' starts a comment
+        while data[position:position + 1].isspace():
+            position += 1
+        if data[position:position + 1] == b"#":
+            position = data.index(b"\n", position)
+            continue
+        start = position
+        while not data[position:position + 1].isspace():
+            position += 1
+        fields.append(data[start:position])
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        sys.exit("%s: only 8-bit binary PPM (P6) is supported" % path)
+    width, height = int(fields[1]), int(fields[2])
+    pixels = data[position + 1:]
+    return width, height, [tuple(pixels[i:i + 3]) for i in range(0, 3 * width * height, 3)]
+
+
+def rgb565(red, green, blue):
+    return ((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3)
+
+
+def encode(width, height, pixels, transparent):
+    rowOffsets, runs = [], []
+    for y in range(height):
+        rowOffsets.append(len(runs))
+        row = pixels[y * width:(y + 1) * width]
+        x = skip = 0
+        while x < width:
+            if row[x] == transparent:
+                x += 1
+                skip += 1
+                if skip == MAX_RUN:
+                    runs += [skip << SKIP_SHIFT, 0]
+                    skip = 0
+                continue
+            color, length = row[x], 0
+            while x < width and length < MAX_RUN and row[x] == color:
+                x += 1
+                length += 1
+            runs += [(skip << SKIP_SHIFT) | length, rgb565(*color)]
+            skip = 0
+    rowOffsets.append(len(runs))
+    return rowOffsets, runs
+
+
+def cArray(values):
+    lines = []
+    for i in range(0, len(values), 12):
+        lines.append("  " + ", ".join("0x%04x" % value for value in values[i:i + 12]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encode a PPM image as a const RLE sprite for sprite.h.")
+    parser.add_argument("image")
+    parser.add_argument("name", help="C name of the sprite_frame_t")
+    parser.add_argument("--transparent", default="00ff00", help="RRGGBB color that becomes transparent")
+    args = parser.parse_args()
+    width, height, pixels = readPpm(args.image)
+    transparent = tuple(bytes.fromhex(args.transparent))
+    rowOffsets, runs = encode(width, height, pixels, transparent)
+    if rowOffsets[-1] > 0xFFFF:
+        sys.exit("%s: too many runs for 16-bit row offsets" % args.image)
+    print("// Generated by spriteEncode.py from %s: %d x %d, %d words of runs." % (args.image, width, height, len(runs)))
+    print('#include "supportFiles/sprite.h"\n')
+    print("static const uint16_t %s_rowOffsets[] = {\n%s\n};" % (args.name, cArray(rowOffsets)))
+    print("static const uint16_t %s_runs[] = {\n%s\n};" % (args.name, cArray(runs) if runs else "  0,"))
+    print("static const sprite_frame_t %s = {%d, %d, %s_rowOffsets, %s_runs};"
+          % (args.name, width, height, args.name, args.name))
+
+
+if __name__ == "__main__":
+    main()
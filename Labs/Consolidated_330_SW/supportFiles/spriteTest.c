@@ -0,0 +1,179 @@
+/*
+ * spriteTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "spriteTest.h"
+#include "testSupport.h"
+#include "sprite.h"
+#include "display.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_RADIUS 25                  // Discs the size of a WAM mole.
+#define TEST_SIZE (2 * TEST_RADIUS + 1)
+#define TEST_FRAME_COUNT 4              // Background disc, two inner discs and an empty frame.
+#define TEST_RUN_CAPACITY 4096          // Words of runs for all test frames.
+#define TEST_WIDE_WIDTH 600             // Wider than SPRITE_MAX_RUN twice over.
+#define TEST_WIDE_GAP 300               // Transparent pixels before the wide run.
+#define TEST_X 40                       // Where the test frames are drawn.
+#define TEST_Y 60
+#define TEST_BACKGROUND DISPLAY_GREEN
+#define TEST_TICKS_PER_FRAME 2
+
+typedef struct {
+  int16_t holeRadius;                   // Black disc, 0 for none.
+  int16_t innerRadius;                  // Red disc inside it, 0 for none.
+  int16_t innerDy;                      // Offset of the red disc from the center.
+} spriteTest_shape_t;
+
+static const spriteTest_shape_t testShapes[TEST_FRAME_COUNT] = {
+  {TEST_RADIUS, 0, 0},                  // Empty hole.
+  {TEST_RADIUS, TEST_RADIUS - 5, 12},   // Mole half way up.
+  {TEST_RADIUS, TEST_RADIUS - 5, 0},    // Mole all the way up.
+  {0, 0, 0},                            // Nothing.
+};
+
+static sprite_frame_t testFrames[TEST_FRAME_COUNT];
+static uint16_t testRowOffsets[TEST_FRAME_COUNT][TEST_SIZE + 1];
+static uint16_t testRuns[TEST_RUN_CAPACITY];
+
+// Pixel of a test shape, relative to its top-left corner.
+static uint32_t spriteTest_shapePixel(int16_t x, int16_t y, void* context) {
+  const spriteTest_shape_t* shape = (const spriteTest_shape_t*) context;
+  int16_t dx = x - TEST_RADIUS;
+  int16_t dy = y - TEST_RADIUS;
+  int16_t innerDy = dy - shape->innerDy;
+  if (shape->innerRadius && dx * dx + innerDy * innerDy <= shape->innerRadius * shape->innerRadius &&
+      dx * dx + dy * dy <= shape->holeRadius * shape->holeRadius)
+    return DISPLAY_RED;
+  if (shape->holeRadius && dx * dx + dy * dy <= shape->holeRadius * shape->holeRadius)
+    return DISPLAY_BLACK;
+  return SPRITE_TRANSPARENT;
+}
+
+// A gap of TEST_WIDE_GAP, then white to the end of the row.
+static uint32_t spriteTest_widePixel(int16_t x, int16_t y, void* context) {
+  return x < TEST_WIDE_GAP ? SPRITE_TRANSPARENT : DISPLAY_WHITE;
+}
+
+#ifdef SPRITE_HOST
+// ******************************** host frame buffer ****************************
+static uint16_t frameBuffer[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+
+void display_drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; i++)
+    if (y >= 0 && y < DISPLAY_HEIGHT && x + i >= 0 && x + i < DISPLAY_WIDTH)
+      frameBuffer[y][x + i] = color;
+}
+
+static void spriteTest_clearScreen() {
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++)
+    display_drawFastHLine(0, y, DISPLAY_WIDTH, TEST_BACKGROUND);
+}
+
+// True if the screen shows shape at (TEST_X, TEST_Y) over the background.
+static bool spriteTest_screenShows(const spriteTest_shape_t* shape) {
+  for (int16_t y = 0; y < TEST_SIZE; y++) {
+    for (int16_t x = 0; x < TEST_SIZE; x++) {
+      uint32_t expected = spriteTest_shapePixel(x, y, (void*) shape);
+      if (expected == SPRITE_TRANSPARENT)
+        expected = TEST_BACKGROUND;
+      if (frameBuffer[TEST_Y + y][TEST_X + x] != expected)
+        return false;
+    }
+  }
+  return true;
+}
+#else
+static void spriteTest_clearScreen() {
+  display_fillScreen(TEST_BACKGROUND);
+}
+#endif
+
+static void spriteTest_runEncodeChecks() {
+  uint32_t used = 0;
+  for (uint16_t i = 0; i < TEST_FRAME_COUNT; i++) {
+    uint32_t words = sprite_encode(&testFrames[i], testRowOffsets[i], &testRuns[used], TEST_RUN_CAPACITY - used,
+                                   TEST_SIZE, TEST_SIZE, spriteTest_shapePixel, (void*) &testShapes[i]);
+    testSupport_check(words || !testShapes[i].holeRadius, "test frame did not fit");
+    used += words;
+  }
+  // Middle row of the half-way frame: black, red, black.
+  const sprite_frame_t* half = &testFrames[1];
+  testSupport_check(half->rowOffsets[TEST_RADIUS + 1] - half->rowOffsets[TEST_RADIUS] == 3 * SPRITE_RUN_WORDS,
+                    "runs in a row");
+  testSupport_check(testFrames[3].rowOffsets[TEST_SIZE] == 0, "empty frame has runs");
+
+  sprite_frame_t wide;
+  uint16_t wideOffsets[2];
+  uint16_t wideRuns[8 * SPRITE_RUN_WORDS];
+  uint32_t words = sprite_encode(&wide, wideOffsets, wideRuns, 8 * SPRITE_RUN_WORDS, TEST_WIDE_WIDTH, 1,
+                                 spriteTest_widePixel, NULL);
+  // The 300-pixel gap needs an empty run; the 300-pixel run is split in two.
+  testSupport_check(words == 3 * SPRITE_RUN_WORDS, "long gap and run not split");
+  testSupport_check(sprite_encode(&wide, wideOffsets, wideRuns, SPRITE_RUN_WORDS, TEST_WIDE_WIDTH, 1,
+                                  spriteTest_widePixel, NULL) == 0, "full buffer not rejected");
+}
+
+static void spriteTest_runDrawChecks() {
+  spriteTest_clearScreen();
+  sprite_resetPixelCount();
+  sprite_draw(&testFrames[0], TEST_X, TEST_Y);
+  uint32_t fullPixels = sprite_getPixelCount();
+#ifdef SPRITE_HOST
+  testSupport_check(spriteTest_screenShows(&testShapes[0]), "sprite_draw() result");
+#endif
+  // Step 0 -> 1 -> 2 -> 0 -> 3 with deltas: each costs less than an erase and redraw.
+  static const uint8_t steps[] = {1, 2, 0, 3};
+  uint8_t shown = 0;
+  for (uint16_t i = 0; i < sizeof(steps); i++) {
+    sprite_resetPixelCount();
+    sprite_drawDelta(&testFrames[shown], &testFrames[steps[i]], TEST_X, TEST_Y, TEST_BACKGROUND);
+    testSupport_check(sprite_getPixelCount() < 2 * fullPixels, "delta sent more than erase and redraw");
+    shown = steps[i];
+#ifdef SPRITE_HOST
+    testSupport_check(spriteTest_screenShows(&testShapes[shown]), "sprite_drawDelta() result");
+#endif
+  }
+  sprite_resetPixelCount();
+  sprite_drawDelta(&testFrames[3], &testFrames[3], TEST_X, TEST_Y, TEST_BACKGROUND);
+  testSupport_check(sprite_getPixelCount() == 0, "delta to the same frame drew something");
+}
+
+static void spriteTest_runPlayerChecks() {
+  static const sprite_frame_t* const popUpFrames[] = {&testFrames[1], &testFrames[2]};
+  static const sprite_animation_t popUp = {popUpFrames, 2, TEST_TICKS_PER_FRAME};
+  spriteTest_clearScreen();
+  sprite_draw(&testFrames[0], TEST_X, TEST_Y);
+  sprite_player_t player;
+  sprite_initPlayer(&player, TEST_X, TEST_Y, &testFrames[0], TEST_BACKGROUND);
+  testSupport_check(!sprite_isPlaying(&player) && !sprite_tick(&player), "idle player playing");
+  sprite_play(&player, &popUp);
+  testSupport_check(player.shown == &testFrames[1], "first frame not shown on play");
+  uint16_t ticks = 0;
+  while (sprite_tick(&player))
+    ticks++;
+  testSupport_check(ticks == 2 * TEST_TICKS_PER_FRAME - 1, "ticks spent playing");
+  testSupport_check(player.shown == &testFrames[2] && !sprite_isPlaying(&player), "last frame not left up");
+#ifdef SPRITE_HOST
+  testSupport_check(spriteTest_screenShows(&testShapes[2]), "player result");
+#endif
+}
+
+bool spriteTest_run() {
+  testSupport_begin("spriteTest");
+  spriteTest_runEncodeChecks();
+  spriteTest_runDrawChecks();
+  spriteTest_runPlayerChecks();
+  return testSupport_end();
+}
+
+#ifdef SPRITE_HOST
+// host entry point; the board build calls spriteTest_run()
+int main() {
+  return spriteTest_run() ? 0 : 1;
+}
+#endif
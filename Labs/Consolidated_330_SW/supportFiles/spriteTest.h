@@ -0,0 +1,19 @@
+/*
+ * spriteTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SPRITETEST_H_
+#define SPRITETEST_H_
+
+#include <stdbool.h>
+
+// Checks sprite encoding, that sprite_drawDelta() sends fewer pixels than erase and redraw, and the player;
+// on the host every draw is also compared pixel by pixel with the shapes. On the board it draws on the LCD.
+// Returns true if every check passed. Host build:
+//   g++ -x c++ -O2 -DSPRITE_HOST -DTESTSUPPORT_HOST sprite.c testSupport.c spriteTest.c -o spriteTest
+bool spriteTest_run();
+
+#endif /* SPRITETEST_H_ */
@@ -0,0 +1,162 @@
+/*
+ * spscRing.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "spscRing.h"
+#include <stdio.h>
+#include <string.h>
+
+// Each index is written by one side only. The other side reads it with acquire and the owner publishes
+// it with release, so the element copies cannot be reordered across the index update.
+#define spscRing_loadAcquire(index) __atomic_load_n((index), __ATOMIC_ACQUIRE)
+#define spscRing_storeRelease(index, value) __atomic_store_n((index), (value), __ATOMIC_RELEASE)
+
+// Copies count elements into the ring starting at free-running position, in at most two pieces.
+static void spscRing_copyIn(spscRing_t* ring, uint32_t position, const uint8_t* source, uint32_t count) {
+  uint32_t start = position & ring->mask;
+  uint32_t firstCount = ring->mask + 1 - start;  // Elements that fit before the end of storage.
+  if (firstCount > count)
+    firstCount = count;
+  memcpy(ring->storage + start * ring->elementSize, source, firstCount * ring->elementSize);
+  memcpy(ring->storage, source + firstCount * ring->elementSize, (count - firstCount) * ring->elementSize);
+}
+
+// Copies count elements out of the ring starting at free-running position, in at most two pieces.
+static void spscRing_copyOut(const spscRing_t* ring, uint32_t position, uint8_t* destination, uint32_t count) {
+  uint32_t start = position & ring->mask;
+  uint32_t firstCount = ring->mask + 1 - start;
+  if (firstCount > count)
+    firstCount = count;
+  memcpy(destination, ring->storage + start * ring->elementSize, firstCount * ring->elementSize);
+  memcpy(destination + firstCount * ring->elementSize, ring->storage, (count - firstCount) * ring->elementSize);
+}
+
+// Sets up an empty ring over caller-supplied storage.
+int spscRing_init(spscRing_t* ring, void* storage, uint32_t elementSize, uint32_t capacity) {
+  if (!storage) {
+    printf("spscRing_init: storage must not be NULL.\n\r");
+    return SPSCRING_STATUS_FAIL;
+  }
+  if (!elementSize) {
+    printf("spscRing_init: elementSize must not be 0.\n\r");
+    return SPSCRING_STATUS_FAIL;
+  }
+  if (!capacity || (capacity & (capacity - 1))) {
+    printf("spscRing_init: capacity %ld must be a power of two.\n\r", (long) capacity);
+    return SPSCRING_STATUS_FAIL;
+  }
+  ring->storage = (uint8_t*) storage;
+  ring->elementSize = elementSize;
+  ring->mask = capacity - 1;
+  spscRing_reset(ring);
+  return SPSCRING_STATUS_OK;
+}
+
+// Empties the ring.
+void spscRing_reset(spscRing_t* ring) {
+  spscRing_storeRelease(&ring->head, 0);
+  spscRing_storeRelease(&ring->tail, 0);
+}
+
+// Producer: copies up to count elements in.
+uint32_t spscRing_pushBulk(spscRing_t* ring, const void* elements, uint32_t count) {
+  uint32_t head = ring->head;                           // Only the producer writes head.
+  uint32_t tail = spscRing_loadAcquire(&ring->tail);    // Slots before tail have been copied out.
+  uint32_t space = ring->mask + 1 - (head - tail);
+  if (count > space)
+    count = space;
+  if (count) {
+    spscRing_copyIn(ring, head, (const uint8_t*) elements, count);
+    spscRing_storeRelease(&ring->head, head + count);   // Publish only after the copy.
+  }
+  return count;
+}
+
+// Producer: copies one element in.
+bool spscRing_push(spscRing_t* ring, const void* element) {
+  return spscRing_pushBulk(ring, element, 1) == 1;
+}
+
+// Consumer: copies up to maxCount elements out.
+uint32_t spscRing_popBulk(spscRing_t* ring, void* elements, uint32_t maxCount) {
+  uint32_t tail = ring->tail;                           // Only the consumer writes tail.
+  uint32_t head = spscRing_loadAcquire(&ring->head);    // Elements before head are fully written.
+  uint32_t count = head - tail;
+  if (count > maxCount)
+    count = maxCount;
+  if (count) {
+    spscRing_copyOut(ring, tail, (uint8_t*) elements, count);
+    spscRing_storeRelease(&ring->tail, tail + count);   // Hand the slots back only after the copy.
+  }
+  return count;
+}
+
+// Consumer: copies one element out.
+bool spscRing_pop(spscRing_t* ring, void* element) {
+  return spscRing_popBulk(ring, element, 1) == 1;
+}
+
+// Consumer: copies out an element without removing it.
+bool spscRing_peek(spscRing_t* ring, uint32_t index, void* element) {
+  uint32_t tail = ring->tail;
+  if (spscRing_loadAcquire(&ring->head) - tail <= index)
+    return false;
+  spscRing_copyOut(ring, tail + index, (uint8_t*) element, 1);
+  return true;
+}
+
+// Consumer: removes elements without copying them.
+uint32_t spscRing_discard(spscRing_t* ring, uint32_t count) {
+  uint32_t tail = ring->tail;
+  uint32_t available = spscRing_loadAcquire(&ring->head) - tail;
+  if (count > available)
+    count = available;
+  spscRing_storeRelease(&ring->tail, tail + count);
+  return count;
+}
+
+// Producer: the free slots after the newest element, up to the end of storage.
+uint32_t spscRing_writeSpan(spscRing_t* ring, void** span) {
+  uint32_t head = ring->head;
+  uint32_t space = ring->mask + 1 - (head - spscRing_loadAcquire(&ring->tail));
+  uint32_t start = head & ring->mask;
+  *span = ring->storage + start * ring->elementSize;
+  return space < ring->mask + 1 - start ? space : ring->mask + 1 - start;
+}
+
+// Producer: publishes elements written into the span.
+void spscRing_commit(spscRing_t* ring, uint32_t count) {
+  spscRing_storeRelease(&ring->head, ring->head + count);
+}
+
+// Consumer: the oldest elements, up to the end of storage.
+uint32_t spscRing_readSpan(spscRing_t* ring, void** span) {
+  uint32_t tail = ring->tail;
+  uint32_t count = spscRing_loadAcquire(&ring->head) - tail;
+  uint32_t start = tail & ring->mask;
+  *span = ring->storage + start * ring->elementSize;
+  return count < ring->mask + 1 - start ? count : ring->mask + 1 - start;
+}
+
+uint32_t spscRing_count(spscRing_t* ring) {
+  return spscRing_loadAcquire(&ring->head) - spscRing_loadAcquire(&ring->tail);
+}
+
+uint32_t spscRing_space(spscRing_t* ring) {
+  return ring->mask + 1 - spscRing_count(ring);
+}
+
+uint32_t spscRing_capacity(const spscRing_t* ring) {
+  return ring->mask + 1;
+}
+
+bool spscRing_isEmpty(spscRing_t* ring) {
+  return spscRing_count(ring) == 0;
+}
+
+bool spscRing_isFull(spscRing_t* ring) {
+  return spscRing_count(ring) == ring->mask + 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * spscRing.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Single-producer/single-consumer ring of fixed-size elements, for passing data from an ISR to main
+// (or from main to an ISR, or between the two cores) without disabling interrupts.
+// - Capacity must be a power of two so indexing is a mask, not a modulo.
+// - head is written only by the producer and tail only by the consumer. Both run freely and wrap at 2^32;
+//   head - tail is the element count, so the ring holds a full capacity elements.
+// - The producer publishes head with a release store after copying the elements in, and the consumer
+//   reads it with an acquire load before copying them out (DMB on the Cortex-A9); tail works the same
+//   way in the other direction. Each side only ever sees complete elements.
+// - The ring never overwrites: a push into a full ring pushes nothing and returns false / a short count.
+// The caller provides the storage, so rings can live in static arrays (or in OCM for CPU1).
+
+#define SPSCRING_STATUS_OK 1    // Returned by spscRing_init() on success.
+#define SPSCRING_STATUS_FAIL 0  // Returned by spscRing_init() for a bad capacity or element size.
+
+typedef struct {
+  uint8_t* storage;       // capacity * elementSize bytes supplied by the caller.
+  uint32_t elementSize;   // Bytes per element.
+  uint32_t mask;          // capacity - 1.
+  uint32_t head;          // Producer: count of elements ever pushed.
+  uint32_t tail;          // Consumer: count of elements ever popped.
+} spscRing_t;
+
+// Sets up an empty ring over storage, which must hold capacity elements of elementSize bytes.
+// capacity must be a power of two. Returns SPSCRING_STATUS_OK or SPSCRING_STATUS_FAIL.
+int spscRing_init(spscRing_t* ring, void* storage, uint32_t elementSize, uint32_t capacity);
+
+// Empties the ring. Only safe while neither side is using it.
+void spscRing_reset(spscRing_t* ring);
+
+// Producer: copies one element in. Returns false if the ring is full.
+bool spscRing_push(spscRing_t* ring, const void* element);
+
+// Producer: copies up to count elements in. Returns the number copied (less than count if the ring fills).
+uint32_t spscRing_pushBulk(spscRing_t* ring, const void* elements, uint32_t count);
+
+// Consumer: copies one element out. Returns false if the ring is empty.
+bool spscRing_pop(spscRing_t* ring, void* element);
+
+// Consumer: copies up to maxCount elements out. Returns the number copied.
+uint32_t spscRing_popBulk(spscRing_t* ring, void* elements, uint32_t maxCount);
+
+// Consumer: copies out the element index places from the oldest without removing it.
+// Returns false if there are not that many elements.
+bool spscRing_peek(spscRing_t* ring, uint32_t index, void* element);
+
+// Consumer: removes up to count of the oldest elements without copying them. Returns the number removed.
+uint32_t spscRing_discard(spscRing_t* ring, uint32_t count);
+
+// Zero-copy access. A span is the elements that are contiguous in storage, so it stops at the end of
+// storage even when the ring wraps; call again after finishing one to get the rest.
+// Producer: points *span at the free slots after the newest element and returns how many there are
+// (0 if the ring is full). Write elements there, then publish them with spscRing_commit().
+uint32_t spscRing_writeSpan(spscRing_t* ring, void** span);
+
+// Producer: publishes the first count elements of the span from spscRing_writeSpan().
+void spscRing_commit(spscRing_t* ring, uint32_t count);
+
+// Consumer: points *span at the oldest elements and returns how many there are (0 if the ring is empty).
+// They stay in the ring until spscRing_discard() removes them.
+uint32_t spscRing_readSpan(spscRing_t* ring, void** span);
+
+// Number of elements in the ring. Exact for the consumer; a lower bound of free space for the producer.
+uint32_t spscRing_count(spscRing_t* ring);
+
+// Number of free slots. Exact for the producer; a lower bound of the element count for the consumer.
+uint32_t spscRing_space(spscRing_t* ring);
+
+// Number of elements the ring can hold.
+uint32_t spscRing_capacity(const spscRing_t* ring);
+
+// True if there is nothing to pop.
+bool spscRing_isEmpty(spscRing_t* ring);
+
+// True if there is no room to push.
+bool spscRing_isFull(spscRing_t* ring);
+
+#endif /* SPSCRING_H_ */
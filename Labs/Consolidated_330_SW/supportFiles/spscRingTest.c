@@ -0,0 +1,200 @@
+/*
+ * spscRingTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "spscRingTest.h"
+#include "testSupport.h"
+#include "spscRing.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef SPSCRING_HOST
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#define TEST_CAPACITY 8                 // Small so the checks wrap the storage often.
+#define TEST_BAD_CAPACITY 6             // Not a power of two.
+#define TEST_BULK_SIZE 5                // Does not divide TEST_CAPACITY, so bulk copies split at the end of storage.
+#define TEST_WRAP_START 0xFFFFFFFCu     // Index value a few elements short of 32-bit wrap-around.
+#define BENCH_CAPACITY 1024             // Ring size for the throughput runs.
+#define BENCH_BULK_SIZE 64              // Elements per bulk call in the throughput runs.
+#define BENCH_ELEMENT_COUNT 1000000     // Elements pushed and popped per throughput run.
+#define STRESS_CAPACITY 16              // Small so the threads constantly hit full and empty.
+#define STRESS_ELEMENT_COUNT 2000000    // Elements streamed between the threads.
+#define STRESS_MAX_BULK 7               // Bulk sizes cycle 1..7 on both sides.
+
+static uint32_t testStorage[TEST_CAPACITY];
+static uint32_t benchStorage[BENCH_CAPACITY];
+
+// ******************************** checks ***************************************
+// Pushes and pops through a small ring and checks every result.
+static void runChecks() {
+  spscRing_t ring;
+  testSupport_check(spscRing_init(&ring, testStorage, sizeof(uint32_t), TEST_BAD_CAPACITY) == SPSCRING_STATUS_FAIL,
+                    "init accepted a capacity that is not a power of two");
+  testSupport_check(spscRing_init(&ring, NULL, sizeof(uint32_t), TEST_CAPACITY) == SPSCRING_STATUS_FAIL,
+                    "init accepted NULL storage");
+  testSupport_check(spscRing_init(&ring, testStorage, 0, TEST_CAPACITY) == SPSCRING_STATUS_FAIL,
+                    "init accepted an element size of 0");
+  testSupport_check(spscRing_init(&ring, testStorage, sizeof(uint32_t), TEST_CAPACITY) == SPSCRING_STATUS_OK,
+                    "init failed");
+  uint32_t value = 0;
+  testSupport_check(spscRing_isEmpty(&ring) && !spscRing_pop(&ring, &value), "new ring is not empty");
+  // Fill to capacity, then one more.
+  for (uint32_t i = 0; i < TEST_CAPACITY; i++)
+    testSupport_check(spscRing_push(&ring, &i), "push into a ring with room failed");
+  testSupport_check(spscRing_isFull(&ring) && spscRing_count(&ring) == TEST_CAPACITY, "ring is not full at capacity");
+  testSupport_check(!spscRing_push(&ring, &value), "push into a full ring succeeded");
+  // Peek, discard, and pop in order.
+  testSupport_check(spscRing_peek(&ring, 3, &value) && value == 3, "peek returned the wrong element");
+  testSupport_check(!spscRing_peek(&ring, TEST_CAPACITY, &value), "peek past the end succeeded");
+  testSupport_check(spscRing_discard(&ring, 2) == 2, "discard removed the wrong count");
+  for (uint32_t i = 2; i < TEST_CAPACITY; i++)
+    testSupport_check(spscRing_pop(&ring, &value) && value == i, "pop returned the wrong element");
+  testSupport_check(spscRing_isEmpty(&ring), "ring is not empty after popping everything");
+  // Bulk transfers that split at the end of storage, starting just short of index wrap-around.
+  ring.head = ring.tail = TEST_WRAP_START;
+  uint32_t in[TEST_BULK_SIZE], out[TEST_BULK_SIZE];
+  uint32_t next = 0, expected = 0;
+  for (uint32_t round = 0; round < TEST_CAPACITY * 2; round++) {
+    for (uint32_t i = 0; i < TEST_BULK_SIZE; i++)
+      in[i] = next + i;
+    uint32_t pushed = spscRing_pushBulk(&ring, in, TEST_BULK_SIZE);
+    testSupport_check(pushed == TEST_BULK_SIZE, "bulk push into a ring with room was short");
+    next += pushed;
+    uint32_t popped = spscRing_popBulk(&ring, out, TEST_BULK_SIZE);
+    testSupport_check(popped == pushed, "bulk pop was short");
+    for (uint32_t i = 0; i < popped; i++, expected++)
+      testSupport_check(out[i] == expected, "bulk pop returned the wrong element");
+  }
+  testSupport_check(ring.head < TEST_WRAP_START, "test did not wrap the 32-bit indices");
+  // A bulk push into a nearly full ring is cut short.
+  for (uint32_t i = 0; i < TEST_CAPACITY - 2; i++)
+    spscRing_push(&ring, &i);
+  testSupport_check(spscRing_pushBulk(&ring, in, TEST_BULK_SIZE) == 2, "bulk push did not stop at capacity");
+  testSupport_check(spscRing_popBulk(&ring, out, TEST_BULK_SIZE) == TEST_BULK_SIZE,
+                    "bulk pop did not take what was asked");
+  testSupport_check(spscRing_count(&ring) == TEST_CAPACITY - TEST_BULK_SIZE, "count is wrong after bulk transfers");
+  // Spans stop at the end of storage and pick up at its start.
+  spscRing_reset(&ring);
+  ring.head = ring.tail = TEST_CAPACITY - 2;
+  void* span;
+  testSupport_check(spscRing_writeSpan(&ring, &span) == 2 && span == &testStorage[TEST_CAPACITY - 2],
+                    "write span does not stop at the end of storage");
+  ((uint32_t*) span)[0] = 10;
+  ((uint32_t*) span)[1] = 11;
+  spscRing_commit(&ring, 2);
+  testSupport_check(spscRing_writeSpan(&ring, &span) == TEST_CAPACITY - 2 && span == &testStorage[0],
+                    "write span does not wrap to the start of storage");
+  ((uint32_t*) span)[0] = 12;
+  spscRing_commit(&ring, 1);
+  testSupport_check(spscRing_readSpan(&ring, &span) == 2 && ((uint32_t*) span)[0] == 10 && ((uint32_t*) span)[1] == 11,
+                    "read span returned the wrong elements");
+  spscRing_discard(&ring, 2);
+  testSupport_check(spscRing_readSpan(&ring, &span) == 1 && ((uint32_t*) span)[0] == 12, "read span does not wrap");
+  spscRing_discard(&ring, 1);
+  testSupport_check(spscRing_readSpan(&ring, &span) == 0, "read span of an empty ring is not empty");
+  for (uint32_t i = 0; i < TEST_CAPACITY; i++)
+    spscRing_push(&ring, &i);
+  testSupport_check(spscRing_writeSpan(&ring, &span) == 0, "write span of a full ring is not empty");
+}
+
+// ******************************** benchmark ************************************
+// Times single and bulk transfers through a ring that never fills.
+static void runBenchmark() {
+  spscRing_t ring;
+  spscRing_init(&ring, benchStorage, sizeof(uint32_t), BENCH_CAPACITY);
+  uint32_t value = 0, checksum = 0;
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_ELEMENT_COUNT; i++) {
+    spscRing_push(&ring, &i);
+    spscRing_pop(&ring, &value);
+    checksum += value;
+  }
+  double singleSeconds = testSupport_stopTimer();
+  uint32_t block[BENCH_BULK_SIZE];
+  for (uint32_t i = 0; i < BENCH_BULK_SIZE; i++)
+    block[i] = i;
+  testSupport_startTimer();
+  for (uint32_t i = 0; i < BENCH_ELEMENT_COUNT; i += BENCH_BULK_SIZE) {
+    spscRing_pushBulk(&ring, block, BENCH_BULK_SIZE);
+    checksum += spscRing_popBulk(&ring, block, BENCH_BULK_SIZE);
+  }
+  double bulkSeconds = testSupport_stopTimer();
+  testSupport_check(checksum != 0, "benchmark moved no data");  // Also keeps the loops from being optimized away.
+  printf("spscRingTest: single push+pop %.1f M elements/s, bulk (%d) push+pop %.1f M elements/s\n\r",
+         BENCH_ELEMENT_COUNT / singleSeconds / 1.0E6, BENCH_BULK_SIZE, BENCH_ELEMENT_COUNT / bulkSeconds / 1.0E6);
+}
+
+// ******************************** threaded stress ******************************
+#ifdef SPSCRING_HOST
+static spscRing_t stressRing;
+static uint32_t stressStorage[STRESS_CAPACITY];
+
+// Pushes 0, 1, 2, ... in bulks of varying size.
+static void* stressProducer(void* arg) {
+  (void) arg;
+  uint32_t block[STRESS_MAX_BULK];
+  uint32_t next = 0, bulk = 1;
+  while (next < STRESS_ELEMENT_COUNT) {
+    uint32_t count = bulk;
+    if (count > STRESS_ELEMENT_COUNT - next)
+      count = STRESS_ELEMENT_COUNT - next;
+    for (uint32_t i = 0; i < count; i++)
+      block[i] = next + i;
+    uint32_t pushed = spscRing_pushBulk(&stressRing, block, count);
+    if (!pushed)
+      sched_yield();  // Full: let the consumer run even on a single host core.
+    next += pushed;
+    bulk = bulk % STRESS_MAX_BULK + 1;
+  }
+  return NULL;
+}
+
+// Streams a numbered sequence between two threads and checks that it arrives intact.
+static void runStressTest() {
+  spscRing_init(&stressRing, stressStorage, sizeof(uint32_t), STRESS_CAPACITY);
+  pthread_t producer;
+  testSupport_startTimer();
+  pthread_create(&producer, NULL, stressProducer, NULL);
+  uint32_t block[STRESS_MAX_BULK];
+  uint32_t expected = 0, bulk = STRESS_MAX_BULK, errors = 0;
+  while (expected < STRESS_ELEMENT_COUNT) {
+    uint32_t popped = spscRing_popBulk(&stressRing, block, bulk);
+    if (!popped)
+      sched_yield();  // Empty: let the producer run even on a single host core.
+    for (uint32_t i = 0; i < popped; i++, expected++)
+      if (block[i] != expected)
+        errors++;
+    bulk = bulk % STRESS_MAX_BULK + 1;
+  }
+  pthread_join(producer, NULL);
+  double seconds = testSupport_stopTimer();
+  testSupport_check(errors == 0, "threaded stream lost, duplicated or reordered elements");
+  testSupport_check(spscRing_isEmpty(&stressRing), "ring is not empty after the threaded stream");
+  printf("spscRingTest: threaded stream of %d elements through a %d-slot ring, %ld errors, %.1f M elements/s\n\r",
+         STRESS_ELEMENT_COUNT, STRESS_CAPACITY, (long) errors, STRESS_ELEMENT_COUNT / seconds / 1.0E6);
+}
+#endif
+
+// Runs the checks and the benchmark.
+bool spscRingTest_run() {
+  testSupport_begin("spscRingTest");
+  runChecks();
+  runBenchmark();
+#ifdef SPSCRING_HOST
+  runStressTest();
+#endif
+  return testSupport_end();
+}
+
+#ifdef SPSCRING_HOST
+// host entry point; the board build calls spscRingTest_run()
+int main() {
+  return spscRingTest_run() ? 0 : 1;
+}
+#endif
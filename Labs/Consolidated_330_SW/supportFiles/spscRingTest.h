@@ -0,0 +1,20 @@
+/*
+ * spscRingTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef SPSCRINGTEST_H_
+#define SPSCRINGTEST_H_
+
+#include <stdbool.h>
+
+// Checks spscRing: empty and full, wrap-around of the storage and of the 32-bit indices, bulk copies and
+// zero-copy spans across the end of storage, peek, discard and bad init arguments. Then prints push/pop throughput
+// and, on the host, streams a numbered sequence between two threads. Returns true if every check passed.
+// Host build:
+//   gcc -O2 -pthread -DSPSCRING_HOST -DTESTSUPPORT_HOST spscRing.c testSupport.c spscRingTest.c -o spscRingTest
+bool spscRingTest_run();
+
+#endif /* SPSCRINGTEST_H_ */
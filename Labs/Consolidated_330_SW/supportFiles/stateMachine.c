@@ -0,0 +1,235 @@
+/*
+ * stateMachine.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "stateMachine.h"
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef STATEMACHINE_ENABLE_TRACE
+#ifdef STATEMACHINE_HOST
+#include <time.h>
+#else
+#include "timebase.h"
+#endif
+#endif
+
+#if (STATEMACHINE_TRACE_SIZE & (STATEMACHINE_TRACE_SIZE - 1)) != 0
+#error "STATEMACHINE_TRACE_SIZE must be a power of two."
+#endif
+
+// ******************************** trace ****************************************
+
+#ifdef STATEMACHINE_ENABLE_TRACE
+#define STATEMACHINE_US_PER_SECOND 1000000UL
+#define STATEMACHINE_NS_PER_US 1000UL
+
+static stateMachine_traceEntry_t trace[STATEMACHINE_TRACE_SIZE];
+static uint32_t traceCount;             // Transitions recorded since the last clear; the ring keeps the last ones.
+
+// Microseconds from the global timer, truncated to 32 bits.
+static uint32_t stateMachine_nowUs() {
+#ifdef STATEMACHINE_HOST
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t) (now.tv_sec * STATEMACHINE_US_PER_SECOND + now.tv_nsec / STATEMACHINE_NS_PER_US);
+#else
+  return (uint32_t) timebase_nowUs();
+#endif
+}
+
+static void stateMachine_record(stateMachine_t* machine, stateMachine_stateId_t from) {
+  stateMachine_traceEntry_t* entry = &trace[traceCount++ & (STATEMACHINE_TRACE_SIZE - 1)];
+  entry->timeUs = stateMachine_nowUs();
+  entry->definition = machine->definition;
+  entry->from = from;
+  entry->to = machine->current;
+}
+#define STATEMACHINE_RECORD(machine, from) stateMachine_record(machine, from)
+#else
+#define STATEMACHINE_RECORD(machine, from) (void) (from)
+#endif
+
+uint32_t stateMachine_getTraceCount() {
+#ifdef STATEMACHINE_ENABLE_TRACE
+  return traceCount < STATEMACHINE_TRACE_SIZE ? traceCount : STATEMACHINE_TRACE_SIZE;
+#else
+  return 0;
+#endif
+}
+
+bool stateMachine_getTraceEntry(uint32_t index, stateMachine_traceEntry_t* entry) {
+  if (index >= stateMachine_getTraceCount())
+    return false;
+#ifdef STATEMACHINE_ENABLE_TRACE
+  *entry = trace[(traceCount - stateMachine_getTraceCount() + index) & (STATEMACHINE_TRACE_SIZE - 1)];
+#endif
+  return true;
+}
+
+void stateMachine_clearTrace() {
+#ifdef STATEMACHINE_ENABLE_TRACE
+  traceCount = 0;
+#endif
+}
+
+void stateMachine_printTrace() {
+#ifndef STATEMACHINE_ENABLE_TRACE
+  printf("stateMachine: built without STATEMACHINE_ENABLE_TRACE.\n\r");
+#endif
+  stateMachine_traceEntry_t entry;
+  for (uint32_t i = 0; stateMachine_getTraceEntry(i, &entry); i++) {
+    const stateMachine_state_t* states = entry.definition->states;
+    printf("%10lu us  %s: %s -> %s\n\r", (unsigned long) entry.timeUs, entry.definition->name,
+           states[entry.from].name, states[entry.to].name);
+  }
+}
+
+// ******************************** machine **************************************
+
+// Parent of a state.
+static stateMachine_stateId_t stateMachine_parent(stateMachine_t* machine, stateMachine_stateId_t state) {
+  return machine->definition->states[state].parent;
+}
+
+// Nesting depth of a state, 0 at the top level.
+static uint8_t stateMachine_depth(stateMachine_t* machine, stateMachine_stateId_t state) {
+  uint8_t depth = 0;
+  while ((state = stateMachine_parent(machine, state)) != STATEMACHINE_NONE)
+    depth++;
+  return depth;
+}
+
+// Makes state (whose parent is active) the innermost active state and runs its entry action.
+static void stateMachine_enterOne(stateMachine_t* machine, stateMachine_stateId_t state) {
+  machine->current = state;
+  machine->enteredTick[stateMachine_depth(machine, state)] = machine->tickCount;
+  if (machine->definition->states[state].entry)
+    machine->definition->states[state].entry(machine);
+}
+
+// Enters the states from just below domain (active, or STATEMACHINE_NONE) down to target, then the
+// initial children below target.
+static void stateMachine_enter(stateMachine_t* machine, stateMachine_stateId_t domain, stateMachine_stateId_t target) {
+  stateMachine_stateId_t path[STATEMACHINE_MAX_DEPTH];
+  uint8_t length = 0;
+  for (stateMachine_stateId_t state = target; state != domain; state = stateMachine_parent(machine, state))
+    path[length++] = state;
+  while (length)
+    stateMachine_enterOne(machine, path[--length]);
+  stateMachine_stateId_t child;
+  while ((child = machine->definition->states[machine->current].initialChild) != STATEMACHINE_NONE)
+    stateMachine_enterOne(machine, child);
+}
+
+// Enters the initial state if the machine has not been started.
+static void stateMachine_start(stateMachine_t* machine) {
+  if (machine->started)
+    return;
+  machine->started = true;
+  machine->tickCount = 0;
+  stateMachine_enter(machine, STATEMACHINE_NONE, machine->definition->initial);
+}
+
+void stateMachine_reset(stateMachine_t* machine) {
+  machine->enabled = false;
+  machine->started = false;
+  stateMachine_start(machine);
+}
+
+bool stateMachine_isInState(stateMachine_t* machine, stateMachine_stateId_t state) {
+  stateMachine_start(machine);
+  for (stateMachine_stateId_t active = machine->current; active != STATEMACHINE_NONE;
+       active = stateMachine_parent(machine, active)) {
+    if (active == state)
+      return true;
+  }
+  return false;
+}
+
+// Takes a transition: exits up to the innermost active state that contains its target (the target
+// itself is exited when it is active), runs its action, then enters down to the target.
+static void stateMachine_take(stateMachine_t* machine, const stateMachine_transition_t* transition) {
+  stateMachine_stateId_t from = machine->current;
+  stateMachine_stateId_t domain = stateMachine_parent(machine, transition->to);
+  while (domain != STATEMACHINE_NONE && !stateMachine_isInState(machine, domain))
+    domain = stateMachine_parent(machine, domain);
+  while (machine->current != domain) {
+    const stateMachine_state_t* state = &machine->definition->states[machine->current];
+    if (state->exit)
+      state->exit(machine);
+    machine->current = state->parent;
+  }
+  if (transition->action)
+    transition->action(machine);
+  stateMachine_enter(machine, domain, transition->to);
+  STATEMACHINE_RECORD(machine, from);
+}
+
+void stateMachine_tick(stateMachine_t* machine) {
+  stateMachine_start(machine);
+  const stateMachine_definition_t* definition = machine->definition;
+  machine->tickCount++;
+  // Active states, innermost first.
+  stateMachine_stateId_t active[STATEMACHINE_MAX_DEPTH];
+  uint8_t depth = 0;
+  for (stateMachine_stateId_t state = machine->current; state != STATEMACHINE_NONE;
+       state = stateMachine_parent(machine, state))
+    active[depth++] = state;
+  for (uint8_t level = depth; level--;) {
+    if (definition->states[active[level]].during)
+      definition->states[active[level]].during(machine);
+  }
+  for (uint8_t level = depth; level--;) {
+    uint32_t elapsedMs = (machine->tickCount - machine->enteredTick[depth - 1 - level]) * machine->msPerTick;
+    for (uint8_t i = 0; i < definition->transitionCount; i++) {
+      const stateMachine_transition_t* transition = &definition->transitions[i];
+      if (transition->from == active[level] && elapsedMs >= transition->afterMs &&
+          (!transition->guard || transition->guard(machine))) {
+        stateMachine_take(machine, transition);
+        return;
+      }
+    }
+  }
+}
+
+void stateMachine_setMsPerTick(stateMachine_t* machine, uint16_t msPerTick) {
+  if (machine->started && msPerTick) {  // Move each entry back by the time spent, counted in new ticks.
+    uint8_t depth = stateMachine_depth(machine, machine->current);
+    for (uint8_t level = 0; level <= depth; level++) {
+      uint32_t elapsedMs = (machine->tickCount - machine->enteredTick[level]) * machine->msPerTick;
+      machine->enteredTick[level] = machine->tickCount - elapsedMs / msPerTick;
+    }
+  }
+  machine->msPerTick = msPerTick;
+}
+
+void stateMachine_enable(stateMachine_t* machine) {
+  machine->enabled = true;
+}
+
+void stateMachine_disable(stateMachine_t* machine) {
+  machine->enabled = false;
+}
+
+bool stateMachine_isEnabled(stateMachine_t* machine) {
+  return machine->enabled;
+}
+
+bool stateMachine_isDisabled(stateMachine_t* machine) {
+  return !machine->enabled;
+}
+
+stateMachine_stateId_t stateMachine_getState(stateMachine_t* machine) {
+  stateMachine_start(machine);
+  return machine->current;
+}
+
+uint32_t stateMachine_getMsInState(stateMachine_t* machine) {
+  stateMachine_start(machine);
+  uint8_t depth = stateMachine_depth(machine, machine->current);
+  return (machine->tickCount - machine->enteredTick[depth]) * machine->msPerTick;
+}
@@ -0,0 +1,132 @@
+/*
+ * stateMachine.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef STATEMACHINE_H_
+#define STATEMACHINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Table-driven hierarchical state machines, ticked like the hand-written *_tick() functions.
+// - A machine is two const tables: its states (name, parent, entry/during/exit actions) and its
+//   transitions (from, after how long, guard, action, to). Only the instance (a few bytes) is in RAM.
+// - A state with a parent is nested in it. A transition from the parent applies in all of its children,
+//   e.g., "disabled -> init" is written once for every state that has to obey it. A composite state
+//   enters its initialChild with it. Transitions exit the states they leave (innermost first), run their
+//   action, then enter the states they go to (outermost first).
+// - A tick runs the during actions of the active states, outermost first, then takes at most one
+//   transition: the first row in the table that is due and whose guard holds (a NULL guard always holds),
+//   looking at the outermost active state first. A parent's transition, e.g., on disable, so overrides
+//   whatever its children would do on that tick.
+// - Timed transitions: a row with afterMs is only due once its from state has been active that long,
+//   counted in ticks of the machine's msPerTick. This replaces the *Counter++ in state actions and the
+//   resets in transitions; a state's time restarts every time it is entered.
+// - Enable/disable interlock: stateMachine_enable()/disable() set a flag that stateMachine_isEnabled()
+//   and stateMachine_isDisabled() test, so they can be used as guards.
+// - Build with STATEMACHINE_ENABLE_TRACE defined to keep the last STATEMACHINE_TRACE_SIZE transitions of
+//   every machine in one ring, with timestamps, to print after the fact. Without it the trace costs nothing.
+//
+// Host build (for the test): define STATEMACHINE_HOST, see stateMachineTest.h.
+
+#define STATEMACHINE_NONE 0xFF                  // No state: the parent of a top-level state, or no initial child.
+#define STATEMACHINE_MAX_DEPTH 4                // Deepest nesting of states.
+#define STATEMACHINE_TRACE_SIZE 64              // Transitions kept by the trace; a power of two.
+
+typedef uint8_t stateMachine_stateId_t;
+
+typedef struct stateMachine stateMachine_t;
+typedef void (*stateMachine_action_t)(stateMachine_t* machine);
+typedef bool (*stateMachine_guard_t)(stateMachine_t* machine);
+
+typedef struct {
+  const char* name;                     // Used by the trace.
+  stateMachine_stateId_t parent;        // STATEMACHINE_NONE for a top-level state.
+  stateMachine_stateId_t initialChild;  // Entered with this state; STATEMACHINE_NONE for a leaf.
+  stateMachine_action_t entry;          // Each may be NULL.
+  stateMachine_action_t during;
+  stateMachine_action_t exit;
+} stateMachine_state_t;
+
+typedef struct {
+  stateMachine_stateId_t from;
+  uint32_t afterMs;                     // Due once from has been active this long; 0 for every tick.
+  stateMachine_guard_t guard;           // NULL always holds.
+  stateMachine_action_t action;         // Run between the exits and the entries; may be NULL.
+  stateMachine_stateId_t to;            // from itself to exit and enter it again.
+} stateMachine_transition_t;
+
+typedef struct {
+  const char* name;                     // Used by the trace.
+  const stateMachine_state_t* states;   // Indexed by stateMachine_stateId_t.
+  uint8_t stateCount;
+  const stateMachine_transition_t* transitions;  // In order of priority within each state.
+  uint8_t transitionCount;
+  stateMachine_stateId_t initial;
+} stateMachine_definition_t;
+
+// One running machine. Only this module touches the fields.
+struct stateMachine {
+  const stateMachine_definition_t* definition;
+  uint16_t msPerTick;                   // Period of the tick, for afterMs.
+  bool started;                         // False until the initial state has been entered.
+  bool enabled;
+  stateMachine_stateId_t current;       // Innermost active state.
+  uint32_t tickCount;
+  uint32_t enteredTick[STATEMACHINE_MAX_DEPTH];  // When the active state at each depth was entered.
+};
+
+// Static initializer for a machine ticked every msPerTick. It enters its initial state on the first
+// tick (or query), disabled.
+#define STATEMACHINE_INIT(definitionPointer, msPerTick) {definitionPointer, msPerTick}
+
+// What the trace keeps of one transition.
+typedef struct {
+  uint32_t timeUs;                      // Global timer in microseconds; wraps every 71 minutes.
+  const stateMachine_definition_t* definition;
+  stateMachine_stateId_t from;          // Innermost states before and after.
+  stateMachine_stateId_t to;
+} stateMachine_traceEntry_t;
+
+// Enters the initial state again from wherever the machine is, without running exit actions, and
+// lowers the enable flag.
+void stateMachine_reset(stateMachine_t* machine);
+
+// Runs one tick: during actions, then at most one transition.
+void stateMachine_tick(stateMachine_t* machine);
+
+// Changes the period the machine is ticked at. Time already spent in the active states is kept, rounded
+// down to whole ticks of the new period.
+void stateMachine_setMsPerTick(stateMachine_t* machine, uint16_t msPerTick);
+
+// The enable/disable interlock.
+void stateMachine_enable(stateMachine_t* machine);
+void stateMachine_disable(stateMachine_t* machine);
+bool stateMachine_isEnabled(stateMachine_t* machine);
+bool stateMachine_isDisabled(stateMachine_t* machine);
+
+// Innermost active state.
+stateMachine_stateId_t stateMachine_getState(stateMachine_t* machine);
+
+// True if state is active: the innermost state or one of its parents.
+bool stateMachine_isInState(stateMachine_t* machine, stateMachine_stateId_t state);
+
+// Time the innermost state has been active, in ms of ticks.
+uint32_t stateMachine_getMsInState(stateMachine_t* machine);
+
+// Transitions in the trace, at most STATEMACHINE_TRACE_SIZE; always 0 without STATEMACHINE_ENABLE_TRACE.
+uint32_t stateMachine_getTraceCount();
+
+// Copies a transition out of the trace, 0 being the oldest kept. Returns false if there is no such entry.
+bool stateMachine_getTraceEntry(uint32_t index, stateMachine_traceEntry_t* entry);
+
+// Empties the trace.
+void stateMachine_clearTrace();
+
+// Prints the trace, oldest first.
+void stateMachine_printTrace();
+
+#endif /* STATEMACHINE_H_ */
@@ -0,0 +1,192 @@
+/*
+ * stateMachineTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "stateMachineTest.h"
+#include "testSupport.h"
+#include "stateMachine.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MS_PER_TICK 50
+#define TEST_FIRST_MS 100               // FIRST moves on to SECOND after 2 ticks...
+#define TEST_ACTIVE_MS 500              // ...and ACTIVE times out after 10.
+#define TEST_TICK_LIMIT 100             // Gives up waiting for a state after this many ticks.
+#define TEST_LOG_SIZE 64
+
+// IDLE waits to be enabled. ACTIVE holds FIRST then SECOND, and leaves when disabled or timed out.
+enum {TEST_IDLE, TEST_ACTIVE, TEST_FIRST, TEST_SECOND, TEST_STATE_COUNT};
+
+static char actionLog[TEST_LOG_SIZE];   // One letter per action run, in order.
+static bool againFlag;                  // Guard of ACTIVE's self transition.
+
+static void stateMachineTest_log(char letter) {
+  size_t length = strlen(actionLog);
+  if (length + 1 < TEST_LOG_SIZE) {
+    actionLog[length] = letter;
+    actionLog[length + 1] = '\0';
+  }
+}
+
+// True if the log is expected, then empties it.
+static bool stateMachineTest_logIs(const char* expected) {
+  bool same = strcmp(actionLog, expected) == 0;
+  actionLog[0] = '\0';
+  return same;
+}
+
+// Upper case for entry, lower case for exit, d/e for during, t for a transition action.
+static void enterIdle(stateMachine_t* machine) { stateMachineTest_log('I'); }
+static void enterActive(stateMachine_t* machine) { stateMachineTest_log('A'); }
+static void duringActive(stateMachine_t* machine) { stateMachineTest_log('d'); }
+static void exitActive(stateMachine_t* machine) { stateMachineTest_log('a'); }
+static void enterFirst(stateMachine_t* machine) { stateMachineTest_log('F'); }
+static void duringFirst(stateMachine_t* machine) { stateMachineTest_log('e'); }
+static void exitFirst(stateMachine_t* machine) { stateMachineTest_log('f'); }
+static void enterSecond(stateMachine_t* machine) { stateMachineTest_log('S'); }
+static void exitSecond(stateMachine_t* machine) { stateMachineTest_log('s'); }
+static void transitionAction(stateMachine_t* machine) { stateMachineTest_log('t'); }
+static bool again(stateMachine_t* machine) { return againFlag; }
+
+static const stateMachine_state_t testStates[TEST_STATE_COUNT] = {
+  {"IDLE", STATEMACHINE_NONE, STATEMACHINE_NONE, enterIdle, NULL, NULL},
+  {"ACTIVE", STATEMACHINE_NONE, TEST_FIRST, enterActive, duringActive, exitActive},
+  {"FIRST", TEST_ACTIVE, STATEMACHINE_NONE, enterFirst, duringFirst, exitFirst},
+  {"SECOND", TEST_ACTIVE, STATEMACHINE_NONE, enterSecond, NULL, exitSecond},
+};
+
+static const stateMachine_transition_t testTransitions[] = {
+  {TEST_IDLE, 0, stateMachine_isEnabled, transitionAction, TEST_ACTIVE},
+  {TEST_FIRST, TEST_FIRST_MS, NULL, NULL, TEST_SECOND},
+  {TEST_ACTIVE, 0, stateMachine_isDisabled, NULL, TEST_IDLE},
+  {TEST_ACTIVE, 0, again, NULL, TEST_ACTIVE},
+  {TEST_ACTIVE, TEST_ACTIVE_MS, NULL, NULL, TEST_IDLE},
+};
+
+static const stateMachine_definition_t testDefinition = {
+  "test", testStates, TEST_STATE_COUNT, testTransitions, sizeof(testTransitions) / sizeof(testTransitions[0]),
+  TEST_IDLE
+};
+
+static stateMachine_t testMachine = STATEMACHINE_INIT(&testDefinition, TEST_MS_PER_TICK);
+
+// Ticks until the machine is in state and returns the number of ticks taken, 0 if it did not get there.
+static uint32_t stateMachineTest_ticksUntil(stateMachine_stateId_t state) {
+  for (uint32_t tick = 1; tick <= TEST_TICK_LIMIT; tick++) {
+    stateMachine_tick(&testMachine);
+    if (stateMachine_getState(&testMachine) == state)
+      return tick;
+  }
+  return 0;
+}
+
+static void stateMachineTest_runOrderChecks() {
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_IDLE && stateMachineTest_logIs("I"),
+                    "started on first query");
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_IDLE && stateMachineTest_logIs(""),
+                    "waits while disabled");
+  stateMachine_enable(&testMachine);
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_FIRST && stateMachineTest_logIs("tAF"),
+                    "enters initial child");
+  testSupport_check(stateMachine_isInState(&testMachine, TEST_ACTIVE) &&
+                    !stateMachine_isInState(&testMachine, TEST_IDLE), "parent active");
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachineTest_logIs("de"), "during outermost first");
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_SECOND && stateMachineTest_logIs("defS"),
+                    "sibling transition");
+  againFlag = true;
+  stateMachine_tick(&testMachine);
+  againFlag = false;
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_FIRST && stateMachineTest_logIs("dsaAF") &&
+                    stateMachine_getMsInState(&testMachine) == 0, "self transition of a parent");
+  // FIRST is due to move on, but the parent's transition comes first.
+  stateMachine_tick(&testMachine);
+  stateMachine_disable(&testMachine);
+  actionLog[0] = '\0';
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_IDLE && stateMachineTest_logIs("defaI"),
+                    "parent overrides child");
+  stateMachine_enable(&testMachine);
+  stateMachine_tick(&testMachine);
+  stateMachine_reset(&testMachine);
+  testSupport_check(stateMachine_getState(&testMachine) == TEST_IDLE && stateMachineTest_logIs("tAFI") &&
+                    !stateMachine_isEnabled(&testMachine), "reset");
+}
+
+static void stateMachineTest_runTimeChecks() {
+  stateMachine_reset(&testMachine);
+  stateMachine_enable(&testMachine);
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachineTest_ticksUntil(TEST_SECOND) == TEST_FIRST_MS / TEST_MS_PER_TICK, "child timeout");
+  // ACTIVE's time runs from its own entry, through the change of child.
+  testSupport_check(stateMachineTest_ticksUntil(TEST_IDLE) == (TEST_ACTIVE_MS - TEST_FIRST_MS) / TEST_MS_PER_TICK,
+                    "parent timeout");
+  stateMachine_disable(&testMachine);
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getMsInState(&testMachine) == TEST_MS_PER_TICK, "ms in state");
+  // A new period keeps the time already spent.
+  stateMachine_tick(&testMachine);
+  stateMachine_setMsPerTick(&testMachine, TEST_MS_PER_TICK / 2);
+  testSupport_check(stateMachine_getMsInState(&testMachine) == 2 * TEST_MS_PER_TICK,
+                    "ms in state kept across a new period");
+  stateMachine_setMsPerTick(&testMachine, TEST_MS_PER_TICK);
+  testSupport_check(stateMachine_getMsInState(&testMachine) == 2 * TEST_MS_PER_TICK,
+                    "ms in state kept across the old period");
+  actionLog[0] = '\0';
+}
+
+static void stateMachineTest_runTraceChecks() {
+#ifdef STATEMACHINE_ENABLE_TRACE
+  stateMachine_traceEntry_t entry;
+  stateMachine_reset(&testMachine);
+  stateMachine_clearTrace();
+  stateMachine_enable(&testMachine);
+  stateMachine_tick(&testMachine);
+  testSupport_check(stateMachine_getTraceCount() == 1 && stateMachine_getTraceEntry(0, &entry) &&
+                    entry.definition == &testDefinition && entry.from == TEST_IDLE && entry.to == TEST_FIRST,
+                    "trace entry");
+  testSupport_check(!stateMachine_getTraceEntry(1, &entry), "trace end");
+  stateMachine_tick(&testMachine);
+  stateMachine_tick(&testMachine);
+  againFlag = true;
+  for (uint32_t i = 0; i < STATEMACHINE_TRACE_SIZE; i++)
+    stateMachine_tick(&testMachine);
+  againFlag = false;
+  bool kept = stateMachine_getTraceCount() == STATEMACHINE_TRACE_SIZE;
+  // The two oldest (into ACTIVE, then to SECOND) are overwritten, leaving only the self transitions.
+  for (uint32_t i = 0; kept && i < STATEMACHINE_TRACE_SIZE; i++) {
+    uint32_t previousUs = entry.timeUs;
+    kept = stateMachine_getTraceEntry(i, &entry) && entry.from == (i ? TEST_FIRST : TEST_SECOND) &&
+           entry.to == TEST_FIRST && (i == 0 || entry.timeUs - previousUs < UINT32_MAX / 2);
+  }
+  testSupport_check(kept, "trace keeps the last transitions in order");
+  actionLog[0] = '\0';
+#else
+  testSupport_check(stateMachine_getTraceCount() == 0, "no trace without STATEMACHINE_ENABLE_TRACE");
+#endif
+}
+
+bool stateMachineTest_run() {
+  testSupport_begin("stateMachineTest");
+  againFlag = false;
+  actionLog[0] = '\0';
+  stateMachineTest_runOrderChecks();
+  stateMachineTest_runTimeChecks();
+  stateMachineTest_runTraceChecks();
+  return testSupport_end();
+}
+
+#ifdef STATEMACHINE_HOST
+// host entry point; the board build calls stateMachineTest_run()
+int main() {
+  return stateMachineTest_run() ? 0 : 1;
+}
+#endif
@@ -0,0 +1,19 @@
+/*
+ * stateMachineTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef STATEMACHINETEST_H_
+#define STATEMACHINETEST_H_
+
+#include <stdbool.h>
+
+// Checks stateMachine on a small nested machine: action order, initial children, guards, parent transitions,
+// self transitions, reset, timed transitions across a new tick period and, with STATEMACHINE_ENABLE_TRACE,
+// the trace. Returns true if every check passed. Host build:
+//   gcc -O2 -DSTATEMACHINE_HOST -DSTATEMACHINE_ENABLE_TRACE -DTESTSUPPORT_HOST stateMachine.c testSupport.c stateMachineTest.c -o stateMachineTest
+bool stateMachineTest_run();
+
+#endif /* STATEMACHINETEST_H_ */
@@ -0,0 +1,59 @@
+/*
+ * testSupport.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "testSupport.h"
+#include <stdio.h>
+
+#ifdef TESTSUPPORT_HOST
+#include <time.h>
+#define TESTSUPPORT_TICKS_PER_SECOND 1000000000ULL  // clock_gettime() nanoseconds.
+#else
+#include "timebase.h"
+#define TESTSUPPORT_TICKS_PER_SECOND TIMEBASE_TICKS_PER_SECOND
+#endif
+
+static const char* runName = "test";    // Prefix of every message.
+static uint32_t failureCount;           // Failed checks since testSupport_begin().
+static uint64_t startTicks;             // Time the current measurement started.
+
+static uint64_t testSupport_nowTicks() {
+#ifdef TESTSUPPORT_HOST
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t) now.tv_sec * TESTSUPPORT_TICKS_PER_SECOND + (uint64_t) now.tv_nsec;
+#else
+  return timebase_nowTicks();
+#endif
+}
+
+void testSupport_begin(const char* name) {
+  runName = name;
+  failureCount = 0;
+}
+
+void testSupport_check(bool condition, const char* description) {
+  if (!condition) {
+    printf("%s: FAILED %s\n\r", runName, description);
+    failureCount++;
+  }
+}
+
+bool testSupport_end() {
+  printf("%s: %s\n\r", runName, failureCount ? "FAILED" : "PASSED");
+  return failureCount == 0;
+}
+
+void testSupport_startTimer() {
+#ifndef TESTSUPPORT_HOST
+  timebase_init();  // Starts the global timer if nothing else has.
+#endif
+  startTicks = testSupport_nowTicks();
+}
+
+double testSupport_stopTimer() {
+  return (double) (testSupport_nowTicks() - startTicks) / TESTSUPPORT_TICKS_PER_SECOND;
+}
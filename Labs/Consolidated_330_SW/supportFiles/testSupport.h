@@ -0,0 +1,32 @@
+/*
+ * testSupport.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TESTSUPPORT_H_
+#define TESTSUPPORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Shared by the module checks and benchmarks: counts failed checks and times runs. On the board the timer
+// is timebase_nowTicks(); host builds add -DTESTSUPPORT_HOST testSupport.c and use clock_gettime().
+
+// Starts a run: clears the failure count. name prefixes every message until the next testSupport_begin().
+void testSupport_begin(const char* name);
+
+// Counts and prints a failed check.
+void testSupport_check(bool condition, const char* description);
+
+// Prints whether the run passed. Returns true if every check since testSupport_begin() passed.
+bool testSupport_end();
+
+// Starts a measurement.
+void testSupport_startTimer();
+
+// Ends a measurement and returns its length in seconds.
+double testSupport_stopTimer();
+
+#endif /* TESTSUPPORT_H_ */
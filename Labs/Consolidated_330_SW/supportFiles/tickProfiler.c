@@ -0,0 +1,183 @@
+/*
+ * tickProfiler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "tickProfiler.h"
+#include "timebase.h"
+#include "xparameters.h"
+#include "xuartps_hw.h"
+#include <stdio.h>
+
+#define TICKPROFILER_TICKS_PER_US TIMEBASE_TICKS_PER_US
+#define TICKPROFILER_TENTHS_PER_US 10       // Report durations to 0.1 us.
+#define TICKPROFILER_PERCENTILE 99          // Percentile reported next to the max.
+#define TICKPROFILER_PERCENT 100
+#define TICKPROFILER_WORD_BITS 32
+
+typedef struct {
+  const char* name;                                     // Used in the report.
+  uint32_t budgetTicks;                                 // Runs longer than this are overruns; 0 disables.
+  uint32_t runCount;                                    // Number of recorded runs.
+  uint32_t overrunCount;                                // Runs longer than the budget.
+  uint32_t minTicks;                                    // Shortest run.
+  uint32_t maxTicks;                                    // Longest run.
+  uint64_t totalTicks;                                  // Sum of all runs, for the average.
+  uint32_t histogram[TICKPROFILER_HISTOGRAM_BUCKETS];   // Log2 buckets of run durations.
+  uint32_t recent[TICKPROFILER_RECENT_SAMPLE_COUNT];    // Ring of the most recent durations.
+  uint32_t recentIndex;                                 // Next slot to write in recent[].
+} tickProfiler_stats_t;
+
+static tickProfiler_stats_t entries[TICKPROFILER_MAX_ENTRIES];
+static uint32_t entryCount = 0;
+
+// Clears the statistics of one entry.
+static void tickProfiler_clearStats(tickProfiler_stats_t* stats) {
+  stats->runCount = 0;
+  stats->overrunCount = 0;
+  stats->minTicks = UINT32_MAX;
+  stats->maxTicks = 0;
+  stats->totalTicks = 0;
+  stats->recentIndex = 0;
+  for (uint32_t i = 0; i < TICKPROFILER_HISTOGRAM_BUCKETS; i++)
+    stats->histogram[i] = 0;
+}
+
+// Index of the highest set bit, so durations land in log2 buckets. 0 goes in bucket 0.
+static uint32_t tickProfiler_log2(uint32_t ticks) {
+  return ticks ? (TICKPROFILER_WORD_BITS - 1) - __builtin_clz(ticks) : 0;
+}
+
+// Converts global-timer ticks to tenths of a microsecond.
+static uint32_t tickProfiler_ticksToTenthsOfUs(uint64_t ticks) {
+  return (uint32_t) ((ticks * TICKPROFILER_TENTHS_PER_US) / TICKPROFILER_TICKS_PER_US);
+}
+
+// Prints a duration in microseconds with one decimal place.
+static void tickProfiler_printUs(uint64_t ticks) {
+  uint32_t tenths = tickProfiler_ticksToTenthsOfUs(ticks);
+  printf("%7lu.%lu", (unsigned long) (tenths / TICKPROFILER_TENTHS_PER_US),
+         (unsigned long) (tenths % TICKPROFILER_TENTHS_PER_US));
+}
+
+// Returns the 99th percentile of the recent durations. Sorts a copy so recording is not slowed down.
+static uint32_t tickProfiler_computePercentile(const tickProfiler_stats_t* stats) {
+  uint32_t count = stats->runCount < TICKPROFILER_RECENT_SAMPLE_COUNT ? stats->runCount : TICKPROFILER_RECENT_SAMPLE_COUNT;
+  if (!count)
+    return 0;
+  uint32_t sorted[TICKPROFILER_RECENT_SAMPLE_COUNT];
+  for (uint32_t i = 0; i < count; i++) {  // Insertion sort; the ring is small and this only runs for reports.
+    uint32_t value = stats->recent[i];
+    uint32_t j = i;
+    for (; j > 0 && sorted[j - 1] > value; j--)
+      sorted[j] = sorted[j - 1];
+    sorted[j] = value;
+  }
+  uint32_t rank = (count * TICKPROFILER_PERCENTILE + TICKPROFILER_PERCENT - 1) / TICKPROFILER_PERCENT;  // Nearest rank.
+  return sorted[rank - 1];
+}
+
+// Removes all entries. Starts the global timer if it is not already running.
+void tickProfiler_init() {
+  entryCount = 0;
+  timebase_init();
+}
+
+// Adds a profiled entry.
+tickProfiler_entry_t tickProfiler_addEntry(const char* name, uint32_t budgetUs) {
+  if (entryCount >= TICKPROFILER_MAX_ENTRIES) {
+    printf("tickProfiler_addEntry: cannot add %s.\n\r", name);
+    return TICKPROFILER_INVALID_ENTRY;
+  }
+  tickProfiler_stats_t* stats = &entries[entryCount];
+  stats->name = name;
+  stats->budgetTicks = budgetUs * TICKPROFILER_TICKS_PER_US;
+  tickProfiler_clearStats(stats);
+  return entryCount++;
+}
+
+// Only the low 32 bits are needed: they wrap after 13 seconds, far longer than any tick.
+uint32_t tickProfiler_begin() {
+  return (uint32_t) timebase_nowTicks();
+}
+
+// Records the time since startTicks against the entry.
+void tickProfiler_end(tickProfiler_entry_t entry, uint32_t startTicks) {
+  uint32_t ticks = (uint32_t) timebase_nowTicks() - startTicks;
+  if (entry < 0 || entry >= (tickProfiler_entry_t) entryCount)
+    return;
+  tickProfiler_stats_t* stats = &entries[entry];
+  stats->runCount++;
+  stats->totalTicks += ticks;
+  if (ticks < stats->minTicks)
+    stats->minTicks = ticks;
+  if (ticks > stats->maxTicks)
+    stats->maxTicks = ticks;
+  if (stats->budgetTicks && ticks > stats->budgetTicks)
+    stats->overrunCount++;
+  stats->histogram[tickProfiler_log2(ticks)]++;
+  stats->recent[stats->recentIndex] = ticks;
+  stats->recentIndex = (stats->recentIndex + 1) % TICKPROFILER_RECENT_SAMPLE_COUNT;
+}
+
+// Calls tick and records how long it took.
+void tickProfiler_run(tickProfiler_entry_t entry, tickProfiler_tickFunction_t tick) {
+  uint32_t startTicks = tickProfiler_begin();
+  tick();
+  tickProfiler_end(entry, startTicks);
+}
+
+// Clears the statistics but keeps the entries.
+void tickProfiler_reset() {
+  for (uint32_t i = 0; i < entryCount; i++)
+    tickProfiler_clearStats(&entries[i]);
+}
+
+uint32_t tickProfiler_getOverrunCount(tickProfiler_entry_t entry) {
+  return entries[entry].overrunCount;
+}
+
+uint32_t tickProfiler_getMaxUs(tickProfiler_entry_t entry) {
+  return entries[entry].maxTicks / TICKPROFILER_TICKS_PER_US;
+}
+
+// Prints min/avg/max/p99, overruns and the histogram for every entry.
+void tickProfiler_printReport() {
+  printf("tick profile (us):\n\r");
+  for (uint32_t i = 0; i < entryCount; i++) {
+    tickProfiler_stats_t* stats = &entries[i];
+    printf("  %s: %lu runs, %lu over budget\n\r", stats->name, (unsigned long) stats->runCount,
+           (unsigned long) stats->overrunCount);
+    if (!stats->runCount)
+      continue;
+    printf("    min ");
+    tickProfiler_printUs(stats->minTicks);
+    printf("  avg ");
+    tickProfiler_printUs(stats->totalTicks / stats->runCount);
+    printf("  max ");
+    tickProfiler_printUs(stats->maxTicks);
+    printf("  p99 ");
+    tickProfiler_printUs(tickProfiler_computePercentile(stats));
+    printf("\n\r");
+    for (uint32_t bucket = 0; bucket < TICKPROFILER_HISTOGRAM_BUCKETS; bucket++) {
+      if (!stats->histogram[bucket])
+        continue;
+      printf("    >=");
+      tickProfiler_printUs((uint64_t) 1 << bucket);
+      printf(": %lu\n\r", (unsigned long) stats->histogram[bucket]);
+    }
+  }
+}
+
+// Checks the UART for TICKPROFILER_REPORT_KEY without blocking.
+bool tickProfiler_pollReportRequest() {
+  bool requested = false;
+  while (XUartPs_IsReceiveData(STDIN_BASEADDRESS))  // Drain everything typed since the last poll.
+    if ((char) XUartPs_ReadReg(STDIN_BASEADDRESS, XUARTPS_FIFO_OFFSET) == TICKPROFILER_REPORT_KEY)
+      requested = true;
+  if (requested)
+    tickProfiler_printReport();
+  return requested;
+}
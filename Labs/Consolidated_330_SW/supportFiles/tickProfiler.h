@@ -0,0 +1,63 @@
+/*
+ * tickProfiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TICKPROFILER_H_
+#define TICKPROFILER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Execution-time profiler for tick functions. Each entry keeps min/avg/max, the 99th percentile of the
+// most recent runs, a log2 histogram of durations and a count of runs that took longer than a budget.
+// Durations are measured in global-timer ticks (1/2 the CPU clock), so a measurement costs two
+// register reads instead of the interval-timer calls and double math that simonMain's tickTimer() used.
+// The scheduler profiles every task it runs, with the task period as the budget.
+// Type TICKPROFILER_REPORT_KEY on the UART terminal to get the report while the program runs.
+
+#define TICKPROFILER_MAX_ENTRIES 8              // Tick functions that can be profiled.
+#define TICKPROFILER_INVALID_ENTRY -1           // Returned by tickProfiler_addEntry() on failure.
+#define TICKPROFILER_HISTOGRAM_BUCKETS 32       // Bucket k counts durations in [2^k, 2^(k+1)) timer ticks.
+#define TICKPROFILER_RECENT_SAMPLE_COUNT 128    // The 99th percentile is computed over this many recent runs.
+#define TICKPROFILER_REPORT_KEY 'p'             // Typing this on the UART prints the report.
+#define TICKPROFILER_NO_BUDGET 0                // Budget that disables overrun counting for an entry.
+
+typedef int8_t tickProfiler_entry_t;
+typedef void (*tickProfiler_tickFunction_t)();
+
+// Removes all entries. Starts the global timer if it is not already running.
+void tickProfiler_init();
+
+// Adds a profiled entry. Runs longer than budgetUs count as overruns (TICKPROFILER_NO_BUDGET disables this).
+// Returns the entry, or TICKPROFILER_INVALID_ENTRY if the table is full.
+tickProfiler_entry_t tickProfiler_addEntry(const char* name, uint32_t budgetUs);
+
+// Returns a timestamp to pass to tickProfiler_end().
+uint32_t tickProfiler_begin();
+
+// Records the time since startTicks (from tickProfiler_begin()) against the entry.
+void tickProfiler_end(tickProfiler_entry_t entry, uint32_t startTicks);
+
+// Calls tick and records how long it took.
+void tickProfiler_run(tickProfiler_entry_t entry, tickProfiler_tickFunction_t tick);
+
+// Clears the statistics but keeps the entries.
+void tickProfiler_reset();
+
+// Number of runs of the entry that took longer than its budget.
+uint32_t tickProfiler_getOverrunCount(tickProfiler_entry_t entry);
+
+// Longest run of the entry, in microseconds.
+uint32_t tickProfiler_getMaxUs(tickProfiler_entry_t entry);
+
+// Prints min/avg/max/p99, overruns and the histogram for every entry.
+void tickProfiler_printReport();
+
+// Checks the UART for TICKPROFILER_REPORT_KEY without blocking and prints the report if it was typed.
+// Returns true if the report was printed.
+bool tickProfiler_pollReportRequest();
+
+#endif /* TICKPROFILER_H_ */
@@ -0,0 +1,181 @@
+/*
+ * timebase.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "timebase.h"
+#include "testSupport.h"
+#include "interrupts.h"
+#include <stdio.h>
+
+#define TIMEBASE_MAX_PRESCALER 255        // The private-timer prescaler is 8 bits.
+#define TIMEBASE_LOAD_BITS 32             // Width of the private-timer load register.
+
+// ticks / 325 computed as (ticks * TIMEBASE_RECIPROCAL) >> (64 + TIMEBASE_RECIPROCAL_SHIFT).
+// TIMEBASE_RECIPROCAL is 2^72 / 325 rounded up; it overshoots by 129 / 2^72 per tick, which is too little
+// to change the result for any 64-bit tick count, so the quotient is exact.
+#if TIMEBASE_TICKS_PER_US != 325
+#error "TIMEBASE_RECIPROCAL must be recomputed for this clock frequency."
+#endif
+#define TIMEBASE_RECIPROCAL 0xC9A633FCD967300DULL
+#define TIMEBASE_RECIPROCAL_SHIFT 8
+
+// Self-test parameters.
+#define TEST_SPAN_US 10000                // Length of the nowUs() comparison.
+#define TEST_DEADLINE_US 500              // Deadline that the test waits out.
+#define TEST_TOLERANCE_US 2               // Allowance for the time between back-to-back register reads.
+#define TEST_TIMER_PERIOD_US 1000         // Private-timer period measured by the test.
+#define TEST_TIMER_PERIODS 10             // Periods averaged per measurement.
+#define TEST_PRESCALER 4                  // Prescaler used to check interrupts_setPrivateTimerPrescalerValue().
+
+static uint32_t periodUs = 0;             // Last period programmed by timebase_setPeriodUs().
+
+// High 64 bits of the 128-bit product a * b, from 32-bit multiplies.
+static uint64_t timebase_multiplyHigh(uint64_t a, uint64_t b) {
+  uint64_t aLow = (uint32_t) a, aHigh = a >> 32;
+  uint64_t bLow = (uint32_t) b, bHigh = b >> 32;
+  uint64_t lowLow = aLow * bLow;
+  uint64_t lowHigh = aLow * bHigh;
+  uint64_t highLow = aHigh * bLow;
+  uint64_t middle = (lowLow >> 32) + (uint32_t) lowHigh + (uint32_t) highLow;  // Cannot overflow: three 32-bit terms.
+  return aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
+
+void timebase_init() {
+  globalTimer_startTimer(false);
+}
+
+// Splits the period into prescaler and load value. The period is (load + 1) * (prescaler + 1) ticks
+// (Cortex-A9 MPCore TRM 4.1.1).
+int timebase_setPeriodUs(uint32_t us) {
+  uint64_t ticks = timebase_usToTicks(us);
+  uint32_t prescaler = ticks ? (uint32_t) ((ticks - 1) >> TIMEBASE_LOAD_BITS) : 0;  // Smallest that fits.
+  if (!ticks || prescaler > TIMEBASE_MAX_PRESCALER) {
+    printf("timebase_setPeriodUs: cannot program a period of %ld us.\n\r", (long) us);
+    return TIMEBASE_STATUS_FAIL;
+  }
+  interrupts_setPrivateTimerPrescalerValue(prescaler);
+  interrupts_setPrivateTimerLoadValue((u32) (ticks / (prescaler + 1) - 1));
+  periodUs = us;
+  return TIMEBASE_STATUS_OK;
+}
+
+uint32_t timebase_getPeriodUs() {
+  return periodUs;
+}
+
+uint64_t timebase_nowTicks() {
+  return globalTimer_getTimerValue();
+}
+
+uint64_t timebase_nowUs() {
+  return timebase_ticksToUs(globalTimer_getTimerValue());
+}
+
+uint64_t timebase_ticksToUs(uint64_t ticks) {
+  return timebase_multiplyHigh(ticks, TIMEBASE_RECIPROCAL) >> TIMEBASE_RECIPROCAL_SHIFT;
+}
+
+uint64_t timebase_usToTicks(uint64_t us) {
+  return us * TIMEBASE_TICKS_PER_US;
+}
+
+timebase_deadline_t timebase_deadlineInUs(uint32_t us) {
+  return globalTimer_getTimerValue() + timebase_usToTicks(us);
+}
+
+timebase_deadline_t timebase_deadlineAfterUs(timebase_deadline_t deadline, uint32_t us) {
+  return deadline + timebase_usToTicks(us);
+}
+
+bool timebase_isExpired(timebase_deadline_t deadline) {
+  return globalTimer_getTimerValue() >= deadline;
+}
+
+uint32_t timebase_usUntil(timebase_deadline_t deadline) {
+  uint64_t now = globalTimer_getTimerValue();
+  if (now >= deadline)
+    return 0;
+  uint64_t us = timebase_ticksToUs(deadline - now);
+  return us > UINT32_MAX ? UINT32_MAX : (uint32_t) us;
+}
+
+// ******************************** self-test ************************************
+// Times TEST_TIMER_PERIODS reloads of the running private timer against the global timer.
+// The counter counts down and jumps back up to the load value at each reload.
+static uint64_t timebase_measurePrivateTimerTicks() {
+  interrupts_startArmPrivateTimer();
+  uint32_t previous = interrupts_getPrivateTimerCounterValue();
+  uint64_t firstReload = 0;
+  for (uint32_t reloads = 0; reloads <= TEST_TIMER_PERIODS;) {
+    uint32_t counter = interrupts_getPrivateTimerCounterValue();
+    if (counter > previous) {
+      uint64_t now = globalTimer_getTimerValue();
+      if (!reloads)
+        firstReload = now;
+      if (reloads == TEST_TIMER_PERIODS) {
+        interrupts_stopArmPrivateTimer();
+        return now - firstReload;
+      }
+      reloads++;
+    }
+    previous = counter;
+  }
+  return 0;
+}
+
+// Checks a measured private-timer run against the expected period.
+static void timebase_checkPrivateTimer(uint64_t expectedPeriodTicks, const char* description) {
+  uint64_t measured = timebase_measurePrivateTimerTicks();
+  uint64_t expected = expectedPeriodTicks * TEST_TIMER_PERIODS;
+  uint64_t error = measured > expected ? measured - expected : expected - measured;
+  printf("timebase_runTest: %s: %ld ticks per period (expected %ld)\n\r", description,
+         (long) (measured / TEST_TIMER_PERIODS), (long) expectedPeriodTicks);
+  testSupport_check(error <= timebase_usToTicks(TEST_TOLERANCE_US), description);
+}
+
+// Checks the conversions, the clock and the deadline helpers against the global timer, then the private timer.
+bool timebase_runTest() {
+  testSupport_begin("timebase_runTest");
+  timebase_init();
+  // Conversions: the reciprocal multiply must match a true division everywhere.
+  static const uint64_t testTicks[] = {0, 1, 324, 325, 326, 0xFFFFFFFFULL, 0x100000000ULL, 0x123456789ABCDEFULL,
+                                       0xFFFFFFFFFFFFFFFFULL};
+  for (uint32_t i = 0; i < sizeof(testTicks) / sizeof(testTicks[0]); i++)
+    testSupport_check(timebase_ticksToUs(testTicks[i]) == testTicks[i] / TIMEBASE_TICKS_PER_US,
+                      "ticksToUs differs from division");
+  testSupport_check(timebase_ticksToUs(timebase_usToTicks(TEST_SPAN_US)) == TEST_SPAN_US,
+                    "usToTicks does not round-trip");
+  // nowUs() keeps pace with the global timer.
+  uint64_t startTicks = globalTimer_getTimerValue();
+  uint64_t startUs = timebase_nowUs();
+  while (globalTimer_getTimerValue() - startTicks < timebase_usToTicks(TEST_SPAN_US));
+  uint64_t elapsedUs = timebase_nowUs() - startUs;
+  testSupport_check(elapsedUs + TEST_TOLERANCE_US >= TEST_SPAN_US && elapsedUs <= TEST_SPAN_US + TEST_TOLERANCE_US,
+                    "nowUs drifts from the global timer");
+  // A deadline expires on time, not before.
+  startTicks = globalTimer_getTimerValue();
+  timebase_deadline_t deadline = timebase_deadlineInUs(TEST_DEADLINE_US);
+  testSupport_check(!timebase_isExpired(deadline) && timebase_usUntil(deadline) <= TEST_DEADLINE_US,
+                    "new deadline already expired");
+  while (!timebase_isExpired(deadline));
+  elapsedUs = timebase_ticksToUs(globalTimer_getTimerValue() - startTicks);
+  testSupport_check(elapsedUs >= TEST_DEADLINE_US && elapsedUs <= TEST_DEADLINE_US + TEST_TOLERANCE_US,
+                    "deadline expired late");
+  testSupport_check(timebase_usUntil(deadline) == 0, "usUntil of an expired deadline");
+  testSupport_check(timebase_deadlineAfterUs(deadline, TEST_DEADLINE_US) - deadline ==
+                    timebase_usToTicks(TEST_DEADLINE_US), "deadlineAfterUs");
+  // The private timer: once through timebase_setPeriodUs(), once with a prescaler set after the load value.
+  interrupts_stopArmPrivateTimer();
+  interrupts_setPrivateTimerTickless(false);  // Measurements need auto-reload.
+  testSupport_check(timebase_setPeriodUs(TEST_TIMER_PERIOD_US) == TIMEBASE_STATUS_OK, "setPeriodUs failed");
+  timebase_checkPrivateTimer(timebase_usToTicks(TEST_TIMER_PERIOD_US), "setPeriodUs period");
+  uint64_t prescaledTicks = timebase_usToTicks(TEST_TIMER_PERIOD_US) / (TEST_PRESCALER + 1);
+  interrupts_setPrivateTimerLoadValue((u32) (prescaledTicks - 1));
+  interrupts_setPrivateTimerPrescalerValue(TEST_PRESCALER);  // Must not disturb the load value.
+  timebase_checkPrivateTimer(prescaledTicks * (TEST_PRESCALER + 1), "prescaled period");
+  interrupts_setPrivateTimerPrescalerValue(0);
+  return testSupport_end();
+}
@@ -0,0 +1,66 @@
+/*
+ * timebase.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "globalTimer.h"
+
+// One clock for every subsystem. Time is the 64-bit global timer (never wraps in practice), read in
+// ticks of TIMEBASE_TICKS_PER_US per microsecond. The private timer, which shares the same clock, is
+// programmed from a period in microseconds with integer math only. Deadlines are kept in ticks so
+// checking one is a single compare; conversions to microseconds use a multiply instead of a 64-bit divide.
+
+#define TIMEBASE_TICKS_PER_SECOND GLOBAL_TIMER_TICKS_PER_SECOND      // 325 MHz on the ZYBO.
+#define TIMEBASE_TICKS_PER_MS (TIMEBASE_TICKS_PER_SECOND / 1000)
+#define TIMEBASE_TICKS_PER_US (TIMEBASE_TICKS_PER_SECOND / 1000000)  // 325; the clock is a whole number of MHz.
+#define TIMEBASE_STATUS_OK 1      // Returned by timebase_setPeriodUs() when the period was programmed.
+#define TIMEBASE_STATUS_FAIL 0    // Returned by timebase_setPeriodUs() for 0 or a period beyond the prescaler's reach.
+
+typedef uint64_t timebase_deadline_t;  // Global-timer value at which a deadline expires.
+
+// Starts the global timer if it is not already running.
+void timebase_init();
+
+// Programs the private timer to interrupt every periodUs, choosing the smallest prescaler that lets
+// the load value fit. Assumes interrupts_initAll() has been called; does not start the timer.
+int timebase_setPeriodUs(uint32_t periodUs);
+
+// Period last programmed by timebase_setPeriodUs(), in microseconds.
+uint32_t timebase_getPeriodUs();
+
+// Current time in global-timer ticks.
+uint64_t timebase_nowTicks();
+
+// Current time in microseconds since the global timer started.
+uint64_t timebase_nowUs();
+
+// Conversions. timebase_ticksToUs() truncates.
+uint64_t timebase_ticksToUs(uint64_t ticks);
+uint64_t timebase_usToTicks(uint64_t us);
+
+// A deadline us microseconds from now.
+timebase_deadline_t timebase_deadlineInUs(uint32_t us);
+
+// The deadline us microseconds after an earlier one. Use for periodic work so that lateness in
+// noticing one deadline does not push back the next.
+timebase_deadline_t timebase_deadlineAfterUs(timebase_deadline_t deadline, uint32_t us);
+
+// True once the deadline has been reached.
+bool timebase_isExpired(timebase_deadline_t deadline);
+
+// Microseconds left until the deadline, 0 if it has expired (saturates at UINT32_MAX).
+uint32_t timebase_usUntil(timebase_deadline_t deadline);
+
+// Checks the conversions, timebase_nowUs() and the deadline helpers against the global timer, and
+// measures the private-timer period produced by timebase_setPeriodUs() and by a non-zero prescaler.
+// Requires interrupts_initAll(); leaves the private timer stopped. Returns true if every check passed.
+bool timebase_runTest();
+
+#endif /* TIMEBASE_H_ */
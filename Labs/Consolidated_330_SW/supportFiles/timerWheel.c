@@ -0,0 +1,131 @@
+/*
+ * timerWheel.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "timerWheel.h"
+
+#define TIMERWHEEL_SLOT_MASK (TIMERWHEEL_SLOTS - 1)
+
+#if TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS >= TIMERWHEEL_NO_TIMER
+#error "Slot numbers must fit below TIMERWHEEL_NO_TIMER."
+#endif
+
+// Ticks covered by all levels below level.
+static uint32_t timerWheel_levelSpan(uint32_t level) {
+  return 1UL << (TIMERWHEEL_SLOT_BITS * level);
+}
+
+// Links timer at the head of slot.
+static void timerWheel_link(timerWheel_t* wheel, timerWheel_timerId_t timer, uint16_t slot) {
+  timerWheel_node_t* node = &wheel->nodes[timer];
+  node->slot = slot;
+  node->prev = TIMERWHEEL_NO_TIMER;
+  node->next = wheel->slots[slot];
+  if (node->next != TIMERWHEEL_NO_TIMER)
+    wheel->nodes[node->next].prev = timer;
+  wheel->slots[slot] = timer;
+}
+
+// Unlinks timer from its slot.
+static void timerWheel_unlink(timerWheel_t* wheel, timerWheel_timerId_t timer) {
+  timerWheel_node_t* node = &wheel->nodes[timer];
+  if (node->prev != TIMERWHEEL_NO_TIMER)
+    wheel->nodes[node->prev].next = node->next;
+  else
+    wheel->slots[node->slot] = node->next;
+  if (node->next != TIMERWHEEL_NO_TIMER)
+    wheel->nodes[node->next].prev = node->prev;
+  node->slot = TIMERWHEEL_NO_TIMER;
+}
+
+// Files timer by how far away its expiry is: the lowest level whose span covers the distance, in the
+// slot selected by the expiry's digit for that level. Expired timers go in the slot processed next.
+static void timerWheel_insert(timerWheel_t* wheel, timerWheel_timerId_t timer) {
+  uint32_t expiry = wheel->nodes[timer].expiry;
+  uint32_t distance = expiry - wheel->now;
+  if ((int32_t) distance < 0) {
+    timerWheel_link(wheel, timer, wheel->now & TIMERWHEEL_SLOT_MASK);
+    return;
+  }
+  uint32_t level = 0;
+  while (level < TIMERWHEEL_LEVELS - 1 && distance >= timerWheel_levelSpan(level + 1))
+    level++;
+  uint32_t digit = (expiry >> (TIMERWHEEL_SLOT_BITS * level)) & TIMERWHEEL_SLOT_MASK;
+  timerWheel_link(wheel, timer, (uint16_t) (level * TIMERWHEEL_SLOTS + digit));
+}
+
+// Moves every timer in a slot of a higher level down to the level(s) below.
+static void timerWheel_cascade(timerWheel_t* wheel, uint32_t level) {
+  uint16_t slot = (uint16_t) (level * TIMERWHEEL_SLOTS +
+                              ((wheel->now >> (TIMERWHEEL_SLOT_BITS * level)) & TIMERWHEEL_SLOT_MASK));
+  timerWheel_timerId_t timer = wheel->slots[slot];
+  wheel->slots[slot] = TIMERWHEEL_NO_TIMER;
+  while (timer != TIMERWHEEL_NO_TIMER) {
+    timerWheel_timerId_t next = wheel->nodes[timer].next;
+    timerWheel_insert(wheel, timer);
+    timer = next;
+  }
+}
+
+void timerWheel_init(timerWheel_t* wheel, timerWheel_node_t* nodes, uint16_t capacity) {
+  wheel->now = 0;
+  wheel->nodes = nodes;
+  wheel->capacity = capacity;
+  for (uint32_t i = 0; i < TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS; i++)
+    wheel->slots[i] = TIMERWHEEL_NO_TIMER;
+  for (uint32_t i = 0; i < capacity; i++)
+    nodes[i].slot = TIMERWHEEL_NO_TIMER;
+}
+
+void timerWheel_schedule(timerWheel_t* wheel, timerWheel_timerId_t timer, uint32_t ticks) {
+  if (timer >= wheel->capacity)
+    return;
+  if (wheel->nodes[timer].slot != TIMERWHEEL_NO_TIMER)
+    timerWheel_unlink(wheel, timer);
+  if (ticks == 0)
+    ticks = 1;
+  if (ticks > TIMERWHEEL_MAX_TICKS)
+    ticks = TIMERWHEEL_MAX_TICKS;
+  wheel->nodes[timer].expiry = wheel->now + ticks - 1;  // now is the tick the next advance processes.
+  timerWheel_insert(wheel, timer);
+}
+
+void timerWheel_cancel(timerWheel_t* wheel, timerWheel_timerId_t timer) {
+  if (timer < wheel->capacity && wheel->nodes[timer].slot != TIMERWHEEL_NO_TIMER)
+    timerWheel_unlink(wheel, timer);
+}
+
+bool timerWheel_isScheduled(const timerWheel_t* wheel, timerWheel_timerId_t timer) {
+  return timer < wheel->capacity && wheel->nodes[timer].slot != TIMERWHEEL_NO_TIMER;
+}
+
+uint32_t timerWheel_getTicksRemaining(const timerWheel_t* wheel, timerWheel_timerId_t timer) {
+  if (!timerWheel_isScheduled(wheel, timer))
+    return 0;
+  return wheel->nodes[timer].expiry - wheel->now + 1;
+}
+
+// When level 0 wraps, the next slot of level 1 is due to be spread over level 0, and so on up.
+uint32_t timerWheel_advance(timerWheel_t* wheel, timerWheel_expiredFunction_t expired, void* context) {
+  for (uint32_t level = 1; level < TIMERWHEEL_LEVELS; level++) {
+    if ((wheel->now >> (TIMERWHEEL_SLOT_BITS * (level - 1))) & TIMERWHEEL_SLOT_MASK)
+      break;
+    timerWheel_cascade(wheel, level);
+  }
+  uint16_t slot = wheel->now & TIMERWHEEL_SLOT_MASK;
+  timerWheel_timerId_t timer = wheel->slots[slot];
+  wheel->slots[slot] = TIMERWHEEL_NO_TIMER;
+  wheel->now++;  // Callbacks that reschedule with ticks = 1 land on the next advance, not this slot.
+  uint32_t count = 0;
+  while (timer != TIMERWHEEL_NO_TIMER) {
+    timerWheel_timerId_t next = wheel->nodes[timer].next;
+    wheel->nodes[timer].slot = TIMERWHEEL_NO_TIMER;
+    count++;
+    expired(timer, context);
+    timer = next;
+  }
+  return count;
+}
@@ -0,0 +1,69 @@
+/*
+ * timerWheel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Hierarchical timer wheel for tick-based deadlines. Instead of counting every timer down on every tick,
+// a timer sits in a slot of the wheel for its level and only moves when the level below wraps, so a
+// tick costs time in proportion to the timers that expire (plus an occasional cascade), not to the
+// number of timers.
+// - Level 0 has TIMERWHEEL_SLOTS slots of one tick each; every level up covers TIMERWHEEL_SLOTS times
+//   more ticks per slot. Deadlines beyond TIMERWHEEL_MAX_TICKS are clamped to it.
+// - Timers are identified by index. The caller supplies storage for capacity nodes and uses ids
+//   0..capacity-1, e.g., one per mole. Nothing is allocated.
+// - Timers are doubly linked through their nodes, so cancel and reschedule are O(1).
+
+#define TIMERWHEEL_SLOT_BITS 6                                  // 64 slots per level.
+#define TIMERWHEEL_SLOTS (1 << TIMERWHEEL_SLOT_BITS)
+#define TIMERWHEEL_LEVELS 3
+#define TIMERWHEEL_MAX_TICKS ((1UL << (TIMERWHEEL_SLOT_BITS * TIMERWHEEL_LEVELS)) - 1)  // 262143 ticks.
+#define TIMERWHEEL_NO_TIMER 0xFFFF                              // End of a slot list.
+
+typedef uint16_t timerWheel_timerId_t;
+
+// Called for each timer that expires. The timer is no longer scheduled, so the callback may reschedule it.
+typedef void (*timerWheel_expiredFunction_t)(timerWheel_timerId_t timer, void* context);
+
+// Per-timer bookkeeping. Only the wheel touches these.
+typedef struct {
+  timerWheel_timerId_t next;
+  timerWheel_timerId_t prev;
+  uint16_t slot;            // Index into slots (level * TIMERWHEEL_SLOTS + slot); TIMERWHEEL_NO_TIMER when idle.
+  uint32_t expiry;          // Tick at which the timer fires.
+} timerWheel_node_t;
+
+typedef struct {
+  uint32_t now;                                             // Next tick to be processed.
+  timerWheel_node_t* nodes;
+  uint16_t capacity;
+  timerWheel_timerId_t slots[TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS];  // Head of each slot's list.
+} timerWheel_t;
+
+// Empties the wheel. nodes must hold capacity entries (capacity < TIMERWHEEL_NO_TIMER).
+void timerWheel_init(timerWheel_t* wheel, timerWheel_node_t* nodes, uint16_t capacity);
+
+// Schedules (or reschedules) timer to expire during the ticks-th call to timerWheel_advance() from now.
+// 0 is treated as 1.
+void timerWheel_schedule(timerWheel_t* wheel, timerWheel_timerId_t timer, uint32_t ticks);
+
+// Stops timer if it is scheduled.
+void timerWheel_cancel(timerWheel_t* wheel, timerWheel_timerId_t timer);
+
+// True if timer is scheduled.
+bool timerWheel_isScheduled(const timerWheel_t* wheel, timerWheel_timerId_t timer);
+
+// Calls to timerWheel_advance() until timer expires, 0 if it is not scheduled.
+uint32_t timerWheel_getTicksRemaining(const timerWheel_t* wheel, timerWheel_timerId_t timer);
+
+// Processes one tick: calls expired for every timer due on it. Returns the number of timers that expired.
+uint32_t timerWheel_advance(timerWheel_t* wheel, timerWheel_expiredFunction_t expired, void* context);
+
+#endif /* TIMERWHEEL_H_ */
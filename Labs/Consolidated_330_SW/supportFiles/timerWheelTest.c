@@ -0,0 +1,140 @@
+/*
+ * timerWheelTest.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#include "timerWheelTest.h"
+#include "testSupport.h"
+#include "timerWheel.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_TIMER_COUNT 32             // Timers in the wheel.
+#define TEST_LONG_TICKS 5000            // Crosses a level-1 and a level-2 boundary.
+#define TEST_RANDOM_TICKS 300000        // Ticks of the random run; wraps level 2 once.
+#define TEST_RANDOM_SEED 330            // Fixed so a failure can be reproduced.
+#define TEST_ACTION_ODDS 4              // One tick in TEST_ACTION_ODDS schedules or cancels something.
+#define TEST_SHORT_MAX 100              // Most random deadlines are short, like mole timers...
+#define TEST_LONG_ODDS 16               // ...but one in TEST_LONG_ODDS is anywhere in the wheel's range.
+
+static timerWheel_node_t testNodes[TEST_TIMER_COUNT];
+static timerWheel_t testWheel;
+static uint32_t referenceTicks[TEST_TIMER_COUNT];  // Countdown per timer, 0 when idle.
+static uint32_t firedCount[TEST_TIMER_COUNT];      // Expirations of each timer in the current tick.
+
+static void timerWheelTest_countExpired(timerWheel_timerId_t timer, void* context) {
+  firedCount[timer]++;
+}
+
+// Reschedules the timer for the next tick the first time it fires.
+static void timerWheelTest_rescheduleOnce(timerWheel_timerId_t timer, void* context) {
+  uint32_t* calls = (uint32_t*) context;
+  if ((*calls)++ == 0)
+    timerWheel_schedule(&testWheel, timer, 1);
+}
+
+// Advances until timer fires and returns the number of ticks taken, 0 if it did not fire within limit.
+static uint32_t timerWheelTest_ticksUntilFired(timerWheel_timerId_t timer, uint32_t limit) {
+  for (uint32_t tick = 1; tick <= limit; tick++) {
+    firedCount[timer] = 0;
+    timerWheel_advance(&testWheel, timerWheelTest_countExpired, NULL);
+    if (firedCount[timer])
+      return tick;
+  }
+  return 0;
+}
+
+static void timerWheelTest_runBasicChecks() {
+  timerWheel_init(&testWheel, testNodes, TEST_TIMER_COUNT);
+  timerWheel_schedule(&testWheel, 0, 1);
+  testSupport_check(timerWheelTest_ticksUntilFired(0, 2) == 1, "1-tick timer");
+  timerWheel_schedule(&testWheel, 0, 0);
+  testSupport_check(timerWheelTest_ticksUntilFired(0, 2) == 1, "0-tick timer");
+  timerWheel_schedule(&testWheel, 1, TEST_LONG_TICKS);
+  testSupport_check(timerWheel_getTicksRemaining(&testWheel, 1) == TEST_LONG_TICKS, "ticks remaining");
+  testSupport_check(timerWheelTest_ticksUntilFired(1, 2 * TEST_LONG_TICKS) == TEST_LONG_TICKS,
+                    "long timer across cascades");
+  testSupport_check(!timerWheel_isScheduled(&testWheel, 1), "expired timer still scheduled");
+
+  timerWheel_schedule(&testWheel, 2, 10);
+  timerWheel_cancel(&testWheel, 2);
+  testSupport_check(!timerWheel_isScheduled(&testWheel, 2) && timerWheelTest_ticksUntilFired(2, 20) == 0, "cancel");
+  timerWheel_schedule(&testWheel, 2, 10);
+  timerWheel_schedule(&testWheel, 2, 3);
+  testSupport_check(timerWheelTest_ticksUntilFired(2, 20) == 3, "reschedule");
+
+  uint32_t calls = 0;
+  timerWheel_schedule(&testWheel, 3, 1);
+  timerWheel_advance(&testWheel, timerWheelTest_rescheduleOnce, &calls);
+  testSupport_check(calls == 1 && timerWheel_getTicksRemaining(&testWheel, 3) == 1, "reschedule from the callback");
+  timerWheel_advance(&testWheel, timerWheelTest_rescheduleOnce, &calls);
+  testSupport_check(calls == 2 && !timerWheel_isScheduled(&testWheel, 3), "timer rescheduled from the callback");
+
+  timerWheel_schedule(&testWheel, 4, TIMERWHEEL_MAX_TICKS + 1000);
+  testSupport_check(timerWheel_getTicksRemaining(&testWheel, 4) == TIMERWHEEL_MAX_TICKS, "deadline not clamped");
+  timerWheel_schedule(&testWheel, TEST_TIMER_COUNT, 1);
+  testSupport_check(!timerWheel_isScheduled(&testWheel, TEST_TIMER_COUNT), "out-of-range timer accepted");
+}
+
+// Random deadline, mostly short.
+static uint32_t timerWheelTest_randomTicks() {
+  if (rand() % TEST_LONG_ODDS == 0)
+    return (uint32_t) rand() % TIMERWHEEL_MAX_TICKS + 1;
+  return (uint32_t) rand() % TEST_SHORT_MAX + 1;
+}
+
+static void timerWheelTest_runRandomChecks() {
+  srand(TEST_RANDOM_SEED);
+  timerWheel_init(&testWheel, testNodes, TEST_TIMER_COUNT);
+  for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++)
+    referenceTicks[i] = 0;
+  uint32_t expiredTotal = 0;
+  uint32_t mismatchTicks = 0;
+  for (uint32_t tick = 0; tick < TEST_RANDOM_TICKS; tick++) {
+    if (rand() % TEST_ACTION_ODDS == 0) {
+      timerWheel_timerId_t timer = rand() % TEST_TIMER_COUNT;
+      if (rand() % 4 == 0) {
+        timerWheel_cancel(&testWheel, timer);
+        referenceTicks[timer] = 0;
+      } else {
+        uint32_t ticks = timerWheelTest_randomTicks();
+        timerWheel_schedule(&testWheel, timer, ticks);
+        referenceTicks[timer] = ticks;
+      }
+    }
+    for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++)
+      firedCount[i] = 0;
+    expiredTotal += timerWheel_advance(&testWheel, timerWheelTest_countExpired, NULL);
+    bool match = true;
+    for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+      bool due = referenceTicks[i] == 1;
+      if (referenceTicks[i])
+        referenceTicks[i]--;
+      if (firedCount[i] != (due ? 1u : 0u) || timerWheel_getTicksRemaining(&testWheel, i) != referenceTicks[i])
+        match = false;
+    }
+    if (!match)
+      mismatchTicks++;
+  }
+  testSupport_check(mismatchTicks == 0, "wheel disagrees with the countdown");
+  testSupport_check(expiredTotal > 0, "random run expired nothing");
+  printf("timerWheelTest: %lu ticks, %lu expirations, %lu mismatched ticks\n\r",
+         (unsigned long) TEST_RANDOM_TICKS, (unsigned long) expiredTotal, (unsigned long) mismatchTicks);
+}
+
+bool timerWheelTest_run() {
+  testSupport_begin("timerWheelTest");
+  timerWheelTest_runBasicChecks();
+  timerWheelTest_runRandomChecks();
+  return testSupport_end();
+}
+
+#ifdef TIMERWHEEL_HOST
+// host entry point; the board build calls timerWheelTest_run()
+int main() {
+  return timerWheelTest_run() ? 0 : 1;
+}
+#endif
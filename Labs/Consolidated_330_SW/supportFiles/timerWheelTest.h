@@ -0,0 +1,19 @@
+/*
+ * timerWheelTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: cdmoo
+ */
+
+#ifndef TIMERWHEELTEST_H_
+#define TIMERWHEELTEST_H_
+
+#include <stdbool.h>
+
+// Checks timerWheel: exact expiry ticks, cancel and reschedule (also from a callback), clamped deadlines,
+// and random timers over several wraps of every level against a plain countdown.
+// Returns true if every check passed. Host build:
+//   gcc -O2 -DTIMERWHEEL_HOST -DTESTSUPPORT_HOST timerWheel.c testSupport.c timerWheelTest.c -o timerWheelTest
+bool timerWheelTest_run();
+
+#endif /* TIMERWHEELTEST_H_ */
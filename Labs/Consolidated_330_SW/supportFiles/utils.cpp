@@ -8,18 +8,15 @@
 // This will hold various utility functions that don't have an obvious home elsewhere.
 
 #include <stdint.h>
+#include "delay.h"
 
-// This provides an accurate ms delay. Number was computed via experimentation and
-// measuDISPLAY_RED with the intervalTimer package.
-#define MS_LOOP_MULTIPLIER 55310
+// Timed by the global timer (see delay.h). Longer delays sleep in WFI when interrupts are running.
 void utils_msDelay(long msDelay) {
-  volatile int32_t i;
-  for (i=0; i<msDelay*MS_LOOP_MULTIPLIER; i++);
+  if (msDelay > 0)
+    delay_sleepMs((uint32_t) msDelay);
 }
 
-// This is very approximate.
 void utils_microsecondDelay(long microSecondDelay) {
-  volatile int32_t i;
-  for (i=0; i<microSecondDelay*(MS_LOOP_MULTIPLIER/1000); i++);
+  if (microSecondDelay > 0)
+    delay_us((uint32_t) microSecondDelay);
 }
-